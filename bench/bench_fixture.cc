@@ -0,0 +1,159 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/detail/misc_utils.h"
+
+#include <atomic>
+#include <chrono>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#if defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#endif
+
+static std::atomic<uint64_t> allocationCount(0);
+
+// counts every allocation made through operator new, library included
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+namespace config {
+
+BenchFixture::BenchFixture(const std::string& name, const BenchFunction& function) {
+    benchmarks().push_back(std::make_pair(name, function));
+}
+
+BenchFixture::VectorBench& BenchFixture::benchmarks() {
+    static VectorBench benchmarks;
+    return benchmarks;
+}
+
+int32_t BenchFixture::runAll(const std::string& filter) {
+    int32_t run = 0;
+    for (auto& bench : benchmarks()) {
+        if (!filter.empty() && bench.first.find(filter) == std::string::npos) {
+            continue;
+        }
+        std::cout << "[ " << bench.first << " ]" << std::endl;
+        bench.second();
+        std::cout << std::endl;
+        ++run;
+    }
+    return run;
+}
+
+double BenchFixture::time(uint32_t iterations, const BenchFunction& function) {
+    double best = std::numeric_limits<double>::max();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+void BenchFixture::report(const std::string& label, double seconds, double units, const std::string& unitName) {
+    std::cout << "  " << std::left << std::setw(28) << label << std::right;
+    std::cout << std::fixed << std::setprecision(2) << std::setw(10) << seconds * 1000.0 << " ms";
+    std::cout << std::setw(14) << units / seconds << " " << unitName << "/s" << std::endl;
+}
+
+uint64_t BenchFixture::heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    // large blocks are mmapped and only counted in hblkhd
+    auto info = mallinfo2();
+    return static_cast<uint64_t>(info.uordblks) + static_cast<uint64_t>(info.hblkhd);
+#elif defined(__GLIBC__)
+    auto info = mallinfo();
+    return static_cast<uint64_t>(static_cast<uint32_t>(info.uordblks)) + static_cast<uint64_t>(static_cast<uint32_t>(info.hblkhd));
+#else
+    return 0;
+#endif
+}
+
+uint64_t BenchFixture::residentSetSize() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+#if defined(__linux__)
+    // pages of the whole program, then those resident
+    std::ifstream statm("/proc/self/statm");
+    uint64_t pages = 0;
+    uint64_t resident = 0;
+    if (statm >> pages >> resident) {
+        return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+void BenchFixture::reportMemory(const std::string& label, uint64_t bytes) {
+    std::cout << "  " << std::left << std::setw(28) << label << std::right;
+    std::cout << std::fixed << std::setprecision(2) << std::setw(10) << bytes / (1024.0 * 1024.0) << " MB retained" << std::endl;
+}
+
+uint64_t BenchFixture::allocations() {
+    return allocationCount.load();
+}
+
+std::string BenchFixture::resourcePath() {
+    static std::string path;
+    if (!path.empty()) {
+        return path;
+    }
+    for (auto& candidate : {"../../test/resources", "../test/resources", "./test/resources"}) {
+        if (MiscUtils::fileExists(candidate)) {
+            path = candidate;
+            return path;
+        }
+    }
+    throw std::runtime_error("test/resources directory not found");
+}
+
+std::string BenchFixture::generateConfig(const std::string& name, uint64_t minBytes) {
+    std::ifstream source(resourcePath() + "/test01.conf");
+    std::string contents((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+
+    std::string path = "/tmp/configcpp_bench_" + name;
+    std::ofstream output(path.c_str(), std::ios::trunc);
+    uint64_t written = 0;
+    for (uint32_t copy = 0; written < minBytes; ++copy) {
+        std::string key = "copy" + boost::lexical_cast<std::string>(copy) + " : ";
+        output << key << contents << "\n";
+        written += key.length() + contents.length() + 1;
+    }
+    return path;
+}
+
+uint64_t BenchFixture::fileSize(const std::string& file) {
+    struct stat info;
+    if (stat(file.c_str(), &info) == -1) {
+        return 0;
+    }
+    return static_cast<uint64_t>(info.st_size);
+}
+
+std::string BenchFixture::readFile(const std::string& file) {
+    std::ifstream stream(file.c_str(), std::ios::binary);
+    std::ostringstream contents;
+    contents << stream.rdbuf();
+    return contents.str();
+}
+
+}
@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef BENCH_FIXTURE_H_
+#define BENCH_FIXTURE_H_
+
+#include "configcpp/config_types.h"
+
+namespace config {
+
+typedef std::function<void()> BenchFunction;
+
+///
+/// Minimal benchmark harness. Benchmarks register themselves with the
+/// {@code BENCHMARK} macro and are run by name (or all together) from
+/// bench_configcpp.
+///
+class BenchFixture {
+public:
+    BenchFixture(const std::string& name, const BenchFunction& function);
+
+    /// Run all registered benchmarks whose name contains filter.
+    static int32_t runAll(const std::string& filter);
+
+    /// Return the best wall-clock time in seconds of running function
+    /// iterations times.
+    static double time(uint32_t iterations, const BenchFunction& function);
+
+    /// Print a throughput line, e.g. "mapped: 12.3 ms, 81.2 MB/s".
+    static void report(const std::string& label,
+                       double seconds,
+                       double units,
+                       const std::string& unitName);
+
+    /// Bytes currently allocated from the heap, or 0 where the C library
+    /// can't tell us; compare before and after to see what a value retains.
+    static uint64_t heapInUse();
+
+    /// Bytes of the process resident in memory, or 0 where the system can't
+    /// tell us. Free heap memory is given back first where the C library
+    /// allows it, so compare before and after to see what some code keeps
+    /// resident.
+    static uint64_t residentSetSize();
+
+    /// Print a memory line, e.g. "full: 41.20 MB retained".
+    static void reportMemory(const std::string& label, uint64_t bytes);
+
+    /// Number of calls to operator new so far; compare before and after to
+    /// count the heap allocations some code makes.
+    static uint64_t allocations();
+
+    static std::string resourcePath();
+
+    /// Write the contents of test01.conf (with object keys made unique) to a
+    /// temporary file repeatedly until it is at least minBytes long, and
+    /// return its path.
+    static std::string generateConfig(const std::string& name, uint64_t minBytes);
+
+    static uint64_t fileSize(const std::string& file);
+
+    /// Return the contents of file.
+    static std::string readFile(const std::string& file);
+
+private:
+    typedef std::vector<std::pair<std::string, BenchFunction>> VectorBench;
+    static VectorBench& benchmarks();
+};
+
+}
+
+#define BENCHMARK(Name) \
+    static void Name(); \
+    static config::BenchFixture Name##_registration(#Name, Name); \
+    static void Name()
+
+#endif // BENCH_FIXTURE_H_
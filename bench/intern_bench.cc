@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/config.h"
+
+using namespace config;
+
+static const uint32_t SERVICES = 20000;
+
+/// A service registry in the usual style: every service inherits a block of
+/// defaults and overrides a few of them, so the same keys and many of the
+/// same values appear once per service.
+static std::string generateServices() {
+    static const char* regions[] = {"us-east-1", "us-west-2", "eu-west-1", "ap-southeast-2"};
+    std::string input =
+        "defaults {\n"
+        "  host = \"service-gateway.internal.example.com\"\n"
+        "  port = 8443\n"
+        "  protocol = \"https\"\n"
+        "  timeout = 30 seconds\n"
+        "  retries = 3\n"
+        "  owner = \"platform-infrastructure\"\n"
+        "  tags = [\"production\", \"tier-1\", \"monitored\"]\n"
+        "  pool { min-connections = 4, max-connections = 64, idle-timeout = 10 minutes }\n"
+        "}\n"
+        "services {\n";
+    for (uint32_t i = 0; i < SERVICES; ++i) {
+        std::string region = regions[i % 4];
+        std::string name = "service-" + boost::lexical_cast<std::string>(i);
+        input += "  " + name + " = ${defaults} {\n";
+        input += "    name = \"" + name + "\"\n";
+        input += "    region = \"" + region + "\"\n";
+        input += "    endpoint = \"https://api." + region + ".example.com/v2/services\"\n";
+        if (i % 3 == 0) {
+            input += "    host = \"" + region + ".database.internal.example.com\"\n";
+        }
+        input += "  }\n";
+    }
+    return input + "}\n";
+}
+
+BENCHMARK(internedMemory) {
+    std::string input = generateServices();
+    Config::parseString(input)->resolve();
+
+    uint64_t before = BenchFixture::heapInUse();
+    auto conf = Config::parseString(input)->resolve();
+    BenchFixture::reportMemory("parsed and resolved", BenchFixture::heapInUse() - before);
+
+    double parsing = BenchFixture::time(3, [&]() {
+        Config::parseString(input)->resolve();
+    });
+    BenchFixture::report("parse and resolve", parsing, static_cast<double>(input.size()) / (1024.0 * 1024.0), "MB");
+}
@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/detail/json_parser.h"
+#include "configcpp/detail/parser.h"
+#include "configcpp/detail/tokenizer.h"
+#include "configcpp/detail/string_reader.h"
+#include "configcpp/detail/simple_config_origin.h"
+#include "configcpp/config.h"
+#include "configcpp/config_parse_options.h"
+#include "configcpp/config_syntax.h"
+
+using namespace config;
+
+static const uint64_t JSON_BYTES = 8 * 1024 * 1024;
+
+/// Formatted JSON of the kind tools emit: an array of records with
+/// strings, numbers, booleans, nulls and nested objects and arrays.
+static std::string generateJson(uint64_t minBytes) {
+    std::string input = "{\n  \"records\" : [\n";
+    for (uint32_t i = 0; input.length() < minBytes; ++i) {
+        std::string n = boost::lexical_cast<std::string>(i);
+        if (i > 0) {
+            input += ",\n";
+        }
+        input += "    {\n";
+        input += "      \"id\" : " + n + ",\n";
+        input += "      \"name\" : \"record " + n + "\",\n";
+        input += "      \"path\" : \"/var/data/records/" + n + "\\/index.json\",\n";
+        input += "      \"enabled\" : " + std::string(i % 2 ? "true" : "false") + ",\n";
+        input += "      \"parent\" : null,\n";
+        input += "      \"weight\" : " + n + ".25,\n";
+        input += "      \"tags\" : [ \"alpha\", \"beta\", \"gamma\" ],\n";
+        input += "      \"limits\" : { \"min\" : -" + n + ", \"max\" : 1.5e6, \"timeout\" : \"30 seconds\" }\n";
+        input += "    }";
+    }
+    input += "\n  ]\n}\n";
+    return input;
+}
+
+BENCHMARK(parseJson) {
+    std::string input = generateJson(JSON_BYTES);
+    double megabytes = static_cast<double>(input.length()) / (1024.0 * 1024.0);
+    auto origin = SimpleConfigOrigin::newSimple("bench");
+    auto options = ConfigParseOptions::defaults()->setSyntax(ConfigSyntax::JSON);
+
+    double general = BenchFixture::time(3, [&]() {
+        auto reader = StringReader::make_instance(input.data(), input.data() + input.length());
+        Parser::parse(Tokenizer::tokenize(origin, reader, ConfigSyntax::JSON), origin, options, nullptr);
+    });
+    BenchFixture::report("Parser (tokens)", general, megabytes, "MB");
+
+    double fast = BenchFixture::time(3, [&]() {
+        auto reader = StringReader::make_instance(input.data(), input.data() + input.length());
+        JsonParser::parse(reader, origin, options, nullptr);
+    });
+    BenchFixture::report("JsonParser", fast, megabytes, "MB");
+
+    double parsed = BenchFixture::time(3, [&]() {
+        Config::parseString(input, options);
+    });
+    BenchFixture::report("parseString (json)", parsed, megabytes, "MB");
+}
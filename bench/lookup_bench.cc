@@ -0,0 +1,283 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/detail/path_cache.h"
+#include "configcpp/config.h"
+#include "configcpp/config_path.h"
+
+using namespace config;
+
+static const uint32_t LOOKUPS = 1000000;
+
+BENCHMARK(lookupPath) {
+    auto conf = Config::parseString("a { b { c = 42 } }, server { port = 8080, timeout = 30 seconds }");
+    double lookups = static_cast<double>(LOOKUPS) / 1000000.0;
+
+    PathCache::setLimit(0);
+    double parsed = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < LOOKUPS; ++i) {
+            conf->getInt("a.b.c");
+        }
+    });
+    BenchFixture::report("getInt(\"a.b.c\") uncached", parsed, lookups, "M lookups");
+
+    PathCache::setLimit(PathCache::DEFAULT_LIMIT);
+    PathCache::clear();
+    double cached = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < LOOKUPS; ++i) {
+            conf->getInt("a.b.c");
+        }
+    });
+    BenchFixture::report("getInt(\"a.b.c\") cached", cached, lookups, "M lookups");
+    std::cout << "  cache: " << PathCache::hits() << " hits, " << PathCache::misses() << " misses" << std::endl;
+
+    auto path = ConfigPath::parse("a.b.c");
+    double compiled = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < LOOKUPS; ++i) {
+            conf->getInt(path);
+        }
+    });
+    BenchFixture::report("getInt(ConfigPath)", compiled, lookups, "M lookups");
+}
+
+/// A resolved config of leaves leaves, 100 to an object, three levels deep.
+static ConfigPtr generateLeaves(uint32_t leaves, std::vector<ConfigPathPtr>& paths) {
+    std::string input;
+    for (uint32_t i = 0; i < leaves; ++i) {
+        std::string section = "s" + boost::lexical_cast<std::string>(i / 10000);
+        std::string group = "g" + boost::lexical_cast<std::string>((i / 100) % 100);
+        std::string key = "k" + boost::lexical_cast<std::string>(i % 100);
+        if (i % 10000 == 0) {
+            input += section + " {\n";
+        }
+        if (i % 100 == 0) {
+            input += "  " + group + " {\n";
+        }
+        input += "    " + key + " = " + boost::lexical_cast<std::string>(i) + "\n";
+        if (i % 100 == 99 || i + 1 == leaves) {
+            input += "  }\n";
+        }
+        if (i % 10000 == 9999 || i + 1 == leaves) {
+            input += "}\n";
+        }
+        paths.push_back(ConfigPath::parse(section + "." + group + "." + key));
+    }
+    return Config::parseString(input)->resolve();
+}
+
+BENCHMARK(lookupIndexed) {
+    for (uint32_t leaves : {10000, 100000, 1000000}) {
+        std::vector<ConfigPathPtr> paths;
+        auto conf = generateLeaves(leaves, paths);
+        std::string size = boost::lexical_cast<std::string>(leaves / 1000) + "k leaves";
+
+        // visit the paths in a scattered order so caches don't flatter either
+        std::vector<ConfigPathPtr> order;
+        for (uint32_t i = 0; i < leaves; ++i) {
+            order.push_back(paths[(static_cast<uint64_t>(i) * 7919) % leaves]);
+        }
+        double lookups = static_cast<double>(leaves) / 1000000.0;
+
+        double walked = BenchFixture::time(3, [&]() {
+            for (auto& path : order) {
+                conf->getInt(path);
+            }
+        });
+        BenchFixture::report("walk, " + size, walked, lookups, "M lookups");
+
+        uint64_t before = BenchFixture::heapInUse();
+        conf->indexPaths();
+        BenchFixture::reportMemory("index, " + size, BenchFixture::heapInUse() - before);
+
+        double indexed = BenchFixture::time(3, [&]() {
+            for (auto& path : order) {
+                conf->getInt(path);
+            }
+        });
+        BenchFixture::report("indexed, " + size, indexed, lookups, "M lookups");
+    }
+}
+
+BENCHMARK(lookupFrozen) {
+    for (uint32_t leaves : {10000, 100000, 1000000}) {
+        std::vector<ConfigPathPtr> paths;
+        auto conf = generateLeaves(leaves, paths);
+        std::string size = boost::lexical_cast<std::string>(leaves / 1000) + "k leaves";
+
+        std::vector<std::string> order;
+        for (uint32_t i = 0; i < leaves; ++i) {
+            order.push_back(paths[(static_cast<uint64_t>(i) * 7919) % leaves]->expression());
+        }
+        double lookups = static_cast<double>(leaves) / 1000000.0;
+
+        double walked = BenchFixture::time(3, [&]() {
+            for (auto& path : order) {
+                conf->getInt(path);
+            }
+        });
+        BenchFixture::report("tree, " + size, walked, lookups, "M lookups");
+
+        uint64_t before = BenchFixture::heapInUse();
+        auto frozen = conf->freeze();
+        BenchFixture::reportMemory("freeze, " + size, BenchFixture::heapInUse() - before);
+
+        double found = BenchFixture::time(3, [&]() {
+            for (auto& path : order) {
+                frozen->getInt(path);
+            }
+        });
+        BenchFixture::report("frozen, " + size, found, lookups, "M lookups");
+    }
+}
+
+BENCHMARK(lookupDuration) {
+    static const uint32_t DURATIONS = 200000;
+    auto conf = Config::parseString("client { timeout = \"30 seconds\", retry = 250, idle = oops }");
+    auto timeout = ConfigPath::parse("client.timeout");
+    auto retry = ConfigPath::parse("client.retry");
+    auto idle = ConfigPath::parse("client.idle");
+    double lookups = static_cast<double>(DURATIONS) / 1000000.0;
+
+    double strings = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < DURATIONS; ++i) {
+            conf->getMilliseconds(timeout);
+        }
+    });
+    BenchFixture::report("getMilliseconds, \"30 seconds\"", strings, lookups, "M lookups");
+
+    double numbers = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < DURATIONS; ++i) {
+            conf->getMilliseconds(retry);
+        }
+    });
+    BenchFixture::report("getMilliseconds, 250", numbers, lookups, "M lookups");
+
+    double bad = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < DURATIONS; ++i) {
+            conf->tryGetMilliseconds(idle);
+        }
+    });
+    BenchFixture::report("tryGetMilliseconds, \"oops\"", bad, lookups, "M lookups");
+}
+
+BENCHMARK(lookupStringRef) {
+    static const uint32_t LOOKUPS = 200000;
+    auto conf = Config::parseString(
+        "db { url = \"jdbc:postgresql://db.internal.example.com:5432/orders\", "
+        "hosts = [\"db1.internal.example.com\", \"db2.internal.example.com\", \"db3.internal.example.com\"] }");
+    auto url = ConfigPath::parse("db.url");
+    auto hosts = ConfigPath::parse("db.hosts");
+    double lookups = static_cast<double>(LOOKUPS) / 1000000.0;
+
+    uint64_t before = BenchFixture::allocations();
+    conf->getString(url);
+    uint64_t copied = BenchFixture::allocations() - before;
+    before = BenchFixture::allocations();
+    conf->getStringRef(url);
+    uint64_t borrowed = BenchFixture::allocations() - before;
+    std::cout << "  getString: " << copied << " allocations, getStringRef: " << borrowed << std::endl;
+
+    before = BenchFixture::allocations();
+    conf->getStringList(hosts);
+    copied = BenchFixture::allocations() - before;
+    before = BenchFixture::allocations();
+    conf->getStringRefList(hosts);
+    borrowed = BenchFixture::allocations() - before;
+    std::cout << "  getStringList: " << copied << " allocations, getStringRefList: " << borrowed << std::endl;
+
+    std::size_t total = 0;
+    double copies = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < LOOKUPS; ++i) {
+            total += conf->getString(url).size();
+        }
+    });
+    BenchFixture::report("getString", copies, lookups, "M lookups");
+
+    double refs = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < LOOKUPS; ++i) {
+            total += conf->getStringRef(url).size();
+        }
+    });
+    BenchFixture::report("getStringRef", refs, lookups, "M lookups");
+
+    double lists = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < LOOKUPS; ++i) {
+            total += conf->getStringList(hosts).size();
+        }
+    });
+    BenchFixture::report("getStringList", lists, lookups, "M lookups");
+
+    double refLists = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < LOOKUPS; ++i) {
+            total += conf->getStringRefList(hosts).size();
+        }
+    });
+    BenchFixture::report("getStringRefList", refLists, lookups, "M lookups");
+    if (total == 0) {
+        std::cout << "  (no strings)" << std::endl;
+    }
+}
+
+BENCHMARK(lookupListView) {
+    static const uint32_t LOOKUPS = 100000;
+    std::string ports = "ports = [";
+    for (uint32_t i = 0; i < 32; ++i) {
+        ports += (i == 0 ? "" : ", ") + boost::lexical_cast<std::string>(8000 + i);
+    }
+    auto conf = Config::parseString(ports + "]");
+    auto path = ConfigPath::parse("ports");
+    double lookups = static_cast<double>(LOOKUPS) / 1000000.0;
+
+    int64_t total = 0;
+    double vectors = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < LOOKUPS; ++i) {
+            total += conf->getIntList(path).back();
+        }
+    });
+    BenchFixture::report("getIntList, 32 ints", vectors, lookups, "M lookups");
+
+    VectorInt list;
+    double filled = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < LOOKUPS; ++i) {
+            conf->getIntList(path, list);
+            total += list.back();
+        }
+    });
+    BenchFixture::report("getIntList into a vector", filled, lookups, "M lookups");
+
+    double views = BenchFixture::time(3, [&]() {
+        for (uint32_t i = 0; i < LOOKUPS; ++i) {
+            auto view = conf->getIntListView(path);
+            total += view[view.size() - 1];
+        }
+    });
+    BenchFixture::report("getIntListView", views, lookups, "M lookups");
+    if (total == 0) {
+        std::cout << "  (no ints)" << std::endl;
+    }
+}
+
+BENCHMARK(listPacking) {
+    static const uint32_t LISTS = 20000;
+    std::string input;
+    for (uint32_t i = 0; i < LISTS; ++i) {
+        input += "list" + boost::lexical_cast<std::string>(i) + " = [";
+        for (uint32_t j = 0; j < 16; ++j) {
+            input += (j == 0 ? "" : ", ") + boost::lexical_cast<std::string>(i + j);
+        }
+        input += "]\n";
+    }
+    Config::parseString(input)->resolve();
+
+    uint64_t before = BenchFixture::heapInUse();
+    auto conf = Config::parseString(input)->resolve();
+    BenchFixture::reportMemory("parsed and resolved", BenchFixture::heapInUse() - before);
+
+    double parsing = BenchFixture::time(3, [&]() {
+        Config::parseString(input)->resolve();
+    });
+    BenchFixture::report("parse and resolve", parsing, static_cast<double>(input.size()) / (1024.0 * 1024.0), "MB");
+}
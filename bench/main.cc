@@ -0,0 +1,15 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+
+int main(int argc, char** argv) {
+    std::string filter = argc > 1 ? argv[1] : "";
+    if (config::BenchFixture::runAll(filter) == 0) {
+        std::cerr << "no benchmarks matched '" << filter << "'" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/config.h"
+#include "configcpp/config_memory_resource.h"
+#include "configcpp/config_parse_options.h"
+#include "configcpp/config_resolve_options.h"
+#include <atomic>
+
+using namespace config;
+
+/// Services inheriting a block of defaults, so resolving makes a new object
+/// per service.
+static std::string generateServices(uint32_t count) {
+    std::string input =
+        "defaults { port = 8443, protocol = https, timeout = 30 seconds, retries = 3,\n"
+        "  tags = [production, tier-1], pool { min = 4, max = 64 } }\n";
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string n = boost::lexical_cast<std::string>(i);
+        input += "service-" + n + " = ${defaults} { name = \"service-" + n + "\", weight = " + n + ", ";
+        input += "endpoint = \"https://api-" + n + ".example.com/v2\" }\n";
+    }
+    return input;
+}
+
+/// Resource handing out heap memory, as an embedder accounting for its
+/// configs would.
+class HeapResource : public ConfigMemoryResource {
+public:
+    HeapResource() :
+        allocations(0) {
+    }
+
+    virtual void* allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return ::operator new(bytes);
+    }
+
+    virtual void deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        ::operator delete(p);
+    }
+
+    std::atomic<uint64_t> allocations;
+};
+
+static void compareResource(const std::string& label, const std::string& input,
+                            const std::shared_ptr<HeapResource>& resource = nullptr, bool useArena = false) {
+    auto parseOptions = ConfigParseOptions::defaults()->setMemoryResource(resource)->setUseArena(useArena);
+    auto resolveOptions = ConfigResolveOptions::defaults()->setMemoryResource(resource);
+    double megabytes = static_cast<double>(input.size()) / (1024.0 * 1024.0);
+
+    uint64_t resident = BenchFixture::residentSetSize();
+    uint64_t heap = BenchFixture::heapInUse();
+    uint64_t allocations = BenchFixture::allocations();
+    auto conf = Config::parseString(input, parseOptions)->resolve(resolveOptions);
+    allocations = BenchFixture::allocations() - allocations;
+    BenchFixture::reportMemory(label + " retained", BenchFixture::heapInUse() - heap);
+    BenchFixture::reportMemory(label + " resident", BenchFixture::residentSetSize() - resident);
+    std::cout << "  " << label << ": " << allocations << " allocations";
+    if (resource) {
+        std::cout << ", " << resource->allocations << " from the resource";
+    }
+    std::cout << std::endl;
+    conf.reset();
+
+    double building = 0.0;
+    double dropping = 0.0;
+    for (uint32_t i = 0; i < 3; ++i) {
+        ConfigPtr held;
+        double built = BenchFixture::time(1, [&]() {
+            held = Config::parseString(input, parseOptions)->resolve(resolveOptions);
+        });
+        double dropped = BenchFixture::time(1, [&]() {
+            held.reset();
+        });
+        building = i == 0 ? built : std::min(building, built);
+        dropping = i == 0 ? dropped : std::min(dropping, dropped);
+    }
+    BenchFixture::report(label + " parse and resolve", building, megabytes, "MB");
+    BenchFixture::report(label + " teardown", dropping, megabytes, "MB");
+}
+
+BENCHMARK(memoryResource) {
+    std::string input = generateServices(20000);
+    Config::parseString(input)->resolve();
+
+    compareResource("heap", input);
+    compareResource("resource", input, std::make_shared<HeapResource>());
+    compareResource("arena", input, nullptr, true);
+}
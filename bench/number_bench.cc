@@ -0,0 +1,82 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/detail/number_parser.h"
+#include "configcpp/config.h"
+#include "configcpp/config_parse_options.h"
+#include "configcpp/config_syntax.h"
+
+using namespace config;
+
+static const uint64_t NUMBERS_BYTES = 4 * 1024 * 1024;
+
+/// Number-heavy config: arrays of ints and short decimals, as in
+/// generated metrics or tuning tables.
+static std::string generateNumbers(uint64_t minBytes, VectorString& numbers) {
+    std::string input;
+    uint32_t seed = 7;
+    for (uint32_t row = 0; input.length() < minBytes; ++row) {
+        input += "row" + boost::lexical_cast<std::string>(row) + " = [";
+        for (uint32_t i = 0; i < 16; ++i) {
+            seed = seed * 1103515245 + 12345;
+            std::string n = boost::lexical_cast<std::string>(seed >> 12);
+            if (i % 2 == 1) {
+                n = boost::lexical_cast<std::string>((seed >> 20) % 1000) + "." + boost::lexical_cast<std::string>(seed % 1000);
+            }
+            numbers.push_back(n);
+            input += (i == 0 ? "" : ", ") + n;
+        }
+        input += "]\n";
+    }
+    return input;
+}
+
+BENCHMARK(parseNumbers) {
+    VectorString numbers;
+    std::string input = generateNumbers(NUMBERS_BYTES, numbers);
+    double count = static_cast<double>(numbers.size()) / 1000000.0;
+
+    double cast = BenchFixture::time(5, [&]() {
+        double sum = 0.0;
+        for (auto& n : numbers) {
+            if (n.find('.') == std::string::npos) {
+                sum += static_cast<double>(boost::lexical_cast<int64_t>(n));
+            }
+            else {
+                sum += boost::lexical_cast<double>(n);
+            }
+        }
+        if (sum == 0.0) {
+            std::cout << "  (zero sum)" << std::endl;
+        }
+    });
+    BenchFixture::report("lexical_cast", cast, count, "M numbers");
+
+    double parsed = BenchFixture::time(5, [&]() {
+        double sum = 0.0;
+        for (auto& n : numbers) {
+            int64_t i;
+            double d;
+            if (n.find('.') == std::string::npos && NumberParser::parseInt64(n, i)) {
+                sum += static_cast<double>(i);
+            }
+            else if (NumberParser::parseDouble(n, d)) {
+                sum += d;
+            }
+        }
+        if (sum == 0.0) {
+            std::cout << "  (zero sum)" << std::endl;
+        }
+    });
+    BenchFixture::report("NumberParser", parsed, count, "M numbers");
+
+    double megabytes = static_cast<double>(input.length()) / (1024.0 * 1024.0);
+    auto options = ConfigParseOptions::defaults()->setSyntax(ConfigSyntax::CONF);
+    double parseString = BenchFixture::time(3, [&]() {
+        Config::parseString(input, options);
+    });
+    BenchFixture::report("parseString (numbers)", parseString, megabytes, "MB");
+}
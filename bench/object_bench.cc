@@ -0,0 +1,48 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/detail/simple_config_object.h"
+#include "configcpp/detail/simple_config_origin.h"
+#include "configcpp/detail/config_int.h"
+
+using namespace config;
+
+static const uint32_t OBJECTS = 100000;
+
+BENCHMARK(objectLayout) {
+    auto origin = SimpleConfigOrigin::newSimple("bench");
+    auto value = ConfigInt::make_instance(origin, 42, "42");
+
+    for (uint32_t keys : {1, 4, 8, 16}) {
+        std::vector<std::string> names;
+        MapAbstractConfigValue map;
+        for (uint32_t k = 0; k < keys; ++k) {
+            names.push_back("key" + boost::lexical_cast<std::string>(k));
+            map[names.back()] = value;
+        }
+        std::string size = boost::lexical_cast<std::string>(keys) + " keys";
+
+        uint64_t before = BenchFixture::heapInUse();
+        std::vector<AbstractConfigObjectPtr> objects;
+        objects.reserve(OBJECTS);
+        for (uint32_t i = 0; i < OBJECTS; ++i) {
+            objects.push_back(SimpleConfigObject::make_instance(origin, map));
+        }
+        uint64_t bytes = (BenchFixture::heapInUse() - before) / OBJECTS;
+        std::cout << "  " << std::left << std::setw(28) << ("object, " + size) << std::right
+                  << std::setw(10) << bytes << " bytes each" << std::endl;
+
+        double lookups = static_cast<double>(OBJECTS) * keys / 1000000.0;
+        double found = BenchFixture::time(3, [&]() {
+            for (auto& object : objects) {
+                for (auto& name : names) {
+                    object->get(name);
+                }
+            }
+        });
+        BenchFixture::report("get(), " + size, found, lookups, "M lookups");
+    }
+}
@@ -0,0 +1,77 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/detail/file_reader.h"
+#include "configcpp/detail/mapped_file_reader.h"
+#include "configcpp/config.h"
+#include "configcpp/config_parse_options.h"
+#include "configcpp/config_syntax.h"
+
+using namespace config;
+
+static const uint64_t FILE_BYTES = 8 * 1024 * 1024;
+
+static void drain(const ReaderPtr& reader) {
+    uint64_t sum = 0;
+    for (int32_t c = reader->read(); c != Reader::READER_EOF; c = reader->read()) {
+        sum += static_cast<uint32_t>(c);
+    }
+    reader->close();
+    if (sum == 0) {
+        std::cout << "  (empty input)" << std::endl;
+    }
+}
+
+static void drainChunks(const ChunkReaderPtr& reader) {
+    uint64_t sum = 0;
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    while (reader->readChunk(begin, end)) {
+        for (; begin != end; ++begin) {
+            sum += static_cast<uint8_t>(*begin);
+        }
+    }
+    reader->close();
+    if (sum == 0) {
+        std::cout << "  (empty input)" << std::endl;
+    }
+}
+
+BENCHMARK(readFile) {
+    std::string file = BenchFixture::generateConfig("read_file.conf", FILE_BYTES);
+    double megabytes = static_cast<double>(BenchFixture::fileSize(file)) / (1024.0 * 1024.0);
+
+    double streamed = BenchFixture::time(5, [&]() {
+        drain(FileReader::make_instance(file));
+    });
+    BenchFixture::report("FileReader (ifstream)", streamed, megabytes, "MB");
+
+    double mapped = BenchFixture::time(5, [&]() {
+        drain(MappedFileReader::make_instance(file));
+    });
+    BenchFixture::report("MappedFileReader (mmap)", mapped, megabytes, "MB");
+
+    double chunks = BenchFixture::time(5, [&]() {
+        drainChunks(MappedFileReader::make_instance(file));
+    });
+    BenchFixture::report("MappedFileReader (chunks)", chunks, megabytes, "MB");
+}
+
+BENCHMARK(parseFile) {
+    std::string file = BenchFixture::generateConfig("parse_file.conf", FILE_BYTES);
+    double megabytes = static_cast<double>(BenchFixture::fileSize(file)) / (1024.0 * 1024.0);
+    auto options = ConfigParseOptions::defaults()->setSyntax(ConfigSyntax::CONF);
+
+    double streamed = BenchFixture::time(3, [&]() {
+        Config::parseReader(FileReader::make_instance(file), options);
+    });
+    BenchFixture::report("parseReader(FileReader)", streamed, megabytes, "MB");
+
+    double mapped = BenchFixture::time(3, [&]() {
+        Config::parseFile(file, options);
+    });
+    BenchFixture::report("parseFile (mmap)", mapped, megabytes, "MB");
+}
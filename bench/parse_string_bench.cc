@@ -0,0 +1,104 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/config.h"
+#include "configcpp/config_parse_options.h"
+#include "configcpp/config_syntax.h"
+#include "configcpp/config_origin_detail.h"
+#include "configcpp/config_object.h"
+#include "configcpp/config_list.h"
+#include "configcpp/detail/tokenizer.h"
+#include "configcpp/detail/tokens.h"
+#include "configcpp/detail/string_reader.h"
+#include "configcpp/detail/simple_config_origin.h"
+
+using namespace config;
+
+static const uint64_t STRING_BYTES = 8 * 1024 * 1024;
+
+BENCHMARK(parseString) {
+    std::string input = BenchFixture::readFile(BenchFixture::generateConfig("parse_string.conf", STRING_BYTES));
+    double megabytes = static_cast<double>(input.length()) / (1024.0 * 1024.0);
+    auto options = ConfigParseOptions::defaults()->setSyntax(ConfigSyntax::CONF);
+
+    double parsed = BenchFixture::time(3, [&]() {
+        Config::parseString(input, options);
+    });
+    BenchFixture::report("parseString", parsed, megabytes, "MB");
+}
+
+static uint64_t countValues(const ConfigValuePtr& value) {
+    // substitutions are unresolved, so don't ask for valueType()
+    uint64_t count = 1;
+    auto object = std::dynamic_pointer_cast<ConfigObject>(value);
+    auto list = std::dynamic_pointer_cast<ConfigList>(value);
+    if (object) {
+        for (auto& pair : *object) {
+            count += countValues(pair.second);
+        }
+    }
+    else if (list) {
+        for (VectorConfigValue::size_type i = 0; i < list->size(); ++i) {
+            count += countValues(list->at(i));
+        }
+    }
+    return count;
+}
+
+BENCHMARK(parseAllocations) {
+    std::string input = BenchFixture::readFile(BenchFixture::generateConfig("parse_string.conf", STRING_BYTES));
+    auto options = ConfigParseOptions::defaults()->setSyntax(ConfigSyntax::CONF);
+
+    uint64_t tokens = 0;
+    uint64_t before = BenchFixture::allocations();
+    auto origin = SimpleConfigOrigin::newSimple("bench");
+    auto stream = Tokenizer::tokenize(origin, StringReader::make_instance(input.data(), input.data() + input.length()), ConfigSyntax::CONF);
+    while (stream->next() != Tokens::END()) {
+        ++tokens;
+    }
+    uint64_t tokenized = BenchFixture::allocations() - before;
+
+    before = BenchFixture::allocations();
+    auto root = Config::parseString(input, options)->root();
+    uint64_t parsed = BenchFixture::allocations() - before;
+    uint64_t values = countValues(root);
+
+    std::cout << "  " << tokens << " tokens, " << values << " values" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  tokenize: " << tokenized << " allocations, " << static_cast<double>(tokenized) / tokens << " per token" << std::endl;
+    std::cout << "  parse:    " << parsed << " allocations, " << static_cast<double>(parsed) / tokens << " per token, "
+              << static_cast<double>(parsed) / values << " per value" << std::endl;
+}
+
+BENCHMARK(originDetail) {
+    // test01.conf has no comments, so document every line
+    std::istringstream lines(BenchFixture::readFile(BenchFixture::generateConfig("parse_string.conf", STRING_BYTES)));
+    std::string input;
+    std::string line;
+    while (std::getline(lines, line)) {
+        input += "# documents the line below\n" + line + "\n";
+    }
+    double megabytes = static_cast<double>(input.length()) / (1024.0 * 1024.0);
+    auto options = ConfigParseOptions::defaults()->setSyntax(ConfigSyntax::CONF);
+
+    std::vector<std::pair<std::string, ConfigOriginDetail>> details = {
+        {"full", ConfigOriginDetail::FULL},
+        {"line", ConfigOriginDetail::LINE},
+        {"file", ConfigOriginDetail::FILE}
+    };
+    for (auto& detail : details) {
+        auto detailOptions = options->setOriginDetail(detail.second);
+        double parsed = BenchFixture::time(3, [&]() {
+            Config::parseString(input, detailOptions);
+        });
+        BenchFixture::report(detail.first, parsed, megabytes, "MB");
+
+        uint64_t before = BenchFixture::heapInUse();
+        auto config = Config::parseString(input, detailOptions);
+        uint64_t after = BenchFixture::heapInUse();
+        BenchFixture::reportMemory(detail.first, after > before ? after - before : 0);
+    }
+}
@@ -0,0 +1,52 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/config.h"
+
+using namespace config;
+
+static const uint32_t SERVICES = 10000;
+
+/// Services each inheriting and overriding a block of defaults, referring to
+/// shared settings and concatenating strings.
+static std::string generateServices(const std::string& prefix) {
+    std::string input =
+        "shared { region = eu-west-1, domain = example.com }\n"
+        "defaults { port = 8443, protocol = https, timeout = 30 seconds, retries = 3,\n"
+        "  region = ${shared.region}, tags = [production, tier-1], pool { min = 4, max = 64 } }\n";
+    for (uint32_t i = 0; i < SERVICES; ++i) {
+        std::string n = boost::lexical_cast<std::string>(i);
+        input += prefix + n + " = ${defaults} { name = service-" + n + ", pool { max = " + n + " },\n";
+        input += "  endpoint = \"https://\"${shared.domain}\"/" + n + "\" }\n";
+    }
+    return input;
+}
+
+BENCHMARK(resolveAndMerge) {
+    std::string input = generateServices("service-");
+    double megabytes = static_cast<double>(input.size()) / (1024.0 * 1024.0);
+    double services = static_cast<double>(SERVICES) / 1000.0;
+    auto parsed = Config::parseString(input);
+
+    ConfigPtr resolved;
+    double resolving = BenchFixture::time(3, [&]() {
+        resolved = parsed->resolve();
+    });
+    BenchFixture::report("resolve", resolving, megabytes, "MB");
+
+    auto overrides = Config::parseString(generateServices("service-"))->resolve();
+    auto others = Config::parseString(generateServices("other-"))->resolve();
+    double merging = BenchFixture::time(3, [&]() {
+        overrides->withFallback(resolved);
+        others->withFallback(resolved);
+    });
+    BenchFixture::report("withFallback", merging, services * 2, "k services");
+
+    double listing = BenchFixture::time(3, [&]() {
+        resolved->entrySet();
+    });
+    BenchFixture::report("entrySet", listing, services, "k services");
+}
@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fixture.h"
+#include "configcpp/detail/tokenizer.h"
+#include "configcpp/detail/char_scanner.h"
+#include "configcpp/detail/tokens.h"
+#include "configcpp/detail/string_reader.h"
+#include "configcpp/detail/simple_config_origin.h"
+#include "configcpp/config_syntax.h"
+
+using namespace config;
+
+static const uint64_t TOKENIZE_BYTES = 8 * 1024 * 1024;
+
+static uint64_t countTokens(const std::string& input, ConfigSyntax flavor) {
+    auto reader = StringReader::make_instance(input.data(), input.data() + input.length());
+    auto tokens = Tokenizer::tokenize(SimpleConfigOrigin::newSimple("bench"), reader, flavor);
+    uint64_t count = 0;
+    while (tokens->hasNext()) {
+        tokens->next();
+        ++count;
+    }
+    return count;
+}
+
+/// Machine-generated style input: long quoted strings, long comments and
+/// wide indentation, which is where the vector scan kernels pay off.
+static std::string generateLongRuns(uint64_t minBytes) {
+    std::string input;
+    for (uint32_t i = 0; input.length() < minBytes; ++i) {
+        std::string n = boost::lexical_cast<std::string>(i);
+        input += "                # generated entry " + n + ", see the schema for what each of these fields means\n";
+        input += "                entry" + n + " = \"" + std::string(120, 'x') + "/" + n + "\"\n";
+        input += "                // " + std::string(100, '-') + "\n";
+    }
+    return input;
+}
+
+static void tokenizeWithKernels(const std::string& label, const std::string& input) {
+    double megabytes = static_cast<double>(input.length()) / (1024.0 * 1024.0);
+    double count = static_cast<double>(countTokens(input, ConfigSyntax::CONF));
+    auto previous = CharScanner::kernels();
+    for (auto& kernels : CharScanner::supportedKernels()) {
+        CharScanner::setKernels(kernels);
+        double seconds = BenchFixture::time(5, [&]() {
+            countTokens(input, ConfigSyntax::CONF);
+        });
+        BenchFixture::report(label + " " + kernels.name + " (MB)", seconds, megabytes, "MB");
+        BenchFixture::report(label + " " + kernels.name + " (tokens)", seconds, count / 1000000.0, "Mtok");
+    }
+    CharScanner::setKernels(previous);
+}
+
+BENCHMARK(tokenize) {
+    tokenizeWithKernels("test01", BenchFixture::readFile(BenchFixture::generateConfig("tokenize.conf", TOKENIZE_BYTES)));
+    tokenizeWithKernels("long runs", generateLongRuns(TOKENIZE_BYTES));
+}
+
+BENCHMARK(scanKernels) {
+    std::string input = generateLongRuns(TOKENIZE_BYTES);
+    std::string spaces(TOKENIZE_BYTES, ' ');
+    double megabytes = static_cast<double>(input.length()) / (1024.0 * 1024.0);
+    const char* end = input.data() + input.length();
+    for (auto& kernels : CharScanner::supportedKernels()) {
+        uint64_t found = 0;
+        double seconds = BenchFixture::time(5, [&]() {
+            for (const char* p = input.data(); p != end; ++p) {
+                p = kernels.findQuotedStop(p, end);
+                ++found;
+                if (p == end) {
+                    break;
+                }
+            }
+        });
+        BenchFixture::report("findQuotedStop " + kernels.name, seconds, megabytes, "MB");
+        seconds = BenchFixture::time(5, [&]() {
+            found += kernels.skipWhitespace(spaces.data(), spaces.data() + spaces.length()) - spaces.data();
+        });
+        BenchFixture::report("skipWhitespace " + kernels.name, seconds, spaces.length() / (1024.0 * 1024.0), "MB");
+        if (found == 0) {
+            std::cout << "  (nothing found)" << std::endl;
+        }
+    }
+}
@@ -7,6 +7,8 @@
 #define CONFIG_H_
 
 #include "configcpp/config_mergeable.h"
+#include "configcpp/config_result.h"
+#include "configcpp/config_list_view.h"
 
 namespace config {
 
@@ -368,6 +370,30 @@ public:
     /// @return true if the configuration is empty
     virtual bool empty() = 0;
 
+    /// Builds a hash index of every path in this config, after which the
+    /// getters and hasPath() look a path up with a single probe instead of
+    /// walking the tree. Worthwhile for large configs that are read many
+    /// times; the index holds a path and a pointer for every value, objects
+    /// included. Calling it again does nothing, and it is safe to call while
+    /// other threads read the config.
+    ///
+    /// @throws ConfigExceptionNotResolved
+    ///             if the config is not resolved
+    virtual void indexPaths() = 0;
+
+    /// Returns a read-optimized snapshot of this config, for configs that are
+    /// loaded once and then read for a long time. Every leaf is placed in a
+    /// flat table by a minimal perfect hash, so {@link Config#getInt} and the
+    /// other scalar getters find a value written as a plain path expression
+    /// (such as <code>"a.b.c"</code>) without parsing the expression or
+    /// walking the tree. All other methods behave exactly as they do on this
+    /// config.
+    ///
+    /// @return the frozen config
+    /// @throws ConfigExceptionNotResolved
+    ///             if the config is not resolved
+    virtual ConfigPtr freeze() = 0;
+
     /// Returns the set of path-value pairs, excluding any null values, found by
     /// recursing {@link #root() the root object}. Note that this is very
     /// different from <code>root()->entrySet()</code> which returns the set of
@@ -539,6 +565,69 @@ public:
     virtual VectorInt64 getMillisecondsList(const std::string& path) = 0;
     virtual VectorInt64 getNanosecondsList(const std::string& path) = 0;
 
+    /// Like getString() and getStringList(), but without copying: the
+    /// strings returned are the ones held by this config, and stay valid as
+    /// long as this config does. Numbers and booleans are converted just as
+    /// getString() converts them.
+    ///
+    /// @param path
+    ///            path expression
+    /// @return reference to the string value at the requested path
+    /// @throws ConfigExceptionMissing
+    ///             if value is absent or null
+    /// @throws ConfigExceptionWrongType
+    ///             if value is not convertible to a string
+    virtual const std::string& getStringRef(const std::string& path) = 0;
+    virtual VectorStringRef getStringRefList(const std::string& path) = 0;
+
+    /// Like the list getters above, but without building a vector: lists of
+    /// numbers or booleans keep their elements unboxed, and a view reads them
+    /// in place. A view stays valid as long as this config does. Elements are
+    /// converted, and errors thrown, exactly as by the list getters.
+    ///
+    /// @param path
+    ///            path expression
+    /// @return view of the list at the requested path
+    /// @throws ConfigExceptionMissing
+    ///             if value is absent or null
+    /// @throws ConfigExceptionWrongType
+    ///             if value is not a list, or an element is not convertible
+    virtual ConfigListView<bool> getBooleanListView(const std::string& path) = 0;
+    virtual ConfigListView<int32_t> getIntListView(const std::string& path) = 0;
+    virtual ConfigListView<int64_t> getInt64ListView(const std::string& path) = 0;
+    virtual ConfigListView<double> getDoubleListView(const std::string& path) = 0;
+
+    /// As the list getters above, but filling the caller's vector, so a
+    /// vector reused across calls is only allocated once.
+    ///
+    /// @param path
+    ///            path expression
+    /// @param list
+    ///            replaced by the list at the requested path
+    virtual void getBooleanList(const std::string& path, VectorBool& list) = 0;
+    virtual void getIntList(const std::string& path, VectorInt& list) = 0;
+    virtual void getInt64List(const std::string& path, VectorInt64& list) = 0;
+    virtual void getDoubleList(const std::string& path, VectorDouble& list) = 0;
+
+    /// Non-throwing versions of the getters above, for settings that may well
+    /// be absent or unusable. Rather than throwing, they return a
+    /// {@link ConfigResult} holding the {@link ConfigError} that stands for the
+    /// exception the getter would have thrown; a path expression that can't be
+    /// parsed is {@code ConfigError::BAD_PATH}. Durations and sizes given as
+    /// strings are parsed without any exception being thrown along the way.
+    ///
+    /// @param path
+    ///            path expression
+    /// @return the value at the requested path, or why there isn't one
+    virtual ConfigResult<bool> tryGetBoolean(const std::string& path) = 0;
+    virtual ConfigResult<int32_t> tryGetInt(const std::string& path) = 0;
+    virtual ConfigResult<int64_t> tryGetInt64(const std::string& path) = 0;
+    virtual ConfigResult<double> tryGetDouble(const std::string& path) = 0;
+    virtual ConfigResult<std::string> tryGetString(const std::string& path) = 0;
+    virtual ConfigResult<uint64_t> tryGetBytes(const std::string& path) = 0;
+    virtual ConfigResult<uint64_t> tryGetMilliseconds(const std::string& path) = 0;
+    virtual ConfigResult<uint64_t> tryGetNanoseconds(const std::string& path) = 0;
+
     /// Clone the config with only the given path (and its children) retained;
     /// all sibling paths are removed.
     ///
@@ -582,6 +671,54 @@ public:
     ///            value at the new path
     /// @return the new instance with the new map entry
     virtual ConfigPtr withValue(const std::string& path, const ConfigValuePtr& value) = 0;
+
+    /// Overloads of the methods above taking a path parsed in advance with
+    /// {@link ConfigPath#parse}. They behave exactly like the ones taking a
+    /// path expression, but don't parse the path on every call.
+    virtual bool hasPath(const ConfigPathPtr& path) = 0;
+    virtual bool getBoolean(const ConfigPathPtr& path) = 0;
+    virtual int32_t getInt(const ConfigPathPtr& path) = 0;
+    virtual int64_t getInt64(const ConfigPathPtr& path) = 0;
+    virtual double getDouble(const ConfigPathPtr& path) = 0;
+    virtual std::string getString(const ConfigPathPtr& path) = 0;
+    virtual ConfigObjectPtr getObject(const ConfigPathPtr& path) = 0;
+    virtual ConfigPtr getConfig(const ConfigPathPtr& path) = 0;
+    virtual ConfigVariant getVariant(const ConfigPathPtr& path) = 0;
+    virtual ConfigValuePtr getValue(const ConfigPathPtr& path) = 0;
+    virtual uint64_t getBytes(const ConfigPathPtr& path) = 0;
+    virtual uint64_t getMilliseconds(const ConfigPathPtr& path) = 0;
+    virtual uint64_t getNanoseconds(const ConfigPathPtr& path) = 0;
+    virtual ConfigListPtr getList(const ConfigPathPtr& path) = 0;
+    virtual VectorBool getBooleanList(const ConfigPathPtr& path) = 0;
+    virtual VectorInt getIntList(const ConfigPathPtr& path) = 0;
+    virtual VectorInt64 getInt64List(const ConfigPathPtr& path) = 0;
+    virtual VectorDouble getDoubleList(const ConfigPathPtr& path) = 0;
+    virtual VectorString getStringList(const ConfigPathPtr& path) = 0;
+    virtual VectorConfigObject getObjectList(const ConfigPathPtr& path) = 0;
+    virtual VectorConfig getConfigList(const ConfigPathPtr& path) = 0;
+    virtual VectorVariant getVariantList(const ConfigPathPtr& path) = 0;
+    virtual VectorInt64 getBytesList(const ConfigPathPtr& path) = 0;
+    virtual VectorInt64 getMillisecondsList(const ConfigPathPtr& path) = 0;
+    virtual VectorInt64 getNanosecondsList(const ConfigPathPtr& path) = 0;
+    virtual const std::string& getStringRef(const ConfigPathPtr& path) = 0;
+    virtual VectorStringRef getStringRefList(const ConfigPathPtr& path) = 0;
+    virtual ConfigListView<bool> getBooleanListView(const ConfigPathPtr& path) = 0;
+    virtual ConfigListView<int32_t> getIntListView(const ConfigPathPtr& path) = 0;
+    virtual ConfigListView<int64_t> getInt64ListView(const ConfigPathPtr& path) = 0;
+    virtual ConfigListView<double> getDoubleListView(const ConfigPathPtr& path) = 0;
+    virtual void getBooleanList(const ConfigPathPtr& path, VectorBool& list) = 0;
+    virtual void getIntList(const ConfigPathPtr& path, VectorInt& list) = 0;
+    virtual void getInt64List(const ConfigPathPtr& path, VectorInt64& list) = 0;
+    virtual void getDoubleList(const ConfigPathPtr& path, VectorDouble& list) = 0;
+    virtual ConfigResult<bool> tryGetBoolean(const ConfigPathPtr& path) = 0;
+    virtual ConfigResult<int32_t> tryGetInt(const ConfigPathPtr& path) = 0;
+    virtual ConfigResult<int64_t> tryGetInt64(const ConfigPathPtr& path) = 0;
+    virtual ConfigResult<double> tryGetDouble(const ConfigPathPtr& path) = 0;
+    virtual ConfigResult<std::string> tryGetString(const ConfigPathPtr& path) = 0;
+    virtual ConfigResult<uint64_t> tryGetBytes(const ConfigPathPtr& path) = 0;
+    virtual ConfigResult<uint64_t> tryGetMilliseconds(const ConfigPathPtr& path) = 0;
+    virtual ConfigResult<uint64_t> tryGetNanoseconds(const ConfigPathPtr& path) = 0;
+    virtual ConfigPtr withValue(const ConfigPathPtr& path, const ConfigValuePtr& value) = 0;
 };
 
 }
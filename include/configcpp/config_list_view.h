@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONFIG_LIST_VIEW_H_
+#define CONFIG_LIST_VIEW_H_
+
+#include <cstddef>
+
+namespace config {
+
+///
+/// Read-only view of a list of numbers or booleans, as returned by the
+/// {@code Config::get...ListView} methods. The elements are the ones the list
+/// keeps unboxed, so a view costs nothing to make and stays valid as long as
+/// the config it came from.
+///
+/// <pre>
+///     for (int32_t port : config->getIntListView("server.ports")) {
+///         ...
+///     }
+/// </pre>
+///
+template <typename T>
+class ConfigListView {
+public:
+    typedef T value_type;
+    typedef const T* const_iterator;
+    typedef std::size_t size_type;
+
+    ConfigListView() :
+        data_(nullptr),
+        size_(0) {
+    }
+
+    ConfigListView(const T* data, size_type size) :
+        data_(data),
+        size_(size) {
+    }
+
+    const T* data() const {
+        return data_;
+    }
+
+    size_type size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    const_iterator begin() const {
+        return data_;
+    }
+
+    const_iterator end() const {
+        return data_ + size_;
+    }
+
+    const T& operator[](size_type n) const {
+        return data_[n];
+    }
+
+private:
+    const T* data_;
+    size_type size_;
+};
+
+}
+
+#endif // CONFIG_LIST_VIEW_H_
@@ -0,0 +1,157 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONFIG_MEMORY_RESOURCE_H_
+#define CONFIG_MEMORY_RESOURCE_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace config {
+
+class ConfigMemoryResource;
+typedef std::shared_ptr<ConfigMemoryResource> ConfigMemoryResourcePtr;
+
+///
+/// Source of the memory config values and their origins are allocated from,
+/// in the manner of C++17's {@code std::pmr::memory_resource}: implement it
+/// to place config trees in a per-tenant pool, in huge pages or on a given
+/// NUMA node, or to account for them.
+/// <p>
+/// Values, origins, the containers holding an object's fields and a list's
+/// elements, and string values all come from the resource. Characters of
+/// keys and strings too long for std::string to keep inline still come from
+/// the heap, since they are handed out as {@code std::string}.
+/// <p>
+/// Give one to {@link ConfigParseOptions#setMemoryResource} or
+/// {@link ConfigResolveOptions#setMemoryResource}, or make it current around
+/// any other call that builds values (such as
+/// {@link ConfigValue#fromAnyRef}) with a {@link ConfigMemoryScope}. Every
+/// value made from a resource holds a reference to it, so the resource lives
+/// until the last of them is freed. For an arena owned by the config itself,
+/// use {@link ConfigParseOptions#setUseArena} instead.
+/// <p>
+/// Values are freed by whichever thread drops the last reference to them, so
+/// deallocate() must be safe to call from any thread. allocate() is only
+/// called on threads inside a scope using the resource.
+///
+class ConfigMemoryResource {
+public:
+    virtual ~ConfigMemoryResource();
+
+    /// @return memory for bytes bytes aligned to alignment; throw
+    ///         std::bad_alloc if there's none
+    virtual void* allocate(std::size_t bytes, std::size_t alignment) = 0;
+
+    /// Give back memory from allocate(), with the same bytes and alignment.
+    virtual void deallocate(void* p, std::size_t bytes, std::size_t alignment) = 0;
+};
+
+///
+/// Makes the config values and origins built on this thread come from a
+/// memory resource for as long as the scope lasts. Scopes nest; a scope with
+/// a null resource changes nothing.
+///
+/// <pre>
+///     ConfigMemoryScope scope(tenantPool);
+///     auto value = ConfigValue::fromAnyRef(settings);
+/// </pre>
+///
+class ConfigMemoryScope {
+public:
+    explicit ConfigMemoryScope(const ConfigMemoryResourcePtr& resource);
+    ~ConfigMemoryScope();
+
+    /// @return the resource of the innermost scope on this thread, or null
+    static const ConfigMemoryResourcePtr& current();
+
+private:
+    friend class ConfigHeapScope;
+
+    ConfigMemoryScope(const ConfigMemoryScope&) = delete;
+    ConfigMemoryScope& operator=(const ConfigMemoryScope&) = delete;
+
+    ConfigMemoryResourcePtr resource;
+    const ConfigMemoryResourcePtr* previous;
+};
+
+///
+/// Allocator handing out memory from a ConfigMemoryResource, or from the
+/// heap if it has none. A default constructed one uses the current scope's
+/// resource, so containers made inside a ConfigMemoryScope allocate from it;
+/// a copied container uses the resource current where it's copied. Each
+/// allocator holds a reference to its resource, which keeps it alive for as
+/// long as the containers (and shared_ptr control blocks) using it.
+///
+template <class T>
+class ConfigMemoryAllocator {
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    ConfigMemoryAllocator() :
+        resource(ConfigMemoryScope::current()) {
+    }
+
+    explicit ConfigMemoryAllocator(const ConfigMemoryResourcePtr& resource) :
+        resource(resource) {
+    }
+
+    template <class U>
+    ConfigMemoryAllocator(const ConfigMemoryAllocator<U>& other) :
+        resource(other.resource) {
+    }
+
+    T* allocate(std::size_t n) {
+        if (resource) {
+            return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        if (resource) {
+            resource->deallocate(p, n * sizeof(T), alignof(T));
+        }
+        else {
+            ::operator delete(p);
+        }
+    }
+
+    ConfigMemoryAllocator select_on_container_copy_construction() const {
+        return ConfigMemoryAllocator();
+    }
+
+    const ConfigMemoryResourcePtr& getResource() const {
+        return resource;
+    }
+
+    template <class U>
+    struct rebind {
+        typedef ConfigMemoryAllocator<U> other;
+    };
+
+    template <class U>
+    bool operator==(const ConfigMemoryAllocator<U>& other) const {
+        return resource == other.resource;
+    }
+
+    template <class U>
+    bool operator!=(const ConfigMemoryAllocator<U>& other) const {
+        return resource != other.resource;
+    }
+
+private:
+    template <class U> friend class ConfigMemoryAllocator;
+
+    ConfigMemoryResourcePtr resource;
+};
+
+}
+
+#endif // CONFIG_MEMORY_RESOURCE_H_
@@ -0,0 +1,31 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONFIG_ORIGIN_DETAIL_H_
+#define CONFIG_ORIGIN_DETAIL_H_
+
+namespace config {
+
+///
+/// How much detail the parser keeps in the {@link ConfigOrigin} of parsed
+/// values. Applications that never look at {@link ConfigOrigin#comments()} or
+/// render with origin comments can choose a coarser level to parse faster
+/// and keep less in memory; error messages still carry line numbers.
+///
+enum class ConfigOriginDetail : uint32_t {
+    /// Line numbers and the comments in front of each value.
+    FULL,
+
+    /// Line numbers only; comments are skipped by the tokenizer.
+    LINE,
+
+    /// Only the file (or other description) each value came from; no comments
+    /// and no line numbers.
+    FILE
+};
+
+}
+
+#endif // CONFIG_ORIGIN_DETAIL_H_
@@ -32,7 +32,10 @@ public:
     ConfigParseOptions(ConfigSyntax syntax,
                        const std::string& originDescription,
                        bool allowMissing,
-                       const ConfigIncluderPtr& includer);
+                       const ConfigIncluderPtr& includer,
+                       ConfigOriginDetail originDetail,
+                       bool useArena,
+                       const ConfigMemoryResourcePtr& memoryResource);
 
     static ConfigParseOptionsPtr defaults();
 
@@ -83,11 +86,51 @@ public:
 
     ConfigIncluderPtr getIncluder();
 
+    /// Set how much detail to keep in the origins of parsed values. The
+    /// default, {@code ConfigOriginDetail::FULL}, keeps line numbers and
+    /// comments; {@code LINE} drops comments and {@code FILE} also drops line
+    /// numbers, which makes parsing cheaper when origins are never inspected.
+    ///
+    /// @param originDetail
+    /// @return options with the origin detail set
+    ConfigParseOptionsPtr setOriginDetail(ConfigOriginDetail originDetail);
+
+    ConfigOriginDetail getOriginDetail();
+
+    /// Set whether the values, keys, strings and origins parsed are allocated
+    /// from an arena of their own: memory carved from large chunks, where
+    /// blocks given back are reused by later nodes of the same size. The
+    /// Config parsed owns the arena, and resolving it builds the resolved
+    /// tree in the same arena. The chunks are freed together once the Config
+    /// and the last value from it are gone, so values kept from a dropped
+    /// config keep the whole arena alive. Strings aren't interned in an
+    /// arena. Off by default.
+    ///
+    /// @param useArena
+    /// @return options with the arena setting
+    ConfigParseOptionsPtr setUseArena(bool useArena);
+
+    bool getUseArena();
+
+    /// Set a memory resource for the values and origins parsed to be
+    /// allocated from; it takes precedence over setUseArena(). See
+    /// {@link ConfigMemoryResource}.
+    ///
+    /// @param memoryResource
+    ///            the resource, or null for the default
+    /// @return options with the memory resource set
+    ConfigParseOptionsPtr setMemoryResource(const ConfigMemoryResourcePtr& memoryResource);
+
+    ConfigMemoryResourcePtr getMemoryResource();
+
 private:
     ConfigSyntax syntax;
     std::string originDescription;
     bool allowMissing;
     ConfigIncluderPtr includer;
+    ConfigOriginDetail originDetail;
+    bool useArena;
+    ConfigMemoryResourcePtr memoryResource;
 };
 
 }
@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONFIG_PATH_H_
+#define CONFIG_PATH_H_
+
+#include "configcpp/detail/config_base.h"
+
+namespace config {
+
+///
+/// A path expression parsed once, for code that looks up the same paths over
+/// and over. Each {@link Config} getter, {@link Config#hasPath} and
+/// {@link Config#withValue} has an overload taking a {@code ConfigPath},
+/// which goes straight to the lookup without parsing the expression again.
+/// <p>
+/// This object is immutable, so it can be shared between threads and used
+/// with any number of {@code Config} instances.
+///
+/// <pre>
+///     static auto port = ConfigPath::parse("server.port");
+///     int32_t value = config->getInt(port);
+/// </pre>
+///
+class ConfigPath : public ConfigBase {
+public:
+    CONFIG_CLASS(ConfigPath);
+
+    ConfigPath(const std::string& expression);
+
+    /// Parses a path expression, as accepted by the {@link Config} methods
+    /// taking a {@code std::string} path. Repeated expressions share one
+    /// instance from a bounded process-wide cache, which is what those
+    /// methods use too.
+    ///
+    /// @param expression
+    ///            the path expression
+    /// @return the parsed path
+    /// @throws ConfigExceptionBadPath
+    ///             if the path expression is invalid
+    static ConfigPathPtr parse(const std::string& expression);
+
+    /// The expression this path was parsed from; used in error messages just
+    /// as the {@code std::string} path would be.
+    const std::string& expression();
+
+    /// The parsed path. This method is mostly used by the config lib
+    /// internally, not by applications.
+    const PathPtr& path();
+
+    virtual std::string toString() override;
+
+private:
+    std::string expression_;
+    PathPtr path_;
+};
+
+}
+
+#endif // CONFIG_PATH_H_
@@ -34,7 +34,9 @@ class ConfigResolveOptions : public ConfigBase {
 public:
     CONFIG_CLASS(ConfigResolveOptions);
 
-    ConfigResolveOptions(bool useSystemEnvironment);
+    ConfigResolveOptions(bool useSystemEnvironment,
+                         bool useArena = false,
+                         const ConfigMemoryResourcePtr& memoryResource = nullptr);
 
     /// Returns the default resolve options.
     ///
@@ -62,8 +64,33 @@ public:
     /// @return true if environment variables should be used
     bool getUseSystemEnvironment();
 
+    /// Returns options that allocate the values a resolve makes from an
+    /// arena, as {@link ConfigParseOptions#setUseArena} does for parsing. A
+    /// config parsed into an arena resolves into that one whatever this is
+    /// set to; others get a new arena, owned by the resolved Config.
+    ///
+    /// @param value
+    ///            true to allocate resolved values from an arena
+    /// @return options with the arena setting
+    ConfigResolveOptionsPtr setUseArena(bool value);
+
+    bool getUseArena();
+
+    /// Returns options that allocate the values a resolve makes from the
+    /// given memory resource, as {@link ConfigParseOptions#setMemoryResource}
+    /// does for parsing.
+    ///
+    /// @param memoryResource
+    ///            the resource, or null for the default
+    /// @return options with the memory resource set
+    ConfigResolveOptionsPtr setMemoryResource(const ConfigMemoryResourcePtr& memoryResource);
+
+    ConfigMemoryResourcePtr getMemoryResource();
+
 private:
     bool useSystemEnvironment;
+    bool useArena;
+    ConfigMemoryResourcePtr memoryResource;
 };
 
 }
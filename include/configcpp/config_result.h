@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONFIG_RESULT_H_
+#define CONFIG_RESULT_H_
+
+#include "configcpp/config_types.h"
+
+namespace config {
+
+///
+/// Why a non-throwing lookup has no value. Each error stands for the
+/// exception the corresponding throwing getter would have thrown.
+///
+enum class ConfigError : uint32_t {
+    NONE,           ///< there's a value
+    MISSING,        ///< ConfigExceptionMissing
+    NULL_VALUE,     ///< ConfigExceptionNull
+    WRONG_TYPE,     ///< ConfigExceptionWrongType
+    BAD_VALUE,      ///< ConfigExceptionBadValue
+    BAD_PATH,       ///< ConfigExceptionBadPath
+    NOT_RESOLVED    ///< ConfigExceptionNotResolved
+};
+
+class ConfigErrorEnum {
+public:
+    static std::string name(ConfigError error);
+};
+
+///
+/// The result of one of the {@code Config::tryGet} methods: either a value or
+/// the {@link ConfigError} explaining why there isn't one. Nothing is thrown
+/// to report a missing or unusable setting, which makes these the methods to
+/// use when that is an expected outcome.
+///
+/// <pre>
+///     auto timeout = config->tryGetMilliseconds("client.timeout");
+///     uint64_t ms = timeout ? *timeout : 5000;
+/// </pre>
+///
+template <typename T>
+class ConfigResult {
+public:
+    ConfigResult(const T& value) :
+        value_(value),
+        error_(ConfigError::NONE) {
+    }
+
+    ConfigResult(ConfigError error) :
+        value_(),
+        error_(error) {
+    }
+
+    explicit operator bool() const {
+        return error_ == ConfigError::NONE;
+    }
+
+    /// @return the value; only meaningful if there is one
+    const T& operator*() const {
+        return value_;
+    }
+
+    /// @return the value, or defaultValue if there is none
+    T valueOr(const T& defaultValue) const {
+        return error_ == ConfigError::NONE ? value_ : defaultValue;
+    }
+
+    ConfigError error() const {
+        return error_;
+    }
+
+private:
+    T value_;
+    ConfigError error_;
+};
+
+}
+
+#endif // CONFIG_RESULT_H_
@@ -41,20 +41,28 @@
 #define BOOST_FILESYSTEM_VERSION 2
 #include <boost/filesystem/path.hpp>
 
+#include "configcpp/config_memory_resource.h"
+#include "configcpp/interned_string.h"
+#include "configcpp/small_map.h"
+
 namespace config {
 
 enum class ConfigSyntax : uint32_t;
+enum class ConfigOriginDetail : uint32_t;
 enum class ConfigValueType : uint32_t;
 enum class FromMapMode : uint32_t;
 enum class OriginType : uint32_t;
 enum class TokenType : uint32_t;
 
+class TokenWithComments;
+
 #define DECLARE_SHARED_PTR(Type) \
     class Type; \
     typedef std::shared_ptr<Type> Type##Ptr;
 
 DECLARE_SHARED_PTR(AbstractConfigValue)
 DECLARE_SHARED_PTR(AbstractConfigObject)
+DECLARE_SHARED_PTR(ChunkReader)
 DECLARE_SHARED_PTR(Config)
 DECLARE_SHARED_PTR(ConfigBase)
 DECLARE_SHARED_PTR(ConfigException)
@@ -67,16 +75,19 @@ DECLARE_SHARED_PTR(ConfigList)
 DECLARE_SHARED_PTR(ConfigOrigin)
 DECLARE_SHARED_PTR(ConfigParseable)
 DECLARE_SHARED_PTR(ConfigParseOptions)
+DECLARE_SHARED_PTR(ConfigPath)
 DECLARE_SHARED_PTR(ConfigReference)
 DECLARE_SHARED_PTR(ConfigRenderOptions)
 DECLARE_SHARED_PTR(ConfigResolveOptions)
 DECLARE_SHARED_PTR(ConfigValue)
-DECLARE_SHARED_PTR(Element)
+DECLARE_SHARED_PTR(FrozenConfig)
 DECLARE_SHARED_PTR(FullIncluder)
+DECLARE_SHARED_PTR(JsonParser)
 DECLARE_SHARED_PTR(Parseable)
 DECLARE_SHARED_PTR(Parser)
 DECLARE_SHARED_PTR(Path)
 DECLARE_SHARED_PTR(PathBuilder)
+DECLARE_SHARED_PTR(PathIndex)
 DECLARE_SHARED_PTR(Unmergeable)
 DECLARE_SHARED_PTR(MemoKey)
 DECLARE_SHARED_PTR(Modifier)
@@ -96,7 +107,6 @@ DECLARE_SHARED_PTR(SimpleIncludeContext)
 DECLARE_SHARED_PTR(SubstitutionExpression)
 DECLARE_SHARED_PTR(Token)
 DECLARE_SHARED_PTR(TokenIterator)
-DECLARE_SHARED_PTR(TokenWithComments)
 DECLARE_SHARED_PTR(ValidationProblem)
 DECLARE_SHARED_PTR(WhitespaceSaver)
 
@@ -151,26 +161,28 @@ struct configEquals {
 };
 
 typedef std::unordered_set<std::string> SetString;
+typedef std::unordered_set<InternedString> SetInternedString;
 typedef std::unordered_set<PairStringValue> SetConfigValue;
 typedef std::unordered_set<PathPtr, configHash<PathPtr>, configEquals<PathPtr>> SetPath;
 
 typedef std::unordered_map<std::string, ConfigVariant> MapVariant;
 typedef std::unordered_map<std::string, std::string> MapString;
-typedef std::unordered_map<std::string, ConfigValuePtr> MapConfigValue;
-typedef std::unordered_map<std::string, AbstractConfigValuePtr> MapAbstractConfigValue;
+typedef SmallMap<InternedString, ConfigValuePtr, 8, ConfigMemoryAllocator<InternedEntry<ConfigValuePtr>>> MapConfigValue;
+typedef std::unordered_map<InternedString, AbstractConfigValuePtr, std::hash<InternedString>, std::equal_to<InternedString>,
+                           ConfigMemoryAllocator<std::pair<const InternedString, AbstractConfigValuePtr>>> MapAbstractConfigValue;
 typedef std::unordered_map<MemoKeyPtr, AbstractConfigValuePtr, configHash<MemoKeyPtr>, configEquals<MemoKeyPtr>> MapMemoKeyAbstractConfigValue;
 typedef std::unordered_map<AbstractConfigValuePtr, ResolveReplacerPtr, configHash<AbstractConfigValuePtr>> MapResolveReplacer;
 typedef std::unordered_map<PathPtr, ConfigVariant, configHash<PathPtr>, configEquals<PathPtr>> MapPathVariant;
 typedef std::unordered_map<PathPtr, MapAbstractConfigValue, configHash<PathPtr>, configEquals<PathPtr>> MapPathMapAbstractConfigValue;
 
 typedef std::deque<ParseablePtr> StackParseable;
-typedef std::deque<std::string> StackString;
 typedef std::deque<TokenPtr> QueueToken;
-typedef std::deque<TokenWithCommentsPtr> StackTokenWithComments;
+typedef std::vector<TokenWithComments> StackTokenWithComments;
 typedef std::deque<int32_t> QueueInt;
-typedef std::deque<PathPtr> StackPath;
 
 typedef std::vector<std::string> VectorString;
+typedef std::vector<InternedString> VectorInternedString;
+typedef std::vector<std::reference_wrapper<const std::string>> VectorStringRef;
 typedef std::vector<bool> VectorBool;
 typedef std::vector<int32_t> VectorInt;
 typedef std::vector<int64_t> VectorInt64;
@@ -178,16 +190,17 @@ typedef std::vector<double> VectorDouble;
 typedef std::vector<ConfigObjectPtr> VectorConfigObject;
 typedef std::vector<ConfigPtr> VectorConfig;
 typedef std::vector<ConfigOriginPtr> VectorConfigOrigin;
-typedef std::vector<ConfigValuePtr> VectorConfigValue;
+typedef std::vector<ConfigValuePtr, ConfigMemoryAllocator<ConfigValuePtr>> VectorConfigValue;
 typedef std::vector<ConfigVariant> VectorVariant;
-typedef std::vector<AbstractConfigValuePtr> VectorAbstractConfigValue;
+typedef std::vector<AbstractConfigValuePtr, ConfigMemoryAllocator<AbstractConfigValuePtr>> VectorAbstractConfigValue;
 typedef std::vector<AbstractConfigObjectPtr> VectorAbstractConfigObject;
 typedef std::vector<ValidationProblem> VectorValidationProblem;
 typedef std::vector<PathPtr> VectorPath;
 typedef std::vector<TokenPtr> VectorToken;
-typedef std::vector<ElementPtr> VectorElement;
 typedef std::vector<SubstitutionExpressionPtr> VectorSubstitutionExpression;
 
+typedef std::deque<VectorString> StackKeys;
+
 }
 
 #endif // CONFIG_TYPES_H_
@@ -8,6 +8,7 @@
 
 #include "configcpp/detail/config_base.h"
 #include "configcpp/detail/variant_utils.h"
+#include "configcpp/detail/value_implementation.h"
 #include "configcpp/config_mergeable.h"
 
 namespace config {
@@ -31,7 +32,7 @@ namespace config {
 /// ConfigValue} instances. See also {@link Config} which has methods for parsing
 /// files and certain in-memory data structures.
 ///
-class ConfigValue : public virtual ConfigMergeable {
+class ConfigValue : public virtual ConfigMergeable, private ValueImplementation {
 public:
     /// The origin of the value (file, line number, etc.), for debugging and
     /// error messages.
@@ -183,6 +184,9 @@ public:
     /// @return a new {@link ConfigList} value
     static ConfigListPtr fromVector(const VectorVariant& values,
                                     const std::string& originDescription = "");
+
+private:
+    friend class AbstractConfigValue;
 };
 
 }
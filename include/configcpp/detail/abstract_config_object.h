@@ -15,10 +15,10 @@ class AbstractConfigObject : public AbstractConfigValue, public virtual ConfigOb
 public:
     CONFIG_CLASS(AbstractConfigObject);
 
-    AbstractConfigObject(const ConfigOriginPtr& origin);
-
-    virtual void initialize() override;
+    AbstractConfigObject(const ConfigOriginPtr& origin, ConfigValueKind kind);
 
+    /// Made on first use and shared while anyone holds it. The Config owns
+    /// this object, so holding it here would keep both alive forever.
     virtual ConfigPtr toConfig() override;
 
     virtual ConfigValuePtr toFallbackValue() override;
@@ -53,7 +53,19 @@ public:
     /// @throws ConfigExceptionNotResolved
     ///             if can't figure out key's value or can't know whether it
     ///             exists
-    virtual AbstractConfigValuePtr attemptPeekWithPartialResolve(const std::string& key) = 0;
+    virtual AbstractConfigValuePtr attemptPeekWithPartialResolve(const InternedString& key) = 0;
+
+    /// As attemptPeekWithPartialResolve(), but without taking a reference to
+    /// a value this object holds, for walks that only pass through it; each
+    /// reference costs an atomic increment and decrement. A value that has to
+    /// be made is kept alive by putting it in held.
+    ///
+    /// @param key
+    ///            key to look up
+    /// @param held
+    ///            keeps any value made by the lookup
+    /// @return the value of the key, or null if known not to exist
+    virtual AbstractConfigValue* peekBorrowed(const InternedString& key, AbstractConfigValuePtr& held);
 
     /// Looks up the path with no transformation, type conversion, or exceptions
     /// (just returns null if path not found). Does however resolve the path, if
@@ -119,7 +131,7 @@ public:
     void insert(const MapConfigValue::value_type&);
 
 private:
-    SimpleConfigPtr config;
+    std::weak_ptr<SimpleConfig> config;
 };
 
 }
@@ -8,6 +8,7 @@
 
 #include "configcpp/detail/config_base.h"
 #include "configcpp/detail/resolve_status.h"
+#include "configcpp/detail/config_value_kind.h"
 #include "configcpp/detail/mergeable_value.h"
 #include "configcpp/config_exception.h"
 #include "configcpp/config_value.h"
@@ -64,10 +65,50 @@ class AbstractConfigValue : public virtual ConfigValue, public virtual Mergeable
 public:
     CONFIG_CLASS(AbstractConfigValue);
 
-    AbstractConfigValue(const ConfigOriginPtr& origin);
+    AbstractConfigValue(const ConfigOriginPtr& origin, ConfigValueKind kind);
 
     virtual ConfigOriginPtr origin() override;
 
+    /// The value behind a ConfigValue handle, sharing its reference count.
+    /// Takes a virtual call rather than a dynamic_pointer_cast across the
+    /// virtual bases.
+    static AbstractConfigValuePtr cast(const ConfigValuePtr& value);
+
+    /// The value behind a ConfigValue handle, borrowed from it without
+    /// touching its reference count.
+    static AbstractConfigValue* borrow(const ConfigValuePtr& value);
+
+    ConfigValueKind kind() const {
+        return kind_;
+    }
+
+    /// @return whether this is an AbstractConfigObject
+    bool isObject() const {
+        return kind_ == ConfigValueKind::OBJECT || kind_ == ConfigValueKind::DELAYED_MERGE_OBJECT;
+    }
+
+    /// @return whether this is Unmergeable
+    bool isUnmergeable() const {
+        return kind_ == ConfigValueKind::DELAYED_MERGE_OBJECT || kind_ == ConfigValueKind::DELAYED_MERGE ||
+               kind_ == ConfigValueKind::CONCATENATION || kind_ == ConfigValueKind::REFERENCE;
+    }
+
+    /// The parser creates every value from one shared origin per file and
+    /// records the line here; the per-line origin is only created when
+    /// origin() is asked for. Only call this while the value is being built.
+    void setOriginLine(int32_t lineNumber);
+
+    /// Whether other has this value's origin, line included, so a value
+    /// made from the two can take it over with copyOrigin() rather than
+    /// merge them; e.g. the pieces of a concatenation on one line.
+    bool hasSameOrigin(const AbstractConfigValue& other) const {
+        return origin_ == other.origin_ && originLine_ == other.originLine_;
+    }
+
+    /// Give this value other's origin without creating the per-line one.
+    /// Only call this while the value is being built.
+    void copyOrigin(const AbstractConfigValue& other);
+
     /// Called only by ResolveContext::resolve().
     ///
     /// @param context
@@ -127,6 +168,10 @@ public:
     /// This is only overridden to change the return type
     virtual ConfigMergeablePtr withFallback(const ConfigMergeablePtr& mergeable) override;
 
+    /// withFallback() for a fallback known to be a value, without the casts
+    /// through ConfigMergeable.
+    AbstractConfigValuePtr withFallbackValue(const AbstractConfigValuePtr& other);
+
 protected:
     virtual bool canEqual(const ConfigVariant& other);
 
@@ -156,6 +201,11 @@ public:
     /// other strings or by the DefaultTransformer.
     virtual std::string transformToString();
 
+    /// The string the DefaultTransformer would convert this value to, owned
+    /// by this value, or null if there's no such conversion. Lets string
+    /// getters hand out a reference rather than a copy.
+    virtual const std::string* borrowString();
+
     SimpleConfigPtr atKey(const ConfigOriginPtr& origin, const std::string& key);
 
     virtual ConfigPtr atKey(const std::string& key) override;
@@ -165,7 +215,11 @@ public:
     virtual ConfigPtr atPath(const std::string& path) override;
 
 private:
+    virtual AbstractConfigValue* implementation() override;
+
     SimpleConfigOriginPtr origin_;
+    int32_t originLine_;
+    ConfigValueKind kind_;
 };
 
 }
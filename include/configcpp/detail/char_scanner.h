@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef CHAR_SCANNER_H_
+#define CHAR_SCANNER_H_
+
+#include "configcpp/config_types.h"
+
+namespace config {
+
+///
+/// Finds the end of the character runs the tokenizer skips or copies in bulk:
+/// whitespace, comments and plain quoted-string text. Every scan has a scalar
+/// kernel and, on x86, SSE2 and AVX2 kernels that test 16 or 32 bytes at a
+/// time; the best kernels the CPU supports are picked on first use.
+///
+class CharScanner {
+private:
+    CharScanner();
+
+public:
+    typedef const char* (*ScanFunction)(const char* begin, const char* end);
+
+    /// One implementation of every scan.
+    struct Kernels {
+        std::string name;
+        /// First '"', '\\' or control character in [begin, end), or end.
+        ScanFunction findQuotedStop;
+        /// First '\n' in [begin, end), or end.
+        ScanFunction findNewline;
+        /// First char in [begin, end) that isn't whitespace other than '\n',
+        /// or end.
+        ScanFunction skipWhitespace;
+    };
+
+    static const char* findQuotedStop(const char* begin, const char* end) {
+        return kernels().findQuotedStop(begin, end);
+    }
+
+    static const char* findNewline(const char* begin, const char* end) {
+        return kernels().findNewline(begin, end);
+    }
+
+    static const char* skipWhitespace(const char* begin, const char* end) {
+        return kernels().skipWhitespace(begin, end);
+    }
+
+    /// Kernels this CPU can run, scalar first and best last.
+    static std::vector<Kernels> supportedKernels();
+
+    /// Kernels currently in use.
+    static const Kernels& kernels();
+
+    /// Override the kernels in use; only for tests and benchmarks, as this
+    /// is not synchronized with concurrent scans.
+    static void setKernels(const Kernels& kernels);
+
+private:
+    static Kernels& selected();
+};
+
+}
+
+#endif // CHAR_SCANNER_H_
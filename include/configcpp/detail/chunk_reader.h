@@ -0,0 +1,60 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef CHUNK_READER_H_
+#define CHUNK_READER_H_
+
+#include "configcpp/detail/reader.h"
+#include "configcpp/detail/config_base.h"
+
+namespace config {
+
+///
+/// A character stream that can hand out its characters a contiguous run at a
+/// time, so callers can scan input without a virtual call per character.
+/// Characters consumed through readChunk() are not returned again by read().
+///
+class ChunkReader : public virtual Reader {
+public:
+    /// Return the next contiguous run of characters as [begin, end). The
+    /// characters stay valid until the next call to read(), readChunk() or
+    /// close(). Returns false, with an empty range, at end of stream.
+    virtual bool readChunk(const char*& begin, const char*& end) = 0;
+
+    /// Return everything left in the stream as one contiguous range
+    /// [begin, end). Readers that already hold their input in memory return
+    /// it in place; otherwise the chunks are copied into buffer. The range
+    /// stays valid until close(), or until buffer goes away.
+    virtual void readRemaining(std::string& buffer, const char*& begin, const char*& end);
+};
+
+///
+/// Adapts a plain Reader (such as an application subclass passed to
+/// Config::parseReader) to the ChunkReader interface by buffering characters
+/// pulled through read().
+///
+class ReaderChunkAdapter : public ChunkReader, public ConfigBase {
+public:
+    CONFIG_CLASS(ReaderChunkAdapter);
+
+    ReaderChunkAdapter(const ReaderPtr& reader);
+
+    /// Return reader itself if it already supports chunks, otherwise wrap it.
+    static ChunkReaderPtr adapt(const ReaderPtr& reader);
+
+    virtual int32_t read() override;
+    virtual bool readChunk(const char*& begin, const char*& end) override;
+    virtual void close() override;
+
+private:
+    static const uint32_t BUFFER_SIZE = 4096;
+
+    ReaderPtr reader;
+    char buffer[BUFFER_SIZE];
+};
+
+}
+
+#endif // CHUNK_READER_H_
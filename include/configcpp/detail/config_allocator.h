@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONFIG_ALLOCATOR_H_
+#define CONFIG_ALLOCATOR_H_
+
+#include "configcpp/config_memory_resource.h"
+#include "configcpp/config_types.h"
+
+namespace config {
+
+///
+/// Makes values and origins built on this thread come from the heap for as
+/// long as the scope lasts, whatever resource is current. Shared values kept
+/// in statics are made inside one, or the first resource to build them would
+/// be kept alive for good.
+///
+class ConfigHeapScope {
+public:
+    ConfigHeapScope();
+    ~ConfigHeapScope();
+
+    /// @return the result of calling factory inside a ConfigHeapScope
+    template <class Factory>
+    static auto make(Factory factory) -> decltype(factory()) {
+        ConfigHeapScope heap;
+        return factory();
+    }
+
+private:
+    ConfigHeapScope(const ConfigHeapScope&) = delete;
+    ConfigHeapScope& operator=(const ConfigHeapScope&) = delete;
+
+    const ConfigMemoryResourcePtr* previous;
+};
+
+/// Allocate a Name from the current memory resource if it's a value or an
+/// origin and there is one, otherwise with std::make_shared. Only nodes come
+/// from the resource, and only they look it up: tokens, contexts and the like
+/// made while parsing skip the thread-local lookup altogether.
+template <class Name, class... Args>
+std::shared_ptr<Name> allocateShared(Args&& ... args) {
+    if (std::is_base_of<AbstractConfigValue, Name>::value || std::is_base_of<ConfigOrigin, Name>::value) {
+        auto& resource = ConfigMemoryScope::current();
+        if (resource) {
+            return std::allocate_shared<Name>(ConfigMemoryAllocator<Name>(resource), std::forward<Args>(args)...);
+        }
+    }
+    return std::make_shared<Name>(std::forward<Args>(args)...);
+}
+
+}
+
+#endif // CONFIG_ALLOCATOR_H_
@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONFIG_ARENA_H_
+#define CONFIG_ARENA_H_
+
+#include <mutex>
+#include <vector>
+
+#include "configcpp/config_memory_resource.h"
+
+namespace config {
+
+///
+/// Memory resource the nodes, keys, strings and origins of a config are
+/// allocated from when ConfigParseOptions or ConfigResolveOptions ask for an
+/// arena. Blocks are carved from 64 KB chunks; a block given back goes on a
+/// free list for its size, so the intermediates a parse or resolve drops are
+/// reused by the nodes made after them rather than pinned. Blocks too large
+/// for a free list come from the heap.
+/// <p>
+/// The Config made by the parse or resolve owns the arena, and every node
+/// from it holds a reference too, so the chunks are freed together once the
+/// last of them is gone. Nodes can be freed on any thread, so the arena
+/// takes a lock; it is only ever contended by threads dropping nodes.
+///
+class ConfigArena : public ConfigMemoryResource {
+public:
+    ConfigArena();
+    virtual ~ConfigArena();
+
+    virtual void* allocate(std::size_t bytes, std::size_t alignment) override;
+    virtual void deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+
+    /// @return bytes of chunks taken from the heap so far
+    std::size_t reserved();
+
+    /// @return bytes handed out and not given back
+    std::size_t inUse();
+
+    /// @return the current resource if it is an arena, otherwise null
+    static ConfigMemoryResourcePtr current();
+
+    /// The resource a parse or resolve should make current: the options'
+    /// resource if there is one, else the arena owned by the config being
+    /// resolved, else if the options ask for an arena the current one (so
+    /// includes share it) or a new one, else null to leave things as they
+    /// are.
+    static ConfigMemoryResourcePtr forOptions(bool useArena,
+                                              const ConfigMemoryResourcePtr& resource,
+                                              const ConfigMemoryResourcePtr& owned = nullptr);
+
+private:
+    ConfigArena(const ConfigArena&) = delete;
+    ConfigArena& operator=(const ConfigArena&) = delete;
+
+    static const std::size_t CHUNK_SIZE = 64 * 1024;
+
+    /// Block sizes are rounded up to a multiple of this, which is also the
+    /// alignment every block gets.
+    static const std::size_t GRANULE = 16;
+
+    /// Largest block kept on a free list.
+    static const std::size_t MAX_POOLED = 512;
+
+    std::mutex mutex;
+    std::vector<char*> chunks;
+    char* next;
+    char* end;
+    void* freeLists[MAX_POOLED / GRANULE];
+    std::size_t reservedBytes;
+    std::size_t inUseBytes;
+};
+
+}
+
+#endif // CONFIG_ARENA_H_
@@ -8,6 +8,7 @@
 
 #include "configcpp/detail/instance_utils.h"
 #include "configcpp/detail/misc_utils.h"
+#include "configcpp/detail/config_allocator.h"
 #include "configcpp/config_types.h"
 
 #define CONFIG_CLASS(Name) \
@@ -16,7 +17,7 @@
     } \
     template <class... Args> \
     static std::shared_ptr<Name> make_instance(Args&& ... args) { \
-        std::shared_ptr<Name> instance = std::make_shared<Name>(args...); \
+        std::shared_ptr<Name> instance = allocateShared<Name>(std::forward<Args>(args)...); \
         instance->initialize(); \
         return instance; \
     } \
@@ -39,6 +40,9 @@ namespace config {
 ///     config->foo();
 /// </pre>
 ///
+/// Values and origins made inside a ConfigMemoryScope are allocated from its
+/// memory resource.
+///
 /// Note: You must define the {@code CONFIG_CLASS} macro in classes derived from
 /// ConfigBase.
 ///
@@ -19,6 +19,7 @@ public:
     virtual ConfigValueType valueType() override;
     virtual ConfigVariant unwrapped() override;
     virtual std::string transformToString() override;
+    virtual const std::string* borrowString() override;
 
 protected:
     virtual AbstractConfigValuePtr newCopy(const ConfigOriginPtr& origin) override;
@@ -87,7 +87,7 @@ public:
     virtual MapConfigValue::size_type count(const MapConfigValue::key_type& key) const override;
     virtual MapConfigValue::const_iterator find(const MapConfigValue::key_type& key) const override;
 
-    virtual AbstractConfigValuePtr attemptPeekWithPartialResolve(const std::string& key) override;
+    virtual AbstractConfigValuePtr attemptPeekWithPartialResolve(const InternedString& key) override;
 
 private:
     VectorAbstractConfigValue stack;
@@ -18,7 +18,6 @@ public:
 
     virtual ConfigValueType valueType() override;
     virtual ConfigVariant unwrapped() override;
-    virtual std::string transformToString() override;
 
 protected:
     virtual int64_t int64Value() override;
@@ -15,7 +15,7 @@ public:
     CONFIG_CLASS(ConfigNumber);
 
 protected:
-    ConfigNumber(const ConfigOriginPtr& origin, const std::string& originalText);
+    ConfigNumber(const ConfigOriginPtr& origin, ConfigValueKind kind, const std::string& originalText);
 
 public:
     virtual ConfigVariant unwrapped() = 0;
@@ -26,6 +26,7 @@ public:
     }
 
     virtual std::string transformToString() override;
+    virtual const std::string* borrowString() override;
 
     int32_t intValueRangeChecked(const std::string& path);
 
@@ -53,7 +54,8 @@ protected:
     /// This is so when we concatenate a number into a string (say it appears in
     /// a sentence) we always have it exactly as the person typed it into the
     /// config file. It's purely cosmetic; equals/hashCode don't consider this
-    /// for example.
+    /// for example. Numbers made without any text get their default rendering,
+    /// so there's always a string to borrow.
     std::string originalText;
 };
 
@@ -19,6 +19,7 @@ public:
     virtual ConfigValueType valueType() override;
     virtual ConfigVariant unwrapped() override;
     virtual std::string transformToString() override;
+    virtual const std::string* borrowString() override;
 
 protected:
     virtual void render(std::string& s,
@@ -27,7 +28,9 @@ protected:
     virtual AbstractConfigValuePtr newCopy(const ConfigOriginPtr& origin) override;
 
 private:
-    std::string value;
+    /// interned, since many strings recur across a large config, unless made
+    /// inside a ConfigMemoryScope, when it comes from the scope's resource
+    InternedString value;
 };
 
 }
@@ -0,0 +1,34 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef CONFIG_VALUE_KIND_H_
+#define CONFIG_VALUE_KIND_H_
+
+#include "configcpp/config_types.h"
+
+namespace config {
+
+///
+/// The concrete class of an AbstractConfigValue, so hot paths can test it
+/// and static_pointer_cast rather than use instanceof.
+///
+enum class ConfigValueKind : uint8_t {
+    BOOLEAN,
+    NULL_VALUE,
+    INT,
+    INT64,
+    DOUBLE,
+    STRING,
+    LIST,
+    OBJECT,
+    DELAYED_MERGE_OBJECT,
+    DELAYED_MERGE,
+    CONCATENATION,
+    REFERENCE
+};
+
+}
+
+#endif // CONFIG_VALUE_KIND_H_
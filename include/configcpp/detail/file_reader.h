@@ -6,7 +6,7 @@
 #ifndef FILE_READER_H_
 #define FILE_READER_H_
 
-#include "configcpp/detail/reader.h"
+#include "configcpp/detail/chunk_reader.h"
 #include "configcpp/detail/config_base.h"
 
 namespace config {
@@ -14,13 +14,14 @@ namespace config {
 ///
 /// Convenience class for reading character files.
 ///
-class FileReader : public virtual Reader, public ConfigBase {
+class FileReader : public virtual ChunkReader, public ConfigBase {
 public:
     CONFIG_CLASS(FileReader);
 
     FileReader(const std::string& file);
 
     virtual int32_t read() override;
+    virtual bool readChunk(const char*& begin, const char*& end) override;
     virtual void close() override;
 
 private:
@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef FROZEN_CONFIG_H_
+#define FROZEN_CONFIG_H_
+
+#include "configcpp/detail/simple_config.h"
+
+namespace config {
+
+///
+/// Read-optimized snapshot of a resolved config, made by Config::freeze().
+///
+/// Every leaf path, rendered, is placed by a minimal perfect hash (hash and
+/// displace: the hash picks a bucket whose displacement seed picks the slot)
+/// into a flat table of slots that hold the value inline; keys and string
+/// values live in one character arena. A lookup hashes the path expression
+/// once, reads a seed and a slot and compares the key, without parsing the
+/// path.
+///
+/// Only scalar getters whose path is written in rendered form and whose
+/// value has the requested type are answered from the table; everything
+/// else (conversions, errors, objects, lists) goes to SimpleConfig.
+///
+class FrozenConfig : public SimpleConfig {
+public:
+    CONFIG_CLASS(FrozenConfig);
+
+    FrozenConfig(const AbstractConfigObjectPtr& object);
+
+    virtual ConfigPtr freeze() override;
+
+    virtual bool hasPath(const std::string& path) override;
+    virtual bool hasPath(const ConfigPathPtr& path) override;
+    virtual bool getBoolean(const std::string& path) override;
+    virtual bool getBoolean(const ConfigPathPtr& path) override;
+    virtual int32_t getInt(const std::string& path) override;
+    virtual int32_t getInt(const ConfigPathPtr& path) override;
+    virtual int64_t getInt64(const std::string& path) override;
+    virtual int64_t getInt64(const ConfigPathPtr& path) override;
+    virtual double getDouble(const std::string& path) override;
+    virtual double getDouble(const ConfigPathPtr& path) override;
+    virtual std::string getString(const std::string& path) override;
+    virtual std::string getString(const ConfigPathPtr& path) override;
+
+    /// @return number of leaf paths in the table
+    uint32_t size();
+
+private:
+    struct Slot {
+        uint32_t keyOffset;
+        uint32_t keyLength;
+        ConfigValueType type;
+        /// string values: length of the value, which starts at int64Value
+        uint32_t stringLength;
+        int64_t int64Value;
+        double doubleValue;
+    };
+
+    static uint64_t hashKey(const std::string& key);
+    static uint32_t slotHash(uint64_t hash, uint32_t seed);
+
+    /// Map a 32-bit hash onto [0, n) without a division.
+    static uint32_t reduce(uint32_t hash, uint32_t n);
+
+    /// @return slot holding path or null if path isn't in the table
+    const Slot* lookup(const std::string& path);
+
+    /// Fill slots from the leaves of the config.
+    void build();
+
+    std::vector<uint32_t> seeds;
+    std::vector<Slot> slots;
+    std::string arena;
+};
+
+}
+
+#endif // FROZEN_CONFIG_H_
@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef JSON_PARSER_H_
+#define JSON_PARSER_H_
+
+#include "configcpp/detail/config_base.h"
+
+namespace config {
+
+///
+/// Single-pass parser for ConfigSyntax::JSON documents that builds the value
+/// tree straight from the characters, without the token stream, whitespace
+/// saving or value concatenation the HOCON parser needs.
+///
+/// The fast path only accepts documents it is certain the general parser
+/// would accept and parse to the same values and origins. Anything else
+/// (including every invalid document) is handed to Parser::parse() over the
+/// same characters, so errors and edge cases behave exactly as before.
+///
+class JsonParser : public ConfigBase {
+public:
+    CONFIG_CLASS(JsonParser);
+
+    JsonParser(const ConfigOriginPtr& origin,
+               const char* begin,
+               const char* end,
+               ConfigOriginDetail originDetail);
+
+    static AbstractConfigValuePtr parse(const ChunkReaderPtr& input,
+                                        const ConfigOriginPtr& origin,
+                                        const ConfigParseOptionsPtr& options,
+                                        const ConfigIncludeContextPtr& includeContext);
+
+private:
+    /// Parse the whole document; returns null if the fast path can't.
+    AbstractConfigValuePtr parseDocument();
+
+    /// The parseXXX() methods return null, leaving the position wherever they
+    /// gave up, if the input needs the general parser.
+    AbstractConfigValuePtr parseValue();
+    AbstractConfigValuePtr parseObject();
+    AbstractConfigValuePtr parseArray();
+    AbstractConfigValuePtr parseNumber();
+    AbstractConfigValuePtr parseLiteral();
+    bool parseString(std::string& s);
+
+    /// Skip whitespace, counting newlines.
+    void skipWhitespace();
+
+    /// Return value with its origin set to the line it started on.
+    AbstractConfigValuePtr atLine(const AbstractConfigValuePtr& value, int32_t lineNumber);
+
+private:
+    SimpleConfigOriginPtr origin_;
+    const char* position;
+    const char* end;
+    bool keepLines;
+    int32_t lineNumber;
+};
+
+}
+
+#endif // JSON_PARSER_H_
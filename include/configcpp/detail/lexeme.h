@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef LEXEME_H_
+#define LEXEME_H_
+
+#include "configcpp/detail/config_base.h"
+#include "configcpp/detail/token_type.h"
+
+namespace config {
+
+///
+/// A token held by value: what the parser pulls straight from the lexer, so
+/// punctuation, newlines, whitespace, keys and simple values don't need a
+/// Token object each. A value's node is only built once the parser asks for
+/// it. A substitution whose path is one key keeps the key's text; other
+/// substitutions and problems still carry their token.
+///
+class Lexeme {
+public:
+    Lexeme(TokenType type = TokenType::START);
+
+    /// Starts the lexeme over as the given type; the lexer reuses one
+    /// lexeme, so this keeps the text's buffer.
+    void reset(TokenType type, int32_t line = -1);
+
+    /// Wraps a token that came from somewhere other than the lexer.
+    static Lexeme fromToken(const TokenPtr& token);
+
+    /// The token this stands for; tokens are only created here, for the
+    /// Tokenizer API and for path expressions.
+    TokenPtr toToken(const ConfigOriginPtr& baseOrigin) const;
+
+    bool isValue() const;
+    bool isValueWithType(ConfigValueType valueType) const;
+
+    /// The value of a VALUE lexeme, built on baseOrigin if it isn't already.
+    AbstractConfigValuePtr toValue(const ConfigOriginPtr& baseOrigin) const;
+
+    /// The text of a quoted string value.
+    std::string stringValue() const;
+
+    std::string toString() const;
+
+    TokenType type;
+    /// The line recorded on the token (-1 for none); for a newline, the line
+    /// it ended.
+    int32_t line;
+    /// Unquoted text, comment text, or a string or number as written.
+    std::string text;
+    /// For a VALUE from the lexer: the type and, for numbers and booleans,
+    /// what was parsed.
+    ConfigValueType valueType;
+    int64_t intValue;
+    double doubleValue;
+    bool isDouble;
+    bool booleanValue;
+    /// For a SUBSTITUTION: whether it is ${?...}, and whether the one key
+    /// in text was quoted.
+    bool optional;
+    bool quoted;
+    /// A value the parser has already built, e.g. a concatenation.
+    AbstractConfigValuePtr value;
+    /// Problems, substitutions with more than one key token, and anything
+    /// from fromToken().
+    TokenPtr token;
+};
+
+}
+
+#endif // LEXEME_H_
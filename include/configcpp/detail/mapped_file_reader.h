@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPPED_FILE_READER_H_
+#define MAPPED_FILE_READER_H_
+
+#include "configcpp/detail/chunk_reader.h"
+#include "configcpp/detail/config_base.h"
+
+namespace config {
+
+///
+/// Reads a character file by mapping it into memory. Regular files are
+/// mapped in one go so characters are served straight from the page cache
+/// without an intermediate copy. Pipes, character devices and anything else
+/// that can't be mapped are streamed through a read buffer instead.
+///
+class MappedFileReader : public virtual ChunkReader, public ConfigBase {
+public:
+    CONFIG_CLASS(MappedFileReader);
+
+    MappedFileReader(const std::string& file);
+    virtual ~MappedFileReader();
+
+    virtual int32_t read() override;
+    virtual bool readChunk(const char*& begin, const char*& end) override;
+    virtual void readRemaining(std::string& buffer, const char*& begin, const char*& end) override;
+    virtual void close() override;
+
+    /// Return whether the file contents are memory-mapped rather than
+    /// streamed.
+    bool mapped();
+
+private:
+    bool fillBuffer();
+    void unmap();
+
+private:
+    static const uint32_t BUFFER_SIZE = 65536;
+
+    int32_t fd;
+
+    // points at the mapping, or at buffer when streaming
+    const char* data;
+    size_t size;
+    size_t position;
+
+    bool mapped_;
+    std::vector<char> buffer;
+};
+
+}
+
+#endif // MAPPED_FILE_READER_H_
@@ -18,27 +18,6 @@ private:
     MiscUtils();
 
 public:
-    /// Return a new map that is dynamically cast from elements from another
-    template <typename T, typename U>
-    static T dynamic_map(U source) {
-        T newMap;
-        for (auto& v : source) {
-            newMap.insert(std::make_pair(v.first, std::dynamic_pointer_cast<typename T::mapped_type::element_type>(v.second)));
-        }
-        return newMap;
-    }
-
-    /// Return a new vector that is dynamically cast from elements from another
-    template <typename T, typename U>
-    static T dynamic_vector(U source) {
-        T newVector;
-        newVector.reserve(source.size());
-        for (auto& v : source) {
-            newVector.push_back(std::dynamic_pointer_cast<typename T::value_type::element_type>(v));
-        }
-        return newVector;
-    }
-
     /// Extract map keys
     template <typename U, typename V>
     static void key_set(U first, U last, V output) {
@@ -0,0 +1,38 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef NUMBER_PARSER_H_
+#define NUMBER_PARSER_H_
+
+#include "configcpp/config_types.h"
+
+namespace config {
+
+///
+/// Locale-independent number parsing that reports failure by return value
+/// instead of throwing. Accepts exactly the strings boost::lexical_cast
+/// accepts in the "C" locale and produces the same values.
+///
+class NumberParser {
+private:
+    NumberParser();
+
+public:
+    /// Parse an optionally signed run of decimal digits; fails on anything
+    /// else, including overflow.
+    static bool parseInt64(const std::string& s, int64_t& value);
+
+    /// Parse a decimal floating point number, or inf/infinity/nan. Common
+    /// short numbers are converted exactly without calling strtod; anything
+    /// else falls back to the slower (but identical) lexical_cast.
+    static bool parseDouble(const std::string& s, double& value);
+
+private:
+    static bool parseDoubleSlow(const std::string& s, double& value);
+};
+
+}
+
+#endif // NUMBER_PARSER_H_
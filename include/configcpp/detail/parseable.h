@@ -102,7 +102,6 @@ public:
 
 private:
     ConfigParseOptionsPtr baseOptions;
-    ConfigIncludeContextPtr includeContext_;
     ConfigParseOptionsPtr initialOptions;
     ConfigOriginPtr initialOrigin;
 
@@ -7,6 +7,7 @@
 #define PARSER_H_
 
 #include "configcpp/detail/config_base.h"
+#include "configcpp/detail/lexeme.h"
 #include "configcpp/config_exception.h"
 
 namespace config {
@@ -21,8 +22,6 @@ public:
                                         const ConfigIncludeContextPtr& includeContext);
 
 private:
-    static void addPathText(VectorElement& buf, bool wasQuoted, const std::string& newText);
-
     static PathPtr parsePathExpression(const TokenIteratorPtr& expression,
                                        const ConfigOriginPtr& origin,
                                        const std::string& originalText = "");
@@ -44,20 +43,59 @@ private:
     friend class ParseContext;
 };
 
-class TokenWithComments : public ConfigBase {
+///
+/// The keys of a path expression, added a token at a time, so the parser
+/// can make keys and substitutions into paths straight from their lexemes.
+///
+class PathExpression {
 public:
-    CONFIG_CLASS(TokenWithComments);
+    /// Problems are reported at origin, on line if there is one.
+    PathExpression(const ConfigOriginPtr& origin, int32_t line = -1,
+                   const std::string& originalText = "");
+
+    /// Add a key token; throws ConfigExceptionBadPath for any other.
+    void add(const Lexeme& t);
+
+    /// Add text; periods in it separate keys unless it was quoted.
+    void add(bool wasQuoted, const std::string& text);
+
+    /// The keys, which are moved out; throws ConfigExceptionBadPath if
+    /// one is empty without having been quoted.
+    VectorString keys();
+
+    PathPtr result();
+
+private:
+    void endKey();
+
+    ConfigExceptionBadPath badPath(const std::string& message);
+
+    ConfigOriginPtr origin;
+    int32_t line;
+    std::string originalText;
+    VectorString keys_;
+    // whether the last key was quoted empty, and whether an earlier key
+    // was empty without that
+    bool canBeEmpty;
+    bool haveEmptyKey;
+};
 
-    TokenWithComments(const TokenPtr& token, const VectorToken& comments = VectorToken());
+///
+/// A token and the comments that go with it. Passed around by value, so
+/// the parser doesn't allocate anything per token it pulls.
+///
+class TokenWithComments {
+public:
+    TokenWithComments(Lexeme token = Lexeme(), VectorString comments = VectorString());
 
-    TokenWithCommentsPtr prepend(const VectorToken& earlier);
-    SimpleConfigOriginPtr setComments(const SimpleConfigOriginPtr& origin);
+    void prepend(const VectorString& earlier);
+    SimpleConfigOriginPtr setComments(const SimpleConfigOriginPtr& origin) const;
 
-    virtual std::string toString() override;
+    std::string toString() const;
 
 private:
-    TokenPtr token;
-    VectorToken comments;
+    Lexeme token;
+    VectorString comments;
 
     friend class ParseContext;
 };
@@ -66,16 +104,17 @@ class ParseContext : public ConfigBase {
 public:
     CONFIG_CLASS(ParseContext);
 
-    ParseContext(ConfigSyntax flavor, const ConfigOriginPtr& origin,
+    ParseContext(ConfigSyntax flavor, ConfigOriginDetail originDetail,
+                 const ConfigOriginPtr& origin,
                  const TokenIteratorPtr& tokens, const FullIncluderPtr& includer,
                  const ConfigIncludeContextPtr& includeContext);
 
 private:
-    void consolidateCommentBlock(const TokenPtr& commentToken);
-    TokenWithCommentsPtr popToken();
-    TokenWithCommentsPtr nextToken();
-    void putBack(const TokenWithCommentsPtr& token);
-    TokenWithCommentsPtr nextTokenIgnoringNewline();
+    void consolidateCommentBlock(Lexeme next);
+    TokenWithComments popToken();
+    TokenWithComments nextToken();
+    void putBack(TokenWithComments token);
+    TokenWithComments nextTokenIgnoringNewline();
     bool checkElementSeparator();
 
     // Merge a bunch of adjacent values into one
@@ -83,37 +122,44 @@ private:
     // value.
     void consolidateValueTokens();
 
-    static SubstitutionExpressionPtr tokenToSubstitutionExpression(const TokenPtr& valueToken);
+    SubstitutionExpressionPtr substitutionExpression(const Lexeme& t);
 
     ConfigOriginPtr lineOrigin();
 
+    /// Origin for objects and arrays; only the file with ConfigOriginDetail::FILE
+    ConfigOriginPtr valueOrigin();
+
     ConfigExceptionParse parseError(const std::string& message);
 
-    std::string previousFieldName(const PathPtr& lastPath);
+    std::string previousFieldName(const VectorString& lastPath);
     PathPtr fullCurrentPath();
     std::string previousFieldName();
 
     std::string addKeyName(const std::string& message);
     std::string addQuoteSuggestion(const std::string& badToken,
                                    const std::string& message);
-    std::string addQuoteSuggestion(const PathPtr& lastPath,
+    std::string addQuoteSuggestion(const VectorString& lastPath,
                                    bool insideEquals,
                                    const std::string& badToken,
                                    const std::string& message);
 
-    AbstractConfigValuePtr parseValue(const TokenWithCommentsPtr& t);
+    AbstractConfigValuePtr parseValue(const TokenWithComments& t);
 
-    static AbstractConfigObjectPtr createValueUnderPath(const PathPtr& path,
+    /// The object for keys [begin, end) of a path with value at the end.
+    static AbstractConfigObjectPtr createValueUnderPath(VectorString::const_iterator begin,
+                                                        VectorString::const_iterator end,
                                                         const AbstractConfigValuePtr& value);
 
-    PathPtr parseKey(const TokenWithCommentsPtr& token);
+    /// @return the key's path, as its keys
+    VectorString parseKey(const TokenWithComments& token);
 
-    static bool isIncludeKeyword(const TokenPtr& t);
-    static bool isUnquotedWhitespace(const TokenPtr& t);
+    static bool isKeyToken(const Lexeme& t);
+    static bool isIncludeKeyword(const Lexeme& t);
+    static bool isUnquotedWhitespace(const Lexeme& t);
 
     void parseInclude(MapAbstractConfigValue& values);
 
-    bool isKeyValueSeparatorToken(const TokenPtr& t);
+    bool isKeyValueSeparatorToken(const Lexeme& t);
 
     AbstractConfigObjectPtr parseObject(bool hadOpenCurly);
     SimpleConfigListPtr parseArray();
@@ -123,29 +169,19 @@ public:
 
 private:
     int32_t lineNumber;
+    // put back tokens, the next one at the back
     StackTokenWithComments buffer;
     TokenIteratorPtr tokens;
     FullIncluderPtr includer;
     ConfigIncludeContextPtr includeContext;
     ConfigSyntax flavor;
+    ConfigOriginDetail originDetail;
     ConfigOriginPtr baseOrigin;
-    StackPath pathStack;
+    // the paths of the keys whose values we're inside, innermost at front
+    StackKeys pathStack;
     int32_t equalsCount;
 };
 
-class Element : public ConfigBase {
-public:
-    CONFIG_CLASS(Element);
-
-    Element(const std::string& initial, bool canBeEmpty);
-
-    virtual std::string toString() override;
-
-    std::string element;
-    // an element can be empty if it has a quoted empty string "" in it
-    bool canBeEmpty;
-};
-
 }
 
 #endif // PARSER_H_
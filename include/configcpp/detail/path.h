@@ -10,15 +10,35 @@
 
 namespace config {
 
+///
+/// An immutable path: a slice of a shared, contiguous buffer of keys. Slices
+/// (remainder(), parent(), subPath()) share the buffer, so they are O(1) and
+/// never copy keys, and each path carries its hash precomputed. Keys are
+/// interned, so looking a path up in an object compares them by pointer.
+///
 class Path : public ConfigBase {
+private:
+    /// Keys of one or more paths together with running totals of their
+    /// hash terms, so the hash of any slice is a single subtraction.
+    struct Segments {
+        VectorInternedString keys;
+        std::vector<uint32_t> hashes;
+
+        Segments(VectorInternedString keys);
+    };
+
+    typedef std::shared_ptr<const Segments> SegmentsPtr;
+
 public:
     CONFIG_CLASS(Path);
 
     Path(const std::string& first, const PathPtr& remainder);
     Path(const VectorString& elements = VectorString());
+    Path(VectorInternedString&& elements);
     Path(const VectorPath& pathsToConcat);
+    Path(const SegmentsPtr& segments, uint32_t begin, uint32_t end);
 
-    std::string first();
+    const std::string& first();
 
     /// @return path minus the first element or null if no more elements
     PathPtr remainder();
@@ -27,7 +47,13 @@ public:
     PathPtr parent();
 
     /// @return last element in the path
-    std::string last();
+    const std::string& last();
+
+    /// @return element at index, valid for as long as this path is
+    const std::string& element(uint32_t index);
+
+    /// @return element at index as the interned key objects are looked up by
+    const InternedString& key(uint32_t index);
 
     PathPtr prepend(const PathPtr& toPrepend);
 
@@ -39,6 +65,9 @@ public:
     virtual bool equals(const ConfigVariant& other) override;
     virtual uint32_t hashCode() override;
 
+    /// The hash of a path is the sum of this for each of its keys.
+    static uint32_t hashKey(const InternedString& key);
+
     /// This doesn't have a very precise meaning, just to reduce
     /// noise from quotes in the rendered path for average cases.
     static bool hasFunkyChars(const std::string& s);
@@ -46,6 +75,9 @@ public:
 private:
     void appendToStream(std::string& s);
 
+    /// Append our keys to a buffer for a new path.
+    void appendKeys(VectorInternedString& keys);
+
 public:
     virtual std::string toString() override;
 
@@ -54,11 +86,17 @@ public:
     std::string render();
 
     static PathPtr newKey(const std::string& key);
+
+    /// Parse a path expression. Not cached: the getters' paths are cached
+    /// by ConfigPath::parse(), and one-shot internal callers would only
+    /// crowd them out.
     static PathPtr newPath(const std::string& path);
 
 private:
-    std::string first_;
-    PathPtr remainder_;
+    SegmentsPtr segments_;
+    uint32_t begin_;
+    uint32_t end_;
+    uint32_t hash_;
 };
 
 }
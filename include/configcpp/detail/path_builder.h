@@ -23,8 +23,7 @@ public:
     PathPtr result();
 
 private:
-    /// the keys are kept "backward" (top of stack is end of path)
-    StackString keys;
+    VectorString keys;
 
     PathPtr result_;
 };
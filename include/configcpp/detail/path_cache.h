@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef PATH_CACHE_H_
+#define PATH_CACHE_H_
+
+#include "configcpp/config_types.h"
+
+namespace config {
+
+///
+/// Process-wide cache of parsed path expressions, used by ConfigPath::parse()
+/// so getters called over and over with the same std::string path neither
+/// parse it nor build a ConfigPath again. ConfigPaths are immutable, so one
+/// instance can be handed to any thread.
+///
+/// The cache holds at most limit() paths. When it is full a new path takes
+/// the slot of one that hasn't been looked up since the clock hand last
+/// passed it, so a burst of one-off paths can't flush the ones getters keep
+/// asking for. A limit of 0 turns caching off.
+///
+/// Each thread also remembers the paths it looked up last, so a repeated
+/// lookup takes no lock; only misses go to the shared table.
+///
+class PathCache {
+private:
+    PathCache();
+
+public:
+    static const uint32_t DEFAULT_LIMIT = 1024;
+
+    /// Return the parsed path, from the cache if it's there.
+    /// @throws ConfigExceptionBadPath if the path expression is invalid
+    static ConfigPathPtr get(const std::string& path);
+
+    static uint32_t limit();
+
+    /// Set the maximum number of cached paths, dropping the current ones.
+    static void setLimit(uint32_t limit);
+
+    /// Number of paths currently cached.
+    static uint32_t size();
+
+    static uint64_t hits();
+    static uint64_t misses();
+
+    /// Drop all cached paths and reset the hit and miss counters.
+    static void clear();
+
+private:
+    struct Entry;
+    struct State;
+    struct Front;
+    static State& state();
+    static Front& front();
+};
+
+}
+
+#endif // PATH_CACHE_H_
@@ -0,0 +1,60 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef PATH_INDEX_H_
+#define PATH_INDEX_H_
+
+#include "configcpp/detail/config_base.h"
+
+namespace config {
+
+///
+/// Every path in a resolved object mapped to the value stored there, so a
+/// lookup is one hash probe rather than a walk down the tree. Objects and
+/// nulls are indexed as well as leaves; callers still apply the conversions
+/// and type checks a walk would have.
+///
+/// Each path is stored as its last key and a link to its parent's entry,
+/// with the full path's hash, in one open-addressed table; a probe compares
+/// hashes and then walks the links to confirm the keys.
+///
+class PathIndex : public ConfigBase {
+public:
+    CONFIG_CLASS(PathIndex);
+
+    PathIndex(const AbstractConfigObjectPtr& root);
+
+    /// @return value at path or null if there is no such path; the value is
+    ///         borrowed from the index
+    AbstractConfigValue* find(const PathPtr& path);
+
+    /// @return number of paths in the index
+    uint32_t size();
+
+private:
+    static const uint32_t NO_PARENT;
+
+    struct Entry {
+        std::string key;
+        uint32_t parent;
+        uint32_t hash;
+        AbstractConfigValuePtr value;
+    };
+
+    void addObject(uint32_t parent, uint32_t parentHash, const AbstractConfigObjectPtr& obj);
+
+    /// Whether entry is the last key of path.
+    bool matches(uint32_t entry, const PathPtr& path);
+
+    std::vector<Entry> entries;
+
+    /// entry number plus one, or zero for an empty slot
+    std::vector<uint32_t> slots;
+    uint32_t mask;
+};
+
+}
+
+#endif // PATH_INDEX_H_
@@ -10,6 +10,9 @@
 #include "configcpp/detail/mergeable_value.h"
 #include "configcpp/config.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace config {
 
 ///
@@ -22,14 +25,22 @@ class SimpleConfig : public virtual Config, public virtual MergeableValue, publi
 public:
     CONFIG_CLASS(SimpleConfig);
 
+    /// Takes ownership of the current arena, if there is one: the config is
+    /// made by the parse or resolve that built its tree there.
     SimpleConfig(const AbstractConfigObjectPtr& object);
 
+    /// @return the arena this config's tree was built in, or null
+    ConfigMemoryResourcePtr arena();
+
     virtual ConfigObjectPtr root() override;
     virtual ConfigOriginPtr origin() override;
     virtual ConfigPtr resolve() override;
     virtual ConfigPtr resolve(const ConfigResolveOptionsPtr& options) override;
     virtual bool hasPath(const std::string& path) override;
+    virtual bool hasPath(const ConfigPathPtr& path) override;
     virtual bool empty() override;
+    virtual void indexPaths() override;
+    virtual ConfigPtr freeze() override;
 
 private:
     static void findPaths(SetConfigValue& entries,
@@ -40,19 +51,27 @@ public:
     virtual SetConfigValue entrySet() override;
 
 private:
-    static AbstractConfigValuePtr findKey(const AbstractConfigObjectPtr& self,
-                                          const std::string& key,
-                                          ConfigValueType expected,
-                                          const PathPtr& originalPath);
-    static AbstractConfigValuePtr find(const AbstractConfigObjectPtr& self,
-                                       const PathPtr& path,
-                                       ConfigValueType expected,
-                                       const PathPtr& originalPath);
-
-    AbstractConfigValuePtr find(const PathPtr& pathExpression,
-                                ConfigValueType expected,
-                                const PathPtr& originalPath);
-    AbstractConfigValuePtr find(const std::string& path,
+    /// A shared reference to a value found by the borrowing lookups.
+    static AbstractConfigValuePtr share(AbstractConfigValue* found,
+                                        const AbstractConfigValuePtr& held);
+    static AbstractConfigValue* checkFound(AbstractConfigValue* found,
+                                           ConfigValueType expected,
+                                           const PathPtr& originalPath,
+                                           uint32_t depth,
+                                           AbstractConfigValuePtr& held);
+
+    /// Lookups return values borrowed from the tree, taking no references on
+    /// the way down; held keeps alive any value that had to be made, such as
+    /// a number converted from a string, and must outlive the result.
+    static AbstractConfigValue* find(AbstractConfigObject* self,
+                                     const PathPtr& path,
+                                     ConfigValueType expected,
+                                     const PathPtr& originalPath,
+                                     AbstractConfigValuePtr& held);
+    AbstractConfigValue* find(const ConfigPathPtr& path,
+                              ConfigValueType expected,
+                              AbstractConfigValuePtr& held);
+    AbstractConfigValuePtr find(const ConfigPathPtr& path,
                                 ConfigValueType expected);
 
 public:
@@ -71,8 +90,23 @@ public:
     virtual uint64_t getMilliseconds(const std::string& path) override;
     virtual uint64_t getNanoseconds(const std::string& path) override;
 
+    virtual ConfigValuePtr getValue(const ConfigPathPtr& path) override;
+    virtual bool getBoolean(const ConfigPathPtr& path) override;
+    virtual ConfigNumberPtr getConfigNumber(const ConfigPathPtr& path);
+    virtual int32_t getInt(const ConfigPathPtr& path) override;
+    virtual int64_t getInt64(const ConfigPathPtr& path) override;
+    virtual double getDouble(const ConfigPathPtr& path) override;
+    virtual std::string getString(const ConfigPathPtr& path) override;
+    virtual ConfigListPtr getList(const ConfigPathPtr& path) override;
+    virtual ConfigObjectPtr getObject(const ConfigPathPtr& path) override;
+    virtual ConfigPtr getConfig(const ConfigPathPtr& path) override;
+    virtual ConfigVariant getVariant(const ConfigPathPtr& path) override;
+    virtual uint64_t getBytes(const ConfigPathPtr& path) override;
+    virtual uint64_t getMilliseconds(const ConfigPathPtr& path) override;
+    virtual uint64_t getNanoseconds(const ConfigPathPtr& path) override;
+
 private:
-    VectorVariant getHomogeneousUnwrappedList(const std::string& path,
+    VectorVariant getHomogeneousUnwrappedList(const ConfigPathPtr& path,
                                               ConfigValueType expected);
 
 public:
@@ -82,8 +116,14 @@ public:
     virtual VectorDouble getDoubleList(const std::string& path) override;
     virtual VectorString getStringList(const std::string& path) override;
 
+    virtual VectorBool getBooleanList(const ConfigPathPtr& path) override;
+    virtual VectorInt getIntList(const ConfigPathPtr& path) override;
+    virtual VectorInt64 getInt64List(const ConfigPathPtr& path) override;
+    virtual VectorDouble getDoubleList(const ConfigPathPtr& path) override;
+    virtual VectorString getStringList(const ConfigPathPtr& path) override;
+
 private:
-    VectorConfigValue getHomogeneousWrappedList(const std::string& path,
+    VectorConfigValue getHomogeneousWrappedList(const ConfigPathPtr& path,
                                                 ConfigValueType expected);
 
 public:
@@ -94,6 +134,74 @@ public:
     virtual VectorInt64 getMillisecondsList(const std::string& path) override;
     virtual VectorInt64 getNanosecondsList(const std::string& path) override;
 
+    virtual VectorConfigObject getObjectList(const ConfigPathPtr& path) override;
+    virtual VectorConfig getConfigList(const ConfigPathPtr& path) override;
+    virtual VectorVariant getVariantList(const ConfigPathPtr& path) override;
+    virtual VectorInt64 getBytesList(const ConfigPathPtr& path) override;
+    virtual VectorInt64 getMillisecondsList(const ConfigPathPtr& path) override;
+    virtual VectorInt64 getNanosecondsList(const ConfigPathPtr& path) override;
+
+    virtual const std::string& getStringRef(const std::string& path) override;
+    virtual VectorStringRef getStringRefList(const std::string& path) override;
+
+    virtual const std::string& getStringRef(const ConfigPathPtr& path) override;
+    virtual VectorStringRef getStringRefList(const ConfigPathPtr& path) override;
+
+private:
+    SimpleConfigListPtr getSimpleList(const ConfigPathPtr& path);
+
+public:
+    virtual ConfigListView<bool> getBooleanListView(const std::string& path) override;
+    virtual ConfigListView<int32_t> getIntListView(const std::string& path) override;
+    virtual ConfigListView<int64_t> getInt64ListView(const std::string& path) override;
+    virtual ConfigListView<double> getDoubleListView(const std::string& path) override;
+    virtual void getBooleanList(const std::string& path, VectorBool& list) override;
+    virtual void getIntList(const std::string& path, VectorInt& list) override;
+    virtual void getInt64List(const std::string& path, VectorInt64& list) override;
+    virtual void getDoubleList(const std::string& path, VectorDouble& list) override;
+
+    virtual ConfigListView<bool> getBooleanListView(const ConfigPathPtr& path) override;
+    virtual ConfigListView<int32_t> getIntListView(const ConfigPathPtr& path) override;
+    virtual ConfigListView<int64_t> getInt64ListView(const ConfigPathPtr& path) override;
+    virtual ConfigListView<double> getDoubleListView(const ConfigPathPtr& path) override;
+    virtual void getBooleanList(const ConfigPathPtr& path, VectorBool& list) override;
+    virtual void getIntList(const ConfigPathPtr& path, VectorInt& list) override;
+    virtual void getInt64List(const ConfigPathPtr& path, VectorInt64& list) override;
+    virtual void getDoubleList(const ConfigPathPtr& path, VectorDouble& list) override;
+
+private:
+    static AbstractConfigValue* tryCheck(AbstractConfigValue* found,
+                                         ConfigValueType expected,
+                                         ConfigError& error,
+                                         AbstractConfigValuePtr& held);
+
+    /// As find(), but reports failure through error rather than by throwing.
+    AbstractConfigValue* tryFind(const PathPtr& path,
+                                 ConfigValueType expected,
+                                 ConfigError& error,
+                                 AbstractConfigValuePtr& held);
+
+    static ConfigResult<ConfigPathPtr> tryParsePath(const std::string& path);
+
+public:
+    virtual ConfigResult<bool> tryGetBoolean(const std::string& path) override;
+    virtual ConfigResult<int32_t> tryGetInt(const std::string& path) override;
+    virtual ConfigResult<int64_t> tryGetInt64(const std::string& path) override;
+    virtual ConfigResult<double> tryGetDouble(const std::string& path) override;
+    virtual ConfigResult<std::string> tryGetString(const std::string& path) override;
+    virtual ConfigResult<uint64_t> tryGetBytes(const std::string& path) override;
+    virtual ConfigResult<uint64_t> tryGetMilliseconds(const std::string& path) override;
+    virtual ConfigResult<uint64_t> tryGetNanoseconds(const std::string& path) override;
+
+    virtual ConfigResult<bool> tryGetBoolean(const ConfigPathPtr& path) override;
+    virtual ConfigResult<int32_t> tryGetInt(const ConfigPathPtr& path) override;
+    virtual ConfigResult<int64_t> tryGetInt64(const ConfigPathPtr& path) override;
+    virtual ConfigResult<double> tryGetDouble(const ConfigPathPtr& path) override;
+    virtual ConfigResult<std::string> tryGetString(const ConfigPathPtr& path) override;
+    virtual ConfigResult<uint64_t> tryGetBytes(const ConfigPathPtr& path) override;
+    virtual ConfigResult<uint64_t> tryGetMilliseconds(const ConfigPathPtr& path) override;
+    virtual ConfigResult<uint64_t> tryGetNanoseconds(const ConfigPathPtr& path) override;
+
     virtual ConfigValuePtr toFallbackValue() override;
     virtual ConfigMergeablePtr withFallback(const ConfigMergeablePtr& other) override;
 
@@ -141,6 +249,12 @@ public:
                                const ConfigOriginPtr& originForException,
                                const std::string& pathForException);
 
+private:
+    /// As the public parseDuration() and parseBytes(), but return false and
+    /// set problem rather than throwing if the string is invalid.
+    static bool parseDuration(const std::string& input, uint64_t& nanos, std::string& problem);
+    static bool parseBytes(const std::string& input, uint64_t& bytes, std::string& problem);
+
 private:
     virtual AbstractConfigValuePtr peekPath(const PathPtr& path);
 
@@ -182,6 +296,7 @@ private:
 
 public:
     virtual ConfigPtr withValue(const std::string& path, const ConfigValuePtr& value) override;
+    virtual ConfigPtr withValue(const ConfigPathPtr& path, const ConfigValuePtr& value) override;
 
     SimpleConfigPtr atKey(const ConfigOriginPtr& origin, const std::string& key);
 
@@ -191,6 +306,12 @@ public:
 
 private:
     AbstractConfigObjectPtr object;
+    ConfigMemoryResourcePtr arena_;
+
+    /// built once by indexPaths(); index is only read once indexed is set
+    std::once_flag indexOnce;
+    std::atomic<bool> indexed;
+    PathIndexPtr index;
 };
 
 class MemoryUnit {
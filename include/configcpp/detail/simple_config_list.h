@@ -8,6 +8,10 @@
 
 #include "configcpp/detail/abstract_config_value.h"
 #include "configcpp/config_list.h"
+#include "configcpp/config_list_view.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace config {
 
@@ -20,6 +24,7 @@ public:
     SimpleConfigList(const ConfigOriginPtr& origin,
                      const VectorAbstractConfigValue& value,
                      ResolveStatus status);
+    virtual ~SimpleConfigList();
 
     virtual ConfigValueType valueType() override;
     virtual ConfigVariant unwrapped() override;
@@ -74,9 +79,51 @@ public:
 
     SimpleConfigListPtr concatenate(const SimpleConfigListPtr& other);
 
+    /// Views of the elements as the list getters would convert them,
+    /// unboxed by the first view of each type and kept for the next. False if
+    /// some element doesn't convert (or, for ints, doesn't fit in 32 bits), or
+    /// if the list isn't resolved.
+    bool intView(ConfigListView<int32_t>& view);
+    bool int64View(ConfigListView<int64_t>& view);
+    bool doubleView(ConfigListView<double>& view);
+    bool booleanView(ConfigListView<bool>& view);
+
 private:
+    /// The elements unboxed as T; values stays null if one doesn't convert.
+    /// values is only read once done is set.
+    template <typename T>
+    struct Packing {
+        Packing() :
+            done(false),
+            values(nullptr) {
+        }
+
+        std::once_flag once;
+        std::atomic<bool> done;
+        T* values;
+    };
+
+    /// Allocated, with the arrays it holds, from the list's allocator.
+    struct Packed {
+        Packed(const VectorConfigValue::allocator_type& allocator, std::size_t size);
+        ~Packed();
+
+        VectorConfigValue::allocator_type allocator;
+        std::size_t size;
+        Packing<int32_t> ints;
+        Packing<int64_t> int64s;
+        Packing<double> doubles;
+        Packing<bool> booleans;
+    };
+
+    template <typename T>
+    bool packedView(Packing<T> Packed::* packing, ConfigListView<T>& view);
+
     VectorConfigValue value;
     bool resolved;
+
+    /// made by the first view of a non-empty resolved list
+    std::atomic<Packed*> packed;
 };
 
 class SimpleConfigListModifier : public virtual Modifier, public ConfigBase {
@@ -37,7 +37,8 @@ public:
     virtual ConfigObjectPtr withValue(const std::string& key, const ConfigValuePtr& value) override;
     virtual ConfigObjectPtr withValue(const PathPtr& path, const ConfigValuePtr& value) override;
 
-    virtual AbstractConfigValuePtr attemptPeekWithPartialResolve(const std::string& key) override;
+    virtual AbstractConfigValuePtr attemptPeekWithPartialResolve(const InternedString& key) override;
+    virtual AbstractConfigValue* peekBorrowed(const InternedString& key, AbstractConfigValuePtr& held) override;
 
 private:
     virtual AbstractConfigObjectPtr newCopy(ResolveStatus status,
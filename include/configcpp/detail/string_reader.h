@@ -6,26 +6,33 @@
 #ifndef STRING_READER_H_
 #define STRING_READER_H_
 
-#include "configcpp/detail/reader.h"
+#include "configcpp/detail/chunk_reader.h"
 #include "configcpp/detail/config_base.h"
 
 namespace config {
 
 ///
-/// A character stream whose source is a string.
+/// A character stream whose source is a string. The borrowing constructor
+/// reads straight out of the caller's buffer without copying it; the buffer
+/// must then outlive the reader.
 ///
-class StringReader : public virtual Reader, public ConfigBase {
+class StringReader : public virtual ChunkReader, public ConfigBase {
 public:
     CONFIG_CLASS(StringReader);
 
     StringReader(const std::string& str);
+    StringReader(const char* begin, const char* end);
 
     virtual int32_t read() override;
+    virtual bool readChunk(const char*& begin, const char*& end) override;
+    virtual void readRemaining(std::string& buffer, const char*& begin, const char*& end) override;
     virtual void close() override;
 
 private:
     std::string str;
-    uint32_t position;
+    const char* begin;
+    const char* end;
+    const char* position;
 };
 
 }
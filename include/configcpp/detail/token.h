@@ -23,9 +23,19 @@ public:
                                      const std::string& debugString);
 
     TokenType tokenType();
-    ConfigOriginPtr origin();
+    virtual ConfigOriginPtr origin();
 
-    int32_t lineNumber();
+    virtual int32_t lineNumber();
+
+    /// The tokenizer creates tokens from one shared origin per file and
+    /// records the line here; the per-line origin is only created when
+    /// origin() is asked for.
+    virtual void setOriginLine(int32_t lineNumber);
+
+    /// The origin without the deferred line, and the deferred line (or -1);
+    /// lets the parser pass the line on to values without creating an origin.
+    ConfigOriginPtr baseOrigin();
+    int32_t originLine();
 
     virtual std::string toString() override;
 
@@ -40,6 +50,7 @@ private:
     TokenType tokenType_;
     std::string debugString_;
     ConfigOriginPtr origin_;
+    int32_t originLine_;
 };
 
 }
@@ -7,6 +7,7 @@
 #define TOKENIZER_H_
 
 #include "configcpp/detail/config_base.h"
+#include "configcpp/detail/lexeme.h"
 #include "configcpp/config_exception.h"
 
 namespace config {
@@ -23,6 +24,14 @@ public:
     static TokenIteratorPtr tokenize(const ConfigOriginPtr& origin,
                                      const ReaderPtr& input,
                                      ConfigSyntax flavor);
+
+    /// As above, but with less than full origin detail comments are skipped
+    /// rather than returned as tokens, and with only file detail value tokens
+    /// don't record their line.
+    static TokenIteratorPtr tokenize(const ConfigOriginPtr& origin,
+                                     const ReaderPtr& input,
+                                     ConfigSyntax flavor,
+                                     ConfigOriginDetail originDetail);
 };
 
 class WhitespaceSaver : public ConfigBase {
@@ -32,9 +41,11 @@ public:
     WhitespaceSaver();
 
     void add(int32_t c);
-    TokenPtr check(const TokenPtr& t,
-                   const ConfigOriginPtr& baseOrigin,
-                   int32_t lineNumber);
+    void add(const char* begin, const char* end);
+
+    /// Called with each token; returns true and makes whitespace the
+    /// whitespace token to go in front of it, if there should be one.
+    bool check(const Lexeme& t, Lexeme& whitespace, int32_t lineNumber);
 
 private:
     /// Called if the next token is not a simple value;
@@ -45,12 +56,11 @@ private:
     /// Called if the next token IS a simple value,
     /// so creates a whitespace token if the previous
     /// token also was.
-    TokenPtr nextIsASimpleValue(const ConfigOriginPtr& baseOrigin,
-                                int32_t lineNumber);
+    bool nextIsASimpleValue(Lexeme& whitespace, int32_t lineNumber);
 
 private:
     // has to be saved inside value concatenations
-    std::ostringstream whitespace;
+    std::string whitespace;
     // may need to value-concat with next value
     bool lastTokenWasSimpleValue;
 };
@@ -64,6 +74,11 @@ public:
     virtual bool hasNext();
     virtual TokenPtr next();
 
+    /// The next token as a Lexeme; this is what the parser reads, and
+    /// TokenStream overrides it to lex straight into the lexeme without
+    /// creating a Token.
+    virtual void nextLexeme(Lexeme& lexeme);
+
 private:
     VectorToken::const_iterator begin;
     VectorToken::const_iterator end;
@@ -75,12 +90,20 @@ public:
 
     TokenStream(const ConfigOriginPtr& origin,
                 const ReaderPtr& input,
-                bool allowComments);
+                bool allowComments,
+                ConfigOriginDetail originDetail);
 
 private:
     int32_t nextCharRaw();
     void putBack(int32_t c);
 
+    /// Move on to the next chunk of input; returns false at end of input.
+    bool nextChunk();
+
+    /// True if characters can be scanned straight out of the current chunk,
+    /// i.e. nothing has been put back and the chunk isn't exhausted.
+    bool haveChunk();
+
 public:
     static bool isWhitespace(int32_t c);
     static bool isWhitespaceNotNewline(int32_t c);
@@ -88,8 +111,12 @@ public:
 private:
     bool startOfComment(int32_t c);
 
+    /// True if the char at p (inside the current chunk) continues a run of
+    /// unquoted text without needing look-ahead past the chunk.
+    bool continuesUnquotedText(const char* p);
+
     /// Get next char, skipping non-newline whitespace
-    int32_t nextCharAfterWhitespace(const WhitespaceSaverPtr& saver);
+    int32_t nextCharAfterWhitespace(WhitespaceSaver& saver);
 
     ConfigExceptionTokenizerProblem problem(const std::string& message);
     ConfigExceptionTokenizerProblem problem(const std::string& what,
@@ -106,55 +133,84 @@ private:
 public:
     static ConfigOriginPtr lineOrigin(const ConfigOriginPtr& baseOrigin, int32_t lineNumber);
 
+    /// Tokens are created from the shared file origin and only remember
+    /// their line; see Token::setOriginLine()
+    static TokenPtr atLine(const TokenPtr& token, int32_t lineNumber);
+
 private:
+    // character classes, one bit each in charClasses
+    static const uint8_t WHITESPACE = 0x01;
+    static const uint8_t WHITESPACE_NOT_NEWLINE = 0x02;
+    // chars that stop an unquoted string
+    static const uint8_t NOT_IN_UNQUOTED_TEXT = 0x04;
+    // chars JSON allows to be part of a number
+    static const uint8_t NUMBER = 0x08;
     // chars JSON allows a number to start with
-    static const std::string firstNumberChars;
+    static const uint8_t FIRST_NUMBER = 0x10;
+    static const uint8_t CONTROL = 0x20;
 
-    // chars JSON allows to be part of a number
-    static const std::string numberChars;
+    /// Classes of each byte, in the "C" locale; indexed by unsigned char.
+    static const uint8_t charClasses[256];
 
-    // chars that stop an unquoted string
-    static const std::string notInUnquotedText;
+    /// True if c (a char or -1 for end of input) is in any of the classes.
+    static bool isCharClass(int32_t c, uint8_t classes);
+
+    /// The line to record on value tokens; -1 if values only keep the file.
+    int32_t valueLine();
 
     /// ONE char has always been consumed, either the # or the first /, but
-    /// not both slashes
-    TokenPtr pullComment(int32_t firstChar);
+    /// not both slashes. Returns false if comments are being skipped.
+    bool pullComment(int32_t firstChar, Lexeme& lexeme);
 
-    TokenPtr pullUnquotedText();
+    void pullUnquotedText(Lexeme& lexeme);
 
-    TokenPtr pullNumber(int32_t firstChar);
+    void pullNumber(int32_t firstChar, Lexeme& lexeme);
 
     void pullEscapeSequence(std::string& s);
 
     void appendTripleQuotedString(std::string& s);
 
-    TokenPtr pullQuotedString();
+    void pullQuotedString(Lexeme& lexeme);
 
-    TokenPtr pullPlusEquals();
+    void pullPlusEquals(Lexeme& lexeme);
 
-    TokenPtr pullSubstitution();
+    void pullSubstitution(Lexeme& lexeme);
 
-    TokenPtr pullNextToken(const WhitespaceSaverPtr& saver);
+    void pullNextLexeme(WhitespaceSaver& saver, Lexeme& lexeme);
 
 public:
-    static bool isSimpleValue(const TokenPtr& t);
+    static bool isSimpleValue(const Lexeme& t);
 
-private:
-    void queueNextToken();
-
-public:
     virtual bool hasNext() override;
     virtual TokenPtr next() override;
+    virtual void nextLexeme(Lexeme& lexeme) override;
 
 private:
+    static const uint32_t MAX_PUT_BACK = 3;
+
     SimpleConfigOriginPtr origin_;
-    ReaderPtr input;
+    ChunkReaderPtr input;
     bool allowComments;
+    // whether comments become tokens and values record their line
+    bool keepComments;
+    bool keepValueLines;
     int32_t lineNumber;
-    ConfigOriginPtr lineOrigin_;
-    QueueToken tokens;
-    QueueInt buffer;
-    WhitespaceSaverPtr whitespaceSaver;
+    // whether START, and END, have been handed out
+    bool started;
+    bool ended;
+    // a token pulled along with the whitespace in front of it, to hand
+    // out after the whitespace
+    Lexeme pending;
+    bool havePending;
+    // what next() lexes into before making a token
+    Lexeme current;
+    // the unread part of the current chunk of input
+    const char* cursor;
+    const char* limit;
+    // characters put back, most recent last
+    int32_t buffer[MAX_PUT_BACK];
+    uint32_t bufferSize;
+    WhitespaceSaver whitespaceSaver;
 };
 
 }
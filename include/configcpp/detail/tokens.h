@@ -23,9 +23,9 @@ public:
     static std::string getProblemMessage(const TokenPtr& token);
     static bool getProblemSuggestQuotes(const TokenPtr& token);
     static bool isComment(const TokenPtr& token);
-    static std::string getCommentText(const TokenPtr& token);
+    static const std::string& getCommentText(const TokenPtr& token);
     static bool isUnquotedText(const TokenPtr& token);
-    static std::string getUnquotedText(const TokenPtr& token);
+    static const std::string& getUnquotedText(const TokenPtr& token);
     static bool isSubstitution(const TokenPtr& token);
     static VectorToken getSubstitutionPathExpression(const TokenPtr& token);
     static bool getSubstitutionOptional(const TokenPtr& token);
@@ -78,6 +78,11 @@ public:
 
     AbstractConfigValuePtr value();
 
+    /// The origin lives on the value, so the line is deferred there too.
+    virtual ConfigOriginPtr origin() override;
+    virtual int32_t lineNumber() override;
+    virtual void setOriginLine(int32_t lineNumber) override;
+
     virtual std::string toString() override;
 
 protected:
@@ -116,7 +121,7 @@ public:
 
     UnquotedTextToken(const ConfigOriginPtr& origin, const std::string& s);
 
-    std::string value();
+    const std::string& value();
 
     virtual std::string toString() override;
 
@@ -165,7 +170,7 @@ public:
 
     CommentToken(const ConfigOriginPtr& origin, const std::string& text);
 
-    std::string text();
+    const std::string& text();
 
     virtual std::string toString() override;
 
@@ -0,0 +1,28 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef VALUE_IMPLEMENTATION_H_
+#define VALUE_IMPLEMENTATION_H_
+
+#include "configcpp/config_types.h"
+
+namespace config {
+
+///
+/// Internal to the library: reaches the AbstractConfigValue behind a
+/// ConfigValue without a dynamic_cast across its virtual bases. ConfigValue
+/// inherits this privately, so it isn't part of the public interface; the
+/// library goes through AbstractConfigValue::cast() and borrow().
+///
+class ValueImplementation {
+private:
+    friend class AbstractConfigValue;
+
+    virtual AbstractConfigValue* implementation() = 0;
+};
+
+}
+
+#endif // VALUE_IMPLEMENTATION_H_
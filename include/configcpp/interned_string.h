@@ -0,0 +1,245 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef INTERNED_STRING_H_
+#define INTERNED_STRING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <utility>
+
+#include "configcpp/config_memory_resource.h"
+#include "configcpp/small_map.h"
+
+namespace config {
+
+///
+/// A handle to a string held once in a process-wide table, however many
+/// handles refer to it. Config string values are interned, since large
+/// configs repeat the same few (hosts, regions, protocols, ...) thousands of
+/// times.
+/// <p>
+/// Equal strings share one table entry, so handles compare by pointer, and
+/// they hash as std::hash<std::string> would from a hash kept with the entry.
+/// A handle is the size of a pointer; the entry is freed when the last handle
+/// to it goes. Handles convert implicitly from and to
+/// {@code std::string}. Constructing one from a string takes the lock of one
+/// of several shards of the table, so code that compares the same string
+/// repeatedly should keep the handle.
+/// <p>
+/// A string made with a ConfigMemoryResource isn't pooled: its entry comes
+/// from the resource and belongs to that handle and its copies alone, and it
+/// compares with other handles by content.
+///
+class InternedString {
+public:
+    /// The empty string; needs no table entry.
+    InternedString();
+
+    InternedString(const std::string& s);
+    InternedString(const char* s);
+
+    /// Intern s, or if there's a resource, give it an entry of its own
+    /// allocated from the resource.
+    InternedString(const std::string& s, const ConfigMemoryResourcePtr& resource);
+
+    InternedString(const InternedString& other);
+    ~InternedString();
+
+    InternedString& operator=(const InternedString& other);
+
+    const std::string& str() const {
+        return entry ? entry->first : emptyString();
+    }
+
+    operator const std::string&() const {
+        return str();
+    }
+
+    bool empty() const {
+        return entry == nullptr;
+    }
+
+    std::size_t length() const {
+        return str().length();
+    }
+
+    const char* c_str() const {
+        return str().c_str();
+    }
+
+    bool operator==(const InternedString& other) const {
+        return entry == other.entry || (!(pooled() && other.pooled()) && str() == other.str());
+    }
+
+    bool operator!=(const InternedString& other) const {
+        return !(*this == other);
+    }
+
+    /// Orders by content, as std::string does.
+    bool operator<(const InternedString& other) const {
+        return entry != other.entry && str() < other.str();
+    }
+
+    std::size_t hashCode() const {
+        return entry ? entry->second.hash : emptyHash();
+    }
+
+    /// @return number of distinct strings currently interned
+    static uint32_t tableSize();
+
+private:
+    friend struct InternTable;
+
+    struct Counted {
+        Counted() :
+            hash(0),
+            refs(0),
+            pooled(true) {
+        }
+
+        std::size_t hash;
+        mutable std::atomic<uint32_t> refs;
+        bool pooled;
+    };
+
+    typedef std::pair<const std::string, Counted> Entry;
+
+    /// An entry outside the table, allocated from resource.
+    struct Unpooled : Entry {
+        Unpooled(const std::string& s, const ConfigMemoryResourcePtr& resource);
+
+        ConfigMemoryResourcePtr resource;
+    };
+
+    bool pooled() const {
+        return !entry || entry->second.pooled;
+    }
+
+    /// point at the table's entry for s, adding one if there's none
+    void intern(const std::string& s);
+    void release();
+
+    static const std::string& emptyString();
+    static std::size_t emptyHash();
+
+    const Entry* entry;
+};
+
+inline bool operator==(const InternedString& a, const std::string& b) {
+    return a.str() == b;
+}
+
+inline bool operator==(const std::string& a, const InternedString& b) {
+    return a == b.str();
+}
+
+inline bool operator==(const InternedString& a, const char* b) {
+    return a.str() == b;
+}
+
+inline bool operator!=(const InternedString& a, const std::string& b) {
+    return a.str() != b;
+}
+
+inline bool operator!=(const std::string& a, const InternedString& b) {
+    return a != b.str();
+}
+
+inline bool operator!=(const InternedString& a, const char* b) {
+    return a.str() != b;
+}
+
+inline std::string operator+(const std::string& a, const InternedString& b) {
+    return a + b.str();
+}
+
+inline std::string operator+(const InternedString& a, const std::string& b) {
+    return a.str() + b;
+}
+
+inline std::string operator+(const char* a, const InternedString& b) {
+    return a + b.str();
+}
+
+inline std::string operator+(const InternedString& a, const char* b) {
+    return a.str() + b;
+}
+
+std::ostream& operator<<(std::ostream& out, const InternedString& s);
+
+///
+/// A SmallMap entry keyed by an InternedString. It reads as a
+/// std::pair<const std::string, V> would, with first referring to the key's
+/// string, so code iterating a map needn't know its keys are interned; code
+/// that does know can look up other maps by the key itself.
+///
+template <typename V>
+struct InternedEntry {
+    InternedEntry(const InternedString& key, const V& value) :
+        key(key),
+        first(this->key.str()),
+        second(value) {
+    }
+
+    template <typename S, typename W>
+    InternedEntry(const std::pair<S, W>& entry) :
+        key(entry.first),
+        first(key.str()),
+        second(entry.second) {
+    }
+
+    InternedEntry(const InternedEntry& other) :
+        key(other.key),
+        first(key.str()),
+        second(other.second) {
+    }
+
+    InternedEntry(InternedEntry&& other) noexcept :
+        key(other.key),
+        first(key.str()),
+        second(std::move(other.second)) {
+    }
+
+    /// Copies out as a pair, for code that collects entries.
+    template <typename S, typename W>
+    operator std::pair<S, W>() const {
+        return std::pair<S, W>(first, second);
+    }
+
+    const InternedString key;
+    const std::string& first;
+    V second;
+};
+
+/// Maps keyed by InternedString are looked up by std::string, or by pointer
+/// with an InternedString.
+template <typename V>
+struct SmallMapEntry<InternedString, V> {
+    typedef InternedEntry<V> type;
+    typedef std::string key_type;
+
+    static const InternedString& key(const type& entry) {
+        return entry.key;
+    }
+};
+
+}
+
+namespace std {
+
+template <>
+struct hash<config::InternedString> {
+    std::size_t operator()(const config::InternedString& s) const {
+        return s.hashCode();
+    }
+};
+
+}
+
+#endif // INTERNED_STRING_H_
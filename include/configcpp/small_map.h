@@ -0,0 +1,414 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef SMALL_MAP_H_
+#define SMALL_MAP_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace config {
+
+///
+/// How a SmallMap stores an entry of key K and value V: the entry type, the
+/// key type lookups take, and how to get the stored key from an entry. By
+/// default an entry is a std::pair<const K, V>; a key type that is cheaper
+/// to compare than to make (like InternedString) can specialize this to keep
+/// its own key in the entry while lookups take a plainer key_type.
+///
+template <typename K, typename V>
+struct SmallMapEntry {
+    typedef std::pair<const K, V> type;
+    typedef K key_type;
+
+    static const K& key(const type& entry) {
+        return entry.first;
+    }
+};
+
+///
+/// A map with the std::unordered_map interface that keeps its entries in a
+/// vector. Up to Limit entries are searched linearly; beyond that an open
+/// addressing index of entry positions is added. Most config objects have a
+/// handful of keys, and for those a vector is both smaller and quicker to
+/// search than a hash table; larger ones still don't need a node per entry.
+///
+/// Iteration goes newest entry first, the order std::unordered_map gives most
+/// small maps, so code that depends on the order (like the resolution of some
+/// cycles) behaves as it always has. Inserting or erasing invalidates
+/// iterators. Entries can't be modified through iterators; use operator[] or
+/// insert().
+/// <p>
+/// The entries and the index both allocate from Alloc, so the two move and
+/// swap together.
+///
+template <typename K, typename V, uint32_t Limit = 8, typename Alloc = std::allocator<typename SmallMapEntry<K, V>::type>>
+class SmallMap {
+public:
+    typedef typename SmallMapEntry<K, V>::key_type key_type;
+    typedef V mapped_type;
+    typedef typename SmallMapEntry<K, V>::type value_type;
+    typedef std::size_t size_type;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<value_type> allocator_type;
+
+private:
+    typedef SmallMapEntry<K, V> Entry;
+    typedef std::vector<value_type, allocator_type> Vector;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<uint32_t> IndexAllocator;
+
+    /// Enables the overloads that take a stored key, when that differs from
+    /// key_type.
+    template <typename Key>
+    using IfStoredKey = typename std::enable_if<std::is_same<Key, K>::value && !std::is_same<K, key_type>::value>::type;
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+public:
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename SmallMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef const value_type& reference;
+
+        const_iterator() :
+            entry(nullptr) {
+        }
+
+        /// entry is one past the element, which is reached by decrementing
+        const_iterator(const value_type* entry) :
+            entry(entry) {
+        }
+
+        reference operator*() const {
+            return *(entry - 1);
+        }
+
+        pointer operator->() const {
+            return entry - 1;
+        }
+
+        const_iterator& operator++() {
+            --entry;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous(*this);
+            --entry;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return entry == other.entry;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return entry != other.entry;
+        }
+
+    private:
+        const value_type* entry;
+    };
+
+    typedef const_iterator iterator;
+
+    SmallMap() :
+        index(nullptr) {
+    }
+
+    explicit SmallMap(const Alloc& alloc) :
+        entries(allocator_type(alloc)),
+        index(nullptr) {
+    }
+
+    template <typename InputIterator>
+    SmallMap(InputIterator first, InputIterator last) :
+        index(nullptr) {
+        reserve(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+        insert(first, last);
+    }
+
+    SmallMap(std::initializer_list<value_type> values) :
+        index(nullptr) {
+        entries.reserve(values.size());
+        insert(values.begin(), values.end());
+    }
+
+    SmallMap(const SmallMap& other) :
+        entries(other.entries),
+        index(other.index ? copyIndex(other.index) : nullptr) {
+    }
+
+    SmallMap(SmallMap&& other) noexcept :
+        entries(std::move(other.entries)),
+        index(other.index) {
+        other.index = nullptr;
+    }
+
+    ~SmallMap() {
+        destroyIndex();
+    }
+
+    SmallMap& operator=(const SmallMap& other) {
+        if (this != &other) {
+            Vector copied(other.entries.begin(), other.entries.end(), entries.get_allocator());
+            uint32_t* copiedIndex = other.index ? copyIndex(other.index) : nullptr;
+            destroyIndex();
+            entries.swap(copied);
+            index = copiedIndex;
+        }
+        return *this;
+    }
+
+    SmallMap& operator=(SmallMap&& other) noexcept {
+        if (this != &other) {
+            destroyIndex();
+            entries = std::move(other.entries);
+            index = other.index;
+            other.index = nullptr;
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const {
+        return entries.get_allocator();
+    }
+
+    const_iterator begin() const {
+        return const_iterator(entries.data() + entries.size());
+    }
+
+    const_iterator end() const {
+        return const_iterator(entries.data());
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    bool empty() const {
+        return entries.empty();
+    }
+
+    size_type size() const {
+        return entries.size();
+    }
+
+    const_iterator find(const key_type& key) const {
+        return at(position(key));
+    }
+
+    /// Find by a stored key, which may compare quicker than a key_type.
+    template <typename Key, typename = IfStoredKey<Key>>
+    const_iterator find(const Key& key) const {
+        return at(position(key));
+    }
+
+    size_type count(const key_type& key) const {
+        return position(key) == npos ? 0 : 1;
+    }
+
+    template <typename Key, typename = IfStoredKey<Key>>
+    size_type count(const Key& key) const {
+        return position(key) == npos ? 0 : 1;
+    }
+
+    V& operator[](const key_type& key) {
+        return subscript(key);
+    }
+
+    template <typename Key, typename = IfStoredKey<Key>>
+    V& operator[](const Key& key) {
+        return subscript(key);
+    }
+
+    std::pair<const_iterator, bool> insert(const value_type& value) {
+        size_type existing = position(Entry::key(value));
+        if (existing != npos) {
+            return std::make_pair(at(existing), false);
+        }
+        append(value);
+        return std::make_pair(begin(), true);
+    }
+
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            insert(value_type(first->first, first->second));
+        }
+    }
+
+    size_type erase(const key_type& key) {
+        return eraseAt(position(key));
+    }
+
+    template <typename Key, typename = IfStoredKey<Key>>
+    size_type erase(const Key& key) {
+        return eraseAt(position(key));
+    }
+
+    void erase(const const_iterator& position) {
+        eraseAt(&*position - entries.data());
+    }
+
+    void clear() {
+        Vector(entries.get_allocator()).swap(entries);
+        destroyIndex();
+    }
+
+private:
+    template <typename InputIterator>
+    void reserve(InputIterator first, InputIterator last, std::forward_iterator_tag) {
+        auto count = std::distance(first, last);
+        if (count > 0) {
+            entries.reserve(count);
+        }
+    }
+
+    template <typename InputIterator>
+    void reserve(InputIterator, InputIterator, std::input_iterator_tag) {
+    }
+
+    const_iterator at(size_type found) const {
+        return found == npos ? end() : const_iterator(entries.data() + found + 1);
+    }
+
+    /// @return where the entry for key is, or npos
+    template <typename Key>
+    size_type position(const Key& key) const {
+        if (index) {
+            uint32_t mask = index[0];
+            for (std::size_t slot = std::hash<Key>()(key) & mask; ; slot = (slot + 1) & mask) {
+                uint32_t found = index[slot + 1];
+                if (found == 0) {
+                    return npos;
+                }
+                if (Entry::key(entries[found - 1]) == key) {
+                    return found - 1;
+                }
+            }
+        }
+        for (size_type i = 0; i < entries.size(); ++i) {
+            if (Entry::key(entries[i]) == key) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    template <typename Key>
+    V& subscript(const Key& key) {
+        size_type found = position(key);
+        if (found != npos) {
+            return entries[found].second;
+        }
+        append(value_type(key, V()));
+        return entries.back().second;
+    }
+
+    void append(const value_type& value) {
+        entries.push_back(value);
+        if (index) {
+            // keep the table no more than half full, so probes are short
+            if (entries.size() * 2 > static_cast<size_type>(index[0]) + 1) {
+                rebuildIndex();
+            }
+            else {
+                addToIndex(entries.size() - 1);
+            }
+        }
+        else if (entries.size() > Limit) {
+            // too big to search linearly
+            rebuildIndex();
+        }
+    }
+
+    size_type eraseAt(size_type found) {
+        if (found == npos) {
+            return 0;
+        }
+        // the keys are const, so the entries can't be shuffled down
+        Vector kept(entries.get_allocator());
+        kept.reserve(entries.size() - 1);
+        for (size_type i = 0; i < entries.size(); ++i) {
+            if (i != found) {
+                kept.push_back(entries[i]);
+            }
+        }
+        entries.swap(kept);
+        destroyIndex();
+        if (entries.size() > Limit) {
+            rebuildIndex();
+        }
+        return 1;
+    }
+
+    /// The index is a table of a power of two slots, each holding the
+    /// position of an entry plus one, or zero when empty; it is preceded by
+    /// the mask for the table size.
+    void rebuildIndex() {
+        uint32_t slots = 16;
+        while (slots < entries.size() * 2) {
+            slots *= 2;
+        }
+        uint32_t* made = allocateIndex(slots);
+        destroyIndex();
+        index = made;
+        for (size_type i = 0; i < entries.size(); ++i) {
+            addToIndex(i);
+        }
+    }
+
+    void addToIndex(size_type added) {
+        uint32_t mask = index[0];
+        std::size_t slot = std::hash<K>()(Entry::key(entries[added])) & mask;
+        while (index[slot + 1] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        index[slot + 1] = static_cast<uint32_t>(added + 1);
+    }
+
+    uint32_t* allocateIndex(uint32_t slots) const {
+        IndexAllocator alloc(entries.get_allocator());
+        uint32_t* made = std::allocator_traits<IndexAllocator>::allocate(alloc, slots + 1);
+        std::fill(made, made + slots + 1, 0);
+        made[0] = slots - 1;
+        return made;
+    }
+
+    uint32_t* copyIndex(const uint32_t* other) const {
+        uint32_t* made = allocateIndex(other[0] + 1);
+        std::copy(other, other + other[0] + 2, made);
+        return made;
+    }
+
+    void destroyIndex() {
+        if (index) {
+            IndexAllocator alloc(entries.get_allocator());
+            std::allocator_traits<IndexAllocator>::deallocate(alloc, index, index[0] + 2);
+            index = nullptr;
+        }
+    }
+
+    Vector entries;
+    uint32_t* index;
+};
+
+}
+
+#endif // SMALL_MAP_H_
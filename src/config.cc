@@ -5,6 +5,7 @@
 
 #include "configcpp/detail/config_impl.h"
 #include "configcpp/detail/parseable.h"
+#include "configcpp/detail/config_arena.h"
 #include "configcpp/detail/abstract_config_object.h"
 #include "configcpp/config.h"
 #include "configcpp/config_object.h"
@@ -38,6 +39,8 @@ ConfigPtr Config::emptyConfig(const std::string& originDescription) {
 
 ConfigPtr Config::parseReader(const ReaderPtr& reader, const ConfigParseOptionsPtr& options) {
     if (options) {
+        // the Config is made inside the scope, so it owns any arena
+        ConfigMemoryScope memory(ConfigArena::forOptions(options->getUseArena(), options->getMemoryResource()));
         return Parseable::newReader(reader, options)->parse()->toConfig();
     }
     else {
@@ -47,6 +50,7 @@ ConfigPtr Config::parseReader(const ReaderPtr& reader, const ConfigParseOptionsP
 
 ConfigPtr Config::parseFile(const std::string& file, const ConfigParseOptionsPtr& options) {
     if (options) {
+        ConfigMemoryScope memory(ConfigArena::forOptions(options->getUseArena(), options->getMemoryResource()));
         return Parseable::newFile(file, options)->parse()->toConfig();
     }
     else {
@@ -56,6 +60,7 @@ ConfigPtr Config::parseFile(const std::string& file, const ConfigParseOptionsPtr
 
 ConfigPtr Config::parseFileAnySyntax(const std::string& fileBasename, const ConfigParseOptionsPtr& options) {
     if (options) {
+        ConfigMemoryScope memory(ConfigArena::forOptions(options->getUseArena(), options->getMemoryResource()));
         return ConfigImpl::parseFileAnySyntax(fileBasename, options)->toConfig();
     }
     else {
@@ -65,6 +70,7 @@ ConfigPtr Config::parseFileAnySyntax(const std::string& fileBasename, const Conf
 
 ConfigPtr Config::parseString(const std::string& s, const ConfigParseOptionsPtr& options) {
     if (options) {
+        ConfigMemoryScope memory(ConfigArena::forOptions(options->getUseArena(), options->getMemoryResource()));
         return Parseable::newString(s, options)->parse()->toConfig();
     }
     else {
@@ -0,0 +1,47 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/config_memory_resource.h"
+#include "configcpp/detail/config_allocator.h"
+
+namespace config {
+
+static const ConfigMemoryResourcePtr noResource;
+
+/// the resource of the innermost scope on this thread
+static thread_local const ConfigMemoryResourcePtr* currentResource = &noResource;
+
+ConfigMemoryResource::~ConfigMemoryResource() {
+}
+
+ConfigMemoryScope::ConfigMemoryScope(const ConfigMemoryResourcePtr& resource) :
+    resource(resource),
+    previous(nullptr) {
+    if (resource) {
+        previous = currentResource;
+        currentResource = &this->resource;
+    }
+}
+
+ConfigMemoryScope::~ConfigMemoryScope() {
+    if (previous) {
+        currentResource = previous;
+    }
+}
+
+const ConfigMemoryResourcePtr& ConfigMemoryScope::current() {
+    return *currentResource;
+}
+
+ConfigHeapScope::ConfigHeapScope() :
+    previous(currentResource) {
+    currentResource = &noResource;
+}
+
+ConfigHeapScope::~ConfigHeapScope() {
+    currentResource = previous;
+}
+
+}
@@ -5,6 +5,7 @@
 
 #include "configcpp/config_parse_options.h"
 #include "configcpp/config_syntax.h"
+#include "configcpp/config_origin_detail.h"
 #include "configcpp/config_includer.h"
 
 namespace config {
@@ -12,15 +13,21 @@ namespace config {
 ConfigParseOptions::ConfigParseOptions(ConfigSyntax syntax,
                                        const std::string& originDescription,
                                        bool allowMissing,
-                                       const ConfigIncluderPtr& includer) :
+                                       const ConfigIncluderPtr& includer,
+                                       ConfigOriginDetail originDetail,
+                                       bool useArena,
+                                       const ConfigMemoryResourcePtr& memoryResource) :
     syntax(syntax),
     originDescription(originDescription),
     allowMissing(allowMissing),
-    includer(includer) {
+    includer(includer),
+    originDetail(originDetail),
+    useArena(useArena),
+    memoryResource(memoryResource) {
 }
 
 ConfigParseOptionsPtr ConfigParseOptions::defaults() {
-    return make_instance(ConfigSyntax::NONE, "", true, nullptr);
+    return make_instance(ConfigSyntax::NONE, "", true, nullptr, ConfigOriginDetail::FULL, false, nullptr);
 }
 
 ConfigParseOptionsPtr ConfigParseOptions::setSyntax(ConfigSyntax syntax) {
@@ -28,7 +35,7 @@ ConfigParseOptionsPtr ConfigParseOptions::setSyntax(ConfigSyntax syntax) {
         return shared_from_this();
     }
     else {
-        return make_instance(syntax, originDescription, this->allowMissing, this->includer);
+        return make_instance(syntax, originDescription, this->allowMissing, this->includer, this->originDetail, this->useArena, this->memoryResource);
     }
 }
 
@@ -41,7 +48,7 @@ ConfigParseOptionsPtr ConfigParseOptions::setOriginDescription(const std::string
         return shared_from_this();
     }
     else {
-        return make_instance(this->syntax, originDescription, this->allowMissing, this->includer);
+        return make_instance(this->syntax, originDescription, this->allowMissing, this->includer, this->originDetail, this->useArena, this->memoryResource);
     }
 }
 
@@ -63,7 +70,7 @@ ConfigParseOptionsPtr ConfigParseOptions::setAllowMissing(bool allowMissing) {
         return shared_from_this();
     }
     else {
-        return make_instance(this->syntax, this->originDescription, allowMissing, this->includer);
+        return make_instance(this->syntax, this->originDescription, allowMissing, this->includer, this->originDetail, this->useArena, this->memoryResource);
     }
 }
 
@@ -76,7 +83,7 @@ ConfigParseOptionsPtr ConfigParseOptions::setIncluder(const ConfigIncluderPtr& i
         return shared_from_this();
     }
     else {
-        return make_instance(this->syntax, this->originDescription, this->allowMissing, includer);
+        return make_instance(this->syntax, this->originDescription, this->allowMissing, includer, this->originDetail, this->useArena, this->memoryResource);
     }
 }
 
@@ -108,4 +115,43 @@ ConfigIncluderPtr ConfigParseOptions::getIncluder() {
     return includer;
 }
 
+ConfigParseOptionsPtr ConfigParseOptions::setOriginDetail(ConfigOriginDetail originDetail) {
+    if (this->originDetail == originDetail) {
+        return shared_from_this();
+    }
+    else {
+        return make_instance(this->syntax, this->originDescription, this->allowMissing, this->includer, originDetail, this->useArena, this->memoryResource);
+    }
+}
+
+ConfigOriginDetail ConfigParseOptions::getOriginDetail() {
+    return originDetail;
+}
+
+ConfigParseOptionsPtr ConfigParseOptions::setUseArena(bool useArena) {
+    if (this->useArena == useArena) {
+        return shared_from_this();
+    }
+    else {
+        return make_instance(this->syntax, this->originDescription, this->allowMissing, this->includer, this->originDetail, useArena, this->memoryResource);
+    }
+}
+
+bool ConfigParseOptions::getUseArena() {
+    return useArena;
+}
+
+ConfigParseOptionsPtr ConfigParseOptions::setMemoryResource(const ConfigMemoryResourcePtr& memoryResource) {
+    if (this->memoryResource == memoryResource) {
+        return shared_from_this();
+    }
+    else {
+        return make_instance(this->syntax, this->originDescription, this->allowMissing, this->includer, this->originDetail, this->useArena, memoryResource);
+    }
+}
+
+ConfigMemoryResourcePtr ConfigParseOptions::getMemoryResource() {
+    return memoryResource;
+}
+
 }
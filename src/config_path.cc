@@ -0,0 +1,34 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/config_path.h"
+#include "configcpp/detail/path.h"
+#include "configcpp/detail/path_cache.h"
+#include "configcpp/detail/parser.h"
+
+namespace config {
+
+ConfigPath::ConfigPath(const std::string& expression) :
+    expression_(expression),
+    path_(Parser::parsePath(expression)) {
+}
+
+ConfigPathPtr ConfigPath::parse(const std::string& expression) {
+    return PathCache::get(expression);
+}
+
+const std::string& ConfigPath::expression() {
+    return expression_;
+}
+
+const PathPtr& ConfigPath::path() {
+    return path_;
+}
+
+std::string ConfigPath::toString() {
+    return "ConfigPath(" + path_->render() + ")";
+}
+
+}
@@ -7,8 +7,10 @@
 
 namespace config {
 
-ConfigResolveOptions::ConfigResolveOptions(bool useSystemEnvironment) :
-    useSystemEnvironment(useSystemEnvironment) {
+ConfigResolveOptions::ConfigResolveOptions(bool useSystemEnvironment, bool useArena, const ConfigMemoryResourcePtr& memoryResource) :
+    useSystemEnvironment(useSystemEnvironment),
+    useArena(useArena),
+    memoryResource(memoryResource) {
 }
 
 ConfigResolveOptionsPtr ConfigResolveOptions::defaults() {
@@ -20,11 +22,27 @@ ConfigResolveOptionsPtr ConfigResolveOptions::noSystem() {
 }
 
 ConfigResolveOptionsPtr ConfigResolveOptions::setUseSystemEnvironment(bool value) {
-    return make_instance(value);
+    return make_instance(value, useArena, memoryResource);
 }
 
 bool ConfigResolveOptions::getUseSystemEnvironment() {
     return useSystemEnvironment;
 }
 
+ConfigResolveOptionsPtr ConfigResolveOptions::setUseArena(bool value) {
+    return make_instance(useSystemEnvironment, value, memoryResource);
+}
+
+bool ConfigResolveOptions::getUseArena() {
+    return useArena;
+}
+
+ConfigResolveOptionsPtr ConfigResolveOptions::setMemoryResource(const ConfigMemoryResourcePtr& memoryResource) {
+    return make_instance(useSystemEnvironment, useArena, memoryResource);
+}
+
+ConfigMemoryResourcePtr ConfigResolveOptions::getMemoryResource() {
+    return memoryResource;
+}
+
 }
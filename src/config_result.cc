@@ -0,0 +1,24 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/config_result.h"
+
+namespace config {
+
+std::string ConfigErrorEnum::name(ConfigError error) {
+    typedef std::map<ConfigError, std::string> ConfigErrorName;
+    static ConfigErrorName names = {
+        {ConfigError::NONE, "NONE"},
+        {ConfigError::MISSING, "MISSING"},
+        {ConfigError::NULL_VALUE, "NULL_VALUE"},
+        {ConfigError::WRONG_TYPE, "WRONG_TYPE"},
+        {ConfigError::BAD_VALUE, "BAD_VALUE"},
+        {ConfigError::BAD_PATH, "BAD_PATH"},
+        {ConfigError::NOT_RESOLVED, "NOT_RESOLVED"}
+    };
+    return names[error];
+}
+
+}
@@ -13,18 +13,30 @@
 #include "configcpp/config_exception.h"
 #include "configcpp/config_value_type.h"
 
+#include <mutex>
+
 namespace config {
 
-AbstractConfigObject::AbstractConfigObject(const ConfigOriginPtr& origin) :
-    AbstractConfigValue(origin) {
+AbstractConfigObject::AbstractConfigObject(const ConfigOriginPtr& origin, ConfigValueKind kind) :
+    AbstractConfigValue(origin, kind) {
 }
 
-void AbstractConfigObject::initialize() {
-    config = SimpleConfig::make_instance(shared_from_this());
+/// Guards the config of objects hashing to each lock; a lock per object would
+/// cost more than the config it guards.
+static std::mutex& configLock(const void* object) {
+    static const uint32_t LOCKS = 16;
+    static std::mutex locks[LOCKS];
+    return locks[(reinterpret_cast<std::uintptr_t>(object) >> 4) % LOCKS];
 }
 
 ConfigPtr AbstractConfigObject::toConfig() {
-    return config;
+    std::lock_guard<std::mutex> lock(configLock(this));
+    auto c = config.lock();
+    if (!c) {
+        c = SimpleConfig::make_instance(shared_from_this());
+        config = c;
+    }
+    return c;
 }
 
 ConfigValuePtr AbstractConfigObject::toFallbackValue() {
@@ -40,6 +52,13 @@ AbstractConfigValuePtr AbstractConfigObject::peekAssumingResolved(const std::str
     }
 }
 
+AbstractConfigValue* AbstractConfigObject::peekBorrowed(const InternedString& key, AbstractConfigValuePtr& held) {
+    // swap rather than assign: held may be what keeps this object alive
+    AbstractConfigValuePtr v = attemptPeekWithPartialResolve(key);
+    held.swap(v);
+    return held.get();
+}
+
 AbstractConfigValuePtr AbstractConfigObject::peekPath(const PathPtr& path, const ResolveContextPtr& context) {
     return peekPath(shared_from_this(), path, context);
 }
@@ -60,7 +79,7 @@ AbstractConfigValuePtr AbstractConfigObject::peekPath(const AbstractConfigObject
             // path, and then recursively call ourselves with no resolve
             // context.
             auto partiallyResolved = context->restrict(path)->resolve(self);
-            if (instanceof<AbstractConfigObject>(partiallyResolved)) {
+            if (partiallyResolved && partiallyResolved->isObject()) {
                 return peekPath(std::static_pointer_cast<AbstractConfigObject>(partiallyResolved), path, nullptr);
             }
             else {
@@ -71,13 +90,13 @@ AbstractConfigValuePtr AbstractConfigObject::peekPath(const AbstractConfigObject
             // with no resolver, we'll fail if anything along the path can't
             // be looked at without resolving.
             auto next = path->remainder();
-            auto v = self->attemptPeekWithPartialResolve(path->first());
+            auto v = self->attemptPeekWithPartialResolve(path->key(0));
 
             if (!next) {
                 return v;
             }
             else {
-                if (instanceof<AbstractConfigObject>(v)) {
+                if (v && v->isObject()) {
                     return peekPath(std::static_pointer_cast<AbstractConfigObject>(v), next, nullptr);
                 }
                 else {
@@ -118,9 +137,9 @@ ConfigOriginPtr AbstractConfigObject::mergeOrigins(const VectorAbstractConfigVal
         if (!firstOrigin) {
             firstOrigin = v->origin();
         }
-        if (instanceof<AbstractConfigObject>(v) &&
+        if (v->isObject() &&
                 std::static_pointer_cast<AbstractConfigObject>(v)->resolveStatus() == ResolveStatus::RESOLVED &&
-                std::dynamic_pointer_cast<ConfigObject>(v)->empty()) {
+                std::static_pointer_cast<AbstractConfigObject>(v)->empty()) {
             // don't include empty files or the .empty()
             // config in the description, since they are
             // likely to be "implementation details"
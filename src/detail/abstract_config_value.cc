@@ -41,12 +41,40 @@ AbstractConfigValuePtr NoExceptionsModifier::modifyChildMayThrow(const std::stri
     }
 }
 
-AbstractConfigValue::AbstractConfigValue(const ConfigOriginPtr& origin) :
-    origin_(std::dynamic_pointer_cast<SimpleConfigOrigin>(origin)) {
+AbstractConfigValue::AbstractConfigValue(const ConfigOriginPtr& origin, ConfigValueKind kind) :
+    origin_(std::dynamic_pointer_cast<SimpleConfigOrigin>(origin)),
+    originLine_(-1),
+    kind_(kind) {
 }
 
 ConfigOriginPtr AbstractConfigValue::origin() {
-    return this->origin_;
+    if (originLine_ < 0) {
+        return this->origin_;
+    }
+    else {
+        return this->origin_->setLineNumber(originLine_);
+    }
+}
+
+AbstractConfigValue* AbstractConfigValue::implementation() {
+    return this;
+}
+
+AbstractConfigValuePtr AbstractConfigValue::cast(const ConfigValuePtr& value) {
+    return value ? AbstractConfigValuePtr(value, value->implementation()) : nullptr;
+}
+
+AbstractConfigValue* AbstractConfigValue::borrow(const ConfigValuePtr& value) {
+    return value ? value->implementation() : nullptr;
+}
+
+void AbstractConfigValue::setOriginLine(int32_t lineNumber) {
+    originLine_ = lineNumber;
+}
+
+void AbstractConfigValue::copyOrigin(const AbstractConfigValue& other) {
+    origin_ = other.origin_;
+    originLine_ = other.originLine_;
 }
 
 AbstractConfigValuePtr AbstractConfigValue::resolveSubstitutions(const ResolveContextPtr& context) {
@@ -114,7 +142,7 @@ AbstractConfigValuePtr AbstractConfigValue::delayMerge(const VectorAbstractConfi
 AbstractConfigValuePtr AbstractConfigValue::mergedWithObject(const VectorAbstractConfigValue& stack, const AbstractConfigObjectPtr& fallback) {
     requireNotIgnoringFallbacks();
 
-    if (instanceof<AbstractConfigObject>(shared_from_this())) {
+    if (isObject()) {
         throw ConfigExceptionBugOrBroken("Objects must reimplement mergedWithObject");
     }
 
@@ -156,7 +184,7 @@ AbstractConfigValuePtr AbstractConfigValue::mergedWithNonObject(const AbstractCo
 }
 
 AbstractConfigValuePtr AbstractConfigValue::withOrigin(const ConfigOriginPtr& origin) {
-    if (this->origin_ == origin) {
+    if (originLine_ < 0 && this->origin_ == origin) {
         return shared_from_this();
     }
     else {
@@ -170,16 +198,22 @@ ConfigMergeablePtr AbstractConfigValue::withFallback(const ConfigMergeablePtr& m
     }
     else {
         auto other = std::dynamic_pointer_cast<MergeableValue>(mergeable)->toFallbackValue();
+        return std::static_pointer_cast<ConfigMergeable>(withFallbackValue(AbstractConfigValue::cast(other)));
+    }
+}
 
-        if (instanceof<Unmergeable>(other)) {
-            return std::static_pointer_cast<ConfigMergeable>(mergedWithTheUnmergeable(std::dynamic_pointer_cast<Unmergeable>(other)));
-        }
-        else if (instanceof<AbstractConfigObject>(other)) {
-            return std::static_pointer_cast<ConfigMergeable>(mergedWithObject(std::dynamic_pointer_cast<AbstractConfigObject>(other)));
-        }
-        else {
-            return std::static_pointer_cast<ConfigMergeable>(mergedWithNonObject(std::dynamic_pointer_cast<AbstractConfigValue>(other)));
-        }
+AbstractConfigValuePtr AbstractConfigValue::withFallbackValue(const AbstractConfigValuePtr& other) {
+    if (ignoresFallbacks()) {
+        return shared_from_this();
+    }
+    else if (other->isUnmergeable()) {
+        return mergedWithTheUnmergeable(std::dynamic_pointer_cast<Unmergeable>(other));
+    }
+    else if (other->isObject()) {
+        return mergedWithObject(std::static_pointer_cast<AbstractConfigObject>(other));
+    }
+    else {
+        return mergedWithNonObject(other);
     }
 }
 
@@ -242,7 +276,7 @@ void AbstractConfigValue::render(std::string& s, uint32_t indent, const boost::o
         }
         else {
             // in non-JSON we can omit the colon or equals before an object
-            if (instanceof<ConfigObject>(shared_from_this())) {
+            if (isObject()) {
                 if (options->getFormatted()) {
                     s += " ";
                 }
@@ -274,6 +308,10 @@ std::string AbstractConfigValue::transformToString() {
     return "";
 }
 
+const std::string* AbstractConfigValue::borrowString() {
+    return nullptr;
+}
+
 SimpleConfigPtr AbstractConfigValue::atKey(const ConfigOriginPtr& origin, const std::string& key) {
     MapAbstractConfigValue m({{key, shared_from_this()}});
     return std::dynamic_pointer_cast<SimpleConfig>(SimpleConfigObject::make_instance(origin, m)->toConfig());
@@ -0,0 +1,193 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/detail/char_scanner.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CONFIG_SCANNER_X86
+#include <immintrin.h>
+#endif
+
+namespace config {
+
+// Scalar kernels; these define what the vector kernels must match.
+
+static bool isQuotedStop(char c) {
+    uint8_t u = static_cast<uint8_t>(c);
+    return c == '"' || c == '\\' || u < 0x20 || u == 0x7f;
+}
+
+static bool isWhitespaceNotNewline(char c) {
+    uint8_t u = static_cast<uint8_t>(c);
+    return c == ' ' || (u >= '\t' && u <= '\r' && c != '\n');
+}
+
+static const char* findQuotedStopScalar(const char* begin, const char* end) {
+    while (begin != end && !isQuotedStop(*begin)) {
+        ++begin;
+    }
+    return begin;
+}
+
+static const char* findNewlineScalar(const char* begin, const char* end) {
+    while (begin != end && *begin != '\n') {
+        ++begin;
+    }
+    return begin;
+}
+
+static const char* skipWhitespaceScalar(const char* begin, const char* end) {
+    while (begin != end && isWhitespaceNotNewline(*begin)) {
+        ++begin;
+    }
+    return begin;
+}
+
+#ifdef CONFIG_SCANNER_X86
+
+// Each vector kernel builds a byte mask of matching characters per stride
+// and finishes the tail (less than one stride) with the scalar kernel.
+
+__attribute__((target("sse2")))
+static __m128i quotedStopMask16(__m128i v) {
+    __m128i quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+    __m128i backslash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+    // unsigned v <= 0x1f
+    __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1f)), v);
+    __m128i del = _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7f));
+    return _mm_or_si128(_mm_or_si128(quote, backslash), _mm_or_si128(control, del));
+}
+
+__attribute__((target("sse2")))
+static __m128i whitespaceMask16(__m128i v) {
+    __m128i space = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    // unsigned (v - '\t') <= '\r' - '\t', i.e. \t \n \v \f \r
+    __m128i offset = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+    __m128i range = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8('\r' - '\t')), offset);
+    __m128i newline = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+    return _mm_or_si128(space, _mm_andnot_si128(newline, range));
+}
+
+__attribute__((target("sse2")))
+static const char* findQuotedStopSse2(const char* begin, const char* end) {
+    for (; end - begin >= 16; begin += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(quotedStopMask16(v)));
+        if (mask != 0) {
+            return begin + __builtin_ctz(mask);
+        }
+    }
+    return findQuotedStopScalar(begin, end);
+}
+
+__attribute__((target("sse2")))
+static const char* findNewlineSse2(const char* begin, const char* end) {
+    for (; end - begin >= 16; begin += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+        if (mask != 0) {
+            return begin + __builtin_ctz(mask);
+        }
+    }
+    return findNewlineScalar(begin, end);
+}
+
+__attribute__((target("sse2")))
+static const char* skipWhitespaceSse2(const char* begin, const char* end) {
+    for (; end - begin >= 16; begin += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(whitespaceMask16(v))) & 0xffff;
+        if (mask != 0) {
+            return begin + __builtin_ctz(mask);
+        }
+    }
+    return skipWhitespaceScalar(begin, end);
+}
+
+__attribute__((target("avx2")))
+static __m256i quotedStopMask32(__m256i v) {
+    __m256i quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+    __m256i backslash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'));
+    __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1f)), v);
+    __m256i del = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7f));
+    return _mm256_or_si256(_mm256_or_si256(quote, backslash), _mm256_or_si256(control, del));
+}
+
+__attribute__((target("avx2")))
+static __m256i whitespaceMask32(__m256i v) {
+    __m256i space = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+    __m256i offset = _mm256_sub_epi8(v, _mm256_set1_epi8('\t'));
+    __m256i range = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8('\r' - '\t')), offset);
+    __m256i newline = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+    return _mm256_or_si256(space, _mm256_andnot_si256(newline, range));
+}
+
+__attribute__((target("avx2")))
+static const char* findQuotedStopAvx2(const char* begin, const char* end) {
+    for (; end - begin >= 32; begin += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(quotedStopMask32(v)));
+        if (mask != 0) {
+            return begin + __builtin_ctz(mask);
+        }
+    }
+    return findQuotedStopSse2(begin, end);
+}
+
+__attribute__((target("avx2")))
+static const char* findNewlineAvx2(const char* begin, const char* end) {
+    for (; end - begin >= 32; begin += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))));
+        if (mask != 0) {
+            return begin + __builtin_ctz(mask);
+        }
+    }
+    return findNewlineSse2(begin, end);
+}
+
+__attribute__((target("avx2")))
+static const char* skipWhitespaceAvx2(const char* begin, const char* end) {
+    for (; end - begin >= 32; begin += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(whitespaceMask32(v)));
+        if (mask != 0) {
+            return begin + __builtin_ctz(mask);
+        }
+    }
+    return skipWhitespaceSse2(begin, end);
+}
+
+#endif // CONFIG_SCANNER_X86
+
+std::vector<CharScanner::Kernels> CharScanner::supportedKernels() {
+    std::vector<Kernels> kernels;
+    kernels.push_back({"scalar", findQuotedStopScalar, findNewlineScalar, skipWhitespaceScalar});
+#ifdef CONFIG_SCANNER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        kernels.push_back({"sse2", findQuotedStopSse2, findNewlineSse2, skipWhitespaceSse2});
+    }
+    if (__builtin_cpu_supports("sse2") && __builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", findQuotedStopAvx2, findNewlineAvx2, skipWhitespaceAvx2});
+    }
+#endif
+    return kernels;
+}
+
+CharScanner::Kernels& CharScanner::selected() {
+    static Kernels selected = supportedKernels().back();
+    return selected;
+}
+
+const CharScanner::Kernels& CharScanner::kernels() {
+    return selected();
+}
+
+void CharScanner::setKernels(const Kernels& kernels) {
+    selected() = kernels;
+}
+
+}
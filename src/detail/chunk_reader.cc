@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/detail/chunk_reader.h"
+
+namespace config {
+
+void ChunkReader::readRemaining(std::string& buffer, const char*& begin, const char*& end) {
+    const char* chunkBegin;
+    const char* chunkEnd;
+    while (readChunk(chunkBegin, chunkEnd)) {
+        buffer.append(chunkBegin, chunkEnd);
+    }
+    begin = buffer.data();
+    end = buffer.data() + buffer.length();
+}
+
+ReaderChunkAdapter::ReaderChunkAdapter(const ReaderPtr& reader) :
+    reader(reader) {
+}
+
+ChunkReaderPtr ReaderChunkAdapter::adapt(const ReaderPtr& reader) {
+    auto chunkReader = std::dynamic_pointer_cast<ChunkReader>(reader);
+    if (chunkReader) {
+        return chunkReader;
+    }
+    else {
+        return make_instance(reader);
+    }
+}
+
+int32_t ReaderChunkAdapter::read() {
+    return reader->read();
+}
+
+bool ReaderChunkAdapter::readChunk(const char*& begin, const char*& end) {
+    uint32_t size = 0;
+    while (size < BUFFER_SIZE) {
+        int32_t c = reader->read();
+        if (c == READER_EOF) {
+            break;
+        }
+        buffer[size++] = static_cast<char>(c);
+    }
+    begin = buffer;
+    end = buffer + size;
+    return size > 0;
+}
+
+void ReaderChunkAdapter::close() {
+    reader->close();
+}
+
+}
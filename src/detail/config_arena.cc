@@ -0,0 +1,103 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/detail/config_arena.h"
+
+#include <algorithm>
+#include <new>
+
+namespace config {
+
+const std::size_t ConfigArena::CHUNK_SIZE;
+const std::size_t ConfigArena::GRANULE;
+const std::size_t ConfigArena::MAX_POOLED;
+
+ConfigArena::ConfigArena() :
+    next(nullptr),
+    end(nullptr),
+    reservedBytes(0),
+    inUseBytes(0) {
+    std::fill(freeLists, freeLists + MAX_POOLED / GRANULE, nullptr);
+}
+
+ConfigArena::~ConfigArena() {
+    for (auto chunk : chunks) {
+        ::operator delete(chunk);
+    }
+}
+
+void* ConfigArena::allocate(std::size_t bytes, std::size_t alignment) {
+    if (bytes > MAX_POOLED || alignment > GRANULE) {
+        return ::operator new(bytes);
+    }
+    std::size_t rounded = bytes == 0 ? GRANULE : (bytes + GRANULE - 1) & ~(GRANULE - 1);
+    void*& freeList = freeLists[rounded / GRANULE - 1];
+
+    std::lock_guard<std::mutex> lock(mutex);
+    inUseBytes += rounded;
+    if (freeList) {
+        void* block = freeList;
+        freeList = *static_cast<void**>(block);
+        return block;
+    }
+    if (static_cast<std::size_t>(end - next) < rounded) {
+        // operator new's memory is aligned to at least GRANULE; what was
+        // left of the last chunk is abandoned
+        char* chunk = static_cast<char*>(::operator new(CHUNK_SIZE));
+        chunks.push_back(chunk);
+        reservedBytes += CHUNK_SIZE;
+        next = chunk;
+        end = chunk + CHUNK_SIZE;
+    }
+    void* block = next;
+    next += rounded;
+    return block;
+}
+
+void ConfigArena::deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    if (bytes > MAX_POOLED || alignment > GRANULE) {
+        ::operator delete(p);
+        return;
+    }
+    std::size_t rounded = bytes == 0 ? GRANULE : (bytes + GRANULE - 1) & ~(GRANULE - 1);
+    void*& freeList = freeLists[rounded / GRANULE - 1];
+
+    std::lock_guard<std::mutex> lock(mutex);
+    inUseBytes -= rounded;
+    *static_cast<void**>(p) = freeList;
+    freeList = p;
+}
+
+std::size_t ConfigArena::reserved() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return reservedBytes;
+}
+
+std::size_t ConfigArena::inUse() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return inUseBytes;
+}
+
+ConfigMemoryResourcePtr ConfigArena::current() {
+    return std::dynamic_pointer_cast<ConfigArena>(ConfigMemoryScope::current());
+}
+
+ConfigMemoryResourcePtr ConfigArena::forOptions(bool useArena, const ConfigMemoryResourcePtr& resource, const ConfigMemoryResourcePtr& owned) {
+    if (resource) {
+        return resource;
+    }
+    else if (owned) {
+        return owned;
+    }
+    else if (useArena) {
+        auto arena = current();
+        return arena ? arena : std::make_shared<ConfigArena>();
+    }
+    else {
+        return nullptr;
+    }
+}
+
+}
@@ -9,7 +9,7 @@
 namespace config {
 
 ConfigBoolean::ConfigBoolean(const ConfigOriginPtr& origin, bool value) :
-    AbstractConfigValue(origin),
+    AbstractConfigValue(origin, ConfigValueKind::BOOLEAN),
     value(value) {
 }
 
@@ -25,6 +25,12 @@ std::string ConfigBoolean::transformToString() {
     return value ? "true" : "false";
 }
 
+const std::string* ConfigBoolean::borrowString() {
+    static const std::string trueString = "true";
+    static const std::string falseString = "false";
+    return value ? &trueString : &falseString;
+}
+
 AbstractConfigValuePtr ConfigBoolean::newCopy(const ConfigOriginPtr& origin) {
     return make_instance(origin, value);
 }
@@ -14,7 +14,7 @@
 namespace config {
 
 ConfigConcatenation::ConfigConcatenation(const ConfigOriginPtr& origin, const VectorAbstractConfigValue& pieces) :
-    AbstractConfigValue(origin),
+    AbstractConfigValue(origin, ConfigValueKind::CONCATENATION),
     pieces(pieces) {
     if (pieces.size() < 2) {
         throw ConfigExceptionBugOrBroken("Created concatenation with less than 2 items: " + toString());
@@ -22,10 +22,10 @@ ConfigConcatenation::ConfigConcatenation(const ConfigOriginPtr& origin, const Ve
 
     bool hadUnmergeable = false;
     for (auto& p : pieces) {
-        if (instanceof<ConfigConcatenation>(p)) {
+        if (p->kind() == ConfigValueKind::CONCATENATION) {
             throw ConfigExceptionBugOrBroken("ConfigConcatenation should never be nested: " + toString());
         }
-        if (instanceof<Unmergeable>(p)) {
+        if (p->isUnmergeable()) {
             hadUnmergeable = true;
         }
     }
@@ -67,16 +67,16 @@ void ConfigConcatenation::join(VectorAbstractConfigValue& builder, const Abstrac
     // of much alternative to an instanceof chain. Visitors are sometimes
     // used for multiple dispatch but seems like overkill.
     AbstractConfigValuePtr joined;
-    if (instanceof<ConfigObject>(left) && instanceof<ConfigObject>(right)) {
-        joined = std::dynamic_pointer_cast<AbstractConfigValue>(right->withFallback(left));
+    if (left->isObject() && right->isObject()) {
+        joined = right->withFallbackValue(left);
     }
-    else if (instanceof<SimpleConfigList>(left) && instanceof<SimpleConfigList>(right)) {
+    else if (left->kind() == ConfigValueKind::LIST && right->kind() == ConfigValueKind::LIST) {
         joined = std::static_pointer_cast<SimpleConfigList>(left)->concatenate(std::static_pointer_cast<SimpleConfigList>(right));
     }
-    else if (instanceof<ConfigConcatenation>(left) || instanceof<ConfigConcatenation>(right)) {
+    else if (left->kind() == ConfigValueKind::CONCATENATION || right->kind() == ConfigValueKind::CONCATENATION) {
         throw ConfigExceptionBugOrBroken("unflattened ConfigConcatenation");
     }
-    else if (instanceof<Unmergeable>(left) || instanceof<Unmergeable>(right)) {
+    else if (left->isUnmergeable() || right->isUnmergeable()) {
         // leave joined=null, cannot join
     }
     else {
@@ -88,6 +88,11 @@ void ConfigConcatenation::join(VectorAbstractConfigValue& builder, const Abstrac
                     "Cannot concatenate object or list with a non-object-or-list, " +
                     left->toString() + " and " + right->toString() + " are not compatible");
         }
+        else if (left->hasSameOrigin(*right)) {
+            // the merge of an origin with itself is the same origin
+            joined = ConfigString::make_instance(nullptr, s1 + s2);
+            joined->copyOrigin(*left);
+        }
         else {
             auto joinedOrigin = SimpleConfigOrigin::mergeOrigins(left->origin(), right->origin());
             joined = ConfigString::make_instance(joinedOrigin, s1 + s2);
@@ -111,7 +116,7 @@ VectorAbstractConfigValue ConfigConcatenation::consolidate(const VectorAbstractC
         VectorAbstractConfigValue flattened;
         flattened.reserve(pieces.size());
         for (auto& v : pieces) {
-            if (instanceof<ConfigConcatenation>(v)) {
+            if (v->kind() == ConfigValueKind::CONCATENATION) {
                 flattened.insert(flattened.end(), std::static_pointer_cast<ConfigConcatenation>(v)->pieces.begin(), std::static_pointer_cast<ConfigConcatenation>(v)->pieces.end());
             }
             else {
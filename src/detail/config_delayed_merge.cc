@@ -16,13 +16,13 @@
 namespace config {
 
 ConfigDelayedMerge::ConfigDelayedMerge(const ConfigOriginPtr& origin, const VectorAbstractConfigValue& stack) :
-    AbstractConfigValue(origin),
+    AbstractConfigValue(origin, ConfigValueKind::DELAYED_MERGE),
     stack(stack) {
     if (stack.empty()) {
         throw ConfigExceptionBugOrBroken("creating empty delayed merge value");
     }
     for (auto& v : stack) {
-        if (instanceof<ConfigDelayedMerge>(v) || instanceof<ConfigDelayedMergeObject>(v)) {
+        if (v->kind() == ConfigValueKind::DELAYED_MERGE || v->kind() == ConfigValueKind::DELAYED_MERGE_OBJECT) {
             throw ConfigExceptionBugOrBroken("placed nested DelayedMerge in a ConfigDelayedMerge, should have consolidated stack");
         }
     }
@@ -49,7 +49,7 @@ AbstractConfigValuePtr ConfigDelayedMerge::resolveSubstitutions(const Replaceabl
     uint32_t count = 0;
     AbstractConfigValuePtr merged;
     for (auto& v : stack) {
-        if (instanceof<ReplaceableMergeStack>(v)) {
+        if (v->kind() == ConfigValueKind::DELAYED_MERGE || v->kind() == ConfigValueKind::DELAYED_MERGE_OBJECT) {
             throw ConfigExceptionBugOrBroken("A delayed merge should not contain another one: " + boost::lexical_cast<std::string>(replaceable.get()));
         }
 
@@ -59,7 +59,7 @@ AbstractConfigValuePtr ConfigDelayedMerge::resolveSubstitutions(const Replaceabl
         // value-concatenation containing one. The Unmergeable
         // here isn't a delayed merge stack since we can't contain
         // another stack (see assertion above).
-        if (instanceof<Unmergeable>(v)) {
+        if (v->isUnmergeable()) {
             // If, while resolving 'v' we come back to the same
             // merge stack, we only want to look _below_ 'v'
             // in the stack. So we arrange to replace the
@@ -91,7 +91,7 @@ AbstractConfigValuePtr ConfigDelayedMerge::resolveSubstitutions(const Replaceabl
                 merged = resolved;
             }
             else {
-                merged = std::dynamic_pointer_cast<AbstractConfigValue>(merged->withFallback(resolved));
+                merged = merged->withFallbackValue(resolved);
             }
         }
         count += 1;
@@ -127,7 +127,7 @@ AbstractConfigValuePtr ConfigDelayedMerge::makeReplacement(const ResolveContextP
                 merged = v;
             }
             else {
-                merged = std::dynamic_pointer_cast<AbstractConfigValue>(merged->withFallback(v));
+                merged = merged->withFallbackValue(v);
             }
         }
         return merged;
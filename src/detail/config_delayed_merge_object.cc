@@ -12,18 +12,18 @@
 namespace config {
 
 ConfigDelayedMergeObject::ConfigDelayedMergeObject(const ConfigOriginPtr& origin, const VectorAbstractConfigValue& stack) :
-    AbstractConfigObject(origin),
+    AbstractConfigObject(origin, ConfigValueKind::DELAYED_MERGE_OBJECT),
     stack(stack) {
 
     if (stack.empty()) {
         throw ConfigExceptionBugOrBroken("creating empty delayed merge object");
     }
-    if (!instanceof<AbstractConfigObject>(stack.front())) {
+    if (!stack.front()->isObject()) {
         throw ConfigExceptionBugOrBroken("created a delayed merge object not guaranteed to be an object");
     }
 
     for (auto& v : stack) {
-        if (instanceof<ConfigDelayedMerge>(v) || instanceof<ConfigDelayedMergeObject>(v)) {
+        if (v->kind() == ConfigValueKind::DELAYED_MERGE || v->kind() == ConfigValueKind::DELAYED_MERGE_OBJECT) {
             throw ConfigExceptionBugOrBroken("placed nested DelayedMerge in a ConfigDelayedMergeObject, should have consolidated stack");
         }
     }
@@ -38,7 +38,7 @@ AbstractConfigObjectPtr ConfigDelayedMergeObject::newCopy(ResolveStatus status,
 
 AbstractConfigValuePtr ConfigDelayedMergeObject::resolveSubstitutions(const ResolveContextPtr& context) {
     auto merged = ConfigDelayedMerge::resolveSubstitutions(shared_from_this(), stack, context);
-    if (instanceof<AbstractConfigObject>(merged)) {
+    if (merged && merged->isObject()) {
         return std::static_pointer_cast<AbstractConfigObject>(merged);
     }
     else {
@@ -196,7 +196,7 @@ MapConfigValue::const_iterator ConfigDelayedMergeObject::find(const MapConfigVal
     throw notResolved();
 }
 
-AbstractConfigValuePtr ConfigDelayedMergeObject::attemptPeekWithPartialResolve(const std::string& key) {
+AbstractConfigValuePtr ConfigDelayedMergeObject::attemptPeekWithPartialResolve(const InternedString& key) {
     // a partial resolve of a ConfigDelayedMergeObject always results in a
     // SimpleConfigObject because all the substitutions in the stack get
     // resolved in order to look up the partial.
@@ -210,7 +210,7 @@ AbstractConfigValuePtr ConfigDelayedMergeObject::attemptPeekWithPartialResolve(c
     // we'll be able to return a key if we have a value that ignores
     // fallbacks, prior to any unmergeable values.
     for (auto& layer : stack) {
-        if (instanceof<AbstractConfigObject>(layer)) {
+        if (layer->isObject()) {
             auto objectLayer = std::static_pointer_cast<AbstractConfigObject>(layer);
             auto v = objectLayer->attemptPeekWithPartialResolve(key);
             if (v) {
@@ -227,7 +227,7 @@ AbstractConfigValuePtr ConfigDelayedMergeObject::attemptPeekWithPartialResolve(c
                     continue;
                 }
             }
-            else if (instanceof<Unmergeable>(layer)) {
+            else if (layer->isUnmergeable()) {
                 // an unmergeable object (which would be another
                 // ConfigDelayedMergeObject) can't know that a key is
                 // missing, so it can't return null; it can only return a
@@ -241,7 +241,7 @@ AbstractConfigValuePtr ConfigDelayedMergeObject::attemptPeekWithPartialResolve(c
                 continue;
             }
         }
-        else if (instanceof<Unmergeable>(layer)) {
+        else if (layer->isUnmergeable()) {
             throw ConfigExceptionNotResolved("Key '" + key + "' is not available at '" +
                     origin()->description() + "' because value at '" +
                     layer->origin()->description() +
@@ -253,7 +253,7 @@ AbstractConfigValuePtr ConfigDelayedMergeObject::attemptPeekWithPartialResolve(c
             // if the layer is not an object, and not a substitution or merge,
             // then it's something that's unresolved because it _contains_
             // an unresolved object... i.e. it's an array
-            if (!instanceof<ConfigList>(layer)) {
+            if (layer->kind() != ConfigValueKind::LIST) {
                 throw ConfigExceptionBugOrBroken("Expecting a list here, not " + layer->toString());
             }
             // all later objects will be hidden so we can say we won't find the key
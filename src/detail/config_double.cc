@@ -9,8 +9,11 @@
 namespace config {
 
 ConfigDouble::ConfigDouble(const ConfigOriginPtr& origin, double value, const std::string& originalText) :
-    ConfigNumber(origin, originalText),
+    ConfigNumber(origin, ConfigValueKind::DOUBLE, originalText),
     value(value) {
+    if (this->originalText.empty()) {
+        this->originalText = boost::lexical_cast<std::string>(value);
+    }
 }
 
 ConfigValueType ConfigDouble::valueType() {
@@ -21,16 +24,6 @@ ConfigVariant ConfigDouble::unwrapped() {
     return value;
 }
 
-std::string ConfigDouble::transformToString() {
-    std::string s = ConfigNumber::transformToString();
-    if (s.empty()) {
-        return boost::lexical_cast<std::string>(value);
-    }
-    else {
-        return s;
-    }
-}
-
 int64_t ConfigDouble::int64Value() {
     return static_cast<int64_t>(value);
 }
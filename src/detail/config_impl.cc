@@ -51,12 +51,16 @@ ConfigPtr ConfigImpl::emptyConfig(const std::string& originDescription) {
 }
 
 ConfigOriginPtr ConfigImpl::defaultValueOrigin() {
-    static auto defaultValueOrigin_ = SimpleConfigOrigin::newSimple("hardcoded value");
+    static auto defaultValueOrigin_ = ConfigHeapScope::make([]() {
+        return SimpleConfigOrigin::newSimple("hardcoded value");
+    });
     return defaultValueOrigin_;
 }
 
 AbstractConfigObjectPtr ConfigImpl::emptyObject(const ConfigOriginPtr& origin) {
-    static auto defaultEmptyObject = SimpleConfigObject::makeEmpty(defaultValueOrigin());
+    static auto defaultEmptyObject = ConfigHeapScope::make([]() {
+        return SimpleConfigObject::makeEmpty(defaultValueOrigin());
+    });
 
     // we want null origin to go to SimpleConfigObject::makeEmpty() to get the
     // origin "empty config" rather than "hardcoded value"
@@ -69,7 +73,9 @@ AbstractConfigObjectPtr ConfigImpl::emptyObject(const ConfigOriginPtr& origin) {
 }
 
 SimpleConfigListPtr ConfigImpl::emptyList(const ConfigOriginPtr& origin) {
-    static auto defaultEmptyList = SimpleConfigList::make_instance(defaultValueOrigin(), VectorAbstractConfigValue());
+    static auto defaultEmptyList = ConfigHeapScope::make([]() {
+        return SimpleConfigList::make_instance(defaultValueOrigin(), VectorAbstractConfigValue());
+    });
     if (!origin || origin == defaultValueOrigin()) {
         return defaultEmptyList;
     }
@@ -98,9 +104,15 @@ ConfigObjectPtr ConfigImpl::fromPathMap(const MapVariant& pathMap, const std::st
 }
 
 AbstractConfigValuePtr ConfigImpl::fromAnyRef(const ConfigVariant& object, const ConfigOriginPtr& origin, FromMapMode mapMode) {
-    static auto defaultTrueValue = ConfigBoolean::make_instance(defaultValueOrigin(), true);
-    static auto defaultFalseValue = ConfigBoolean::make_instance(defaultValueOrigin(), false);
-    static auto defaultNullValue = ConfigNull::make_instance(defaultValueOrigin());
+    static auto defaultTrueValue = ConfigHeapScope::make([]() {
+        return ConfigBoolean::make_instance(defaultValueOrigin(), true);
+    });
+    static auto defaultFalseValue = ConfigHeapScope::make([]() {
+        return ConfigBoolean::make_instance(defaultValueOrigin(), false);
+    });
+    static auto defaultNullValue = ConfigHeapScope::make([]() {
+        return ConfigNull::make_instance(defaultValueOrigin());
+    });
 
     if (!origin) {
         throw ConfigExceptionBugOrBroken("origin not supposed to be null");
@@ -145,7 +157,7 @@ AbstractConfigValuePtr ConfigImpl::fromAnyRef(const ConfigVariant& object, const
             MapAbstractConfigValue values;
             for (auto& entry : variant_get<MapVariant>(object)) {
                 auto value = fromAnyRef(entry.second, origin, mapMode);
-                values[entry.first] = value;
+                values[InternedString(entry.first, ConfigMemoryScope::current())] = value;
             }
             return SimpleConfigObject::make_instance(origin, values);
         }
@@ -217,10 +229,9 @@ AbstractConfigObjectPtr ConfigImpl::fromPathMap(const ConfigOriginPtr& origin, c
     for (auto& path : valuePaths) {
         auto parentPath = path->parent();
         MapAbstractConfigValue& parent = parentPath ? scopes[parentPath] : root;
-        std::string last = path->last();
         ConfigVariant rawValue = pathMap[path];
         auto value = ConfigImpl::fromAnyRef(pathMap[path], origin, FromMapMode::KEYS_ARE_PATHS);
-        parent[last] = value;
+        parent[path->key(path->length() - 1)] = value;
     }
 
     // Make a list of scope paths from longest to shortest, so children go
@@ -242,7 +253,7 @@ AbstractConfigObjectPtr ConfigImpl::fromPathMap(const ConfigOriginPtr& origin, c
         auto& parent = parentPath ? scopes[parentPath] : root;
         auto o = SimpleConfigObject::make_instance(origin, scopes[scopePath],
                                                                       ResolveStatus::RESOLVED, false);
-        parent[scopePath->last()] = o;
+        parent[scopePath->key(scopePath->length() - 1)] = o;
     }
 
     // return root config object
@@ -88,9 +88,8 @@ std::string ConfigImplUtil::joinPath(const VectorString& elements) {
 VectorString ConfigImplUtil::splitPath(const std::string& path) {
     auto p = Path::newPath(path);
     VectorString elements;
-    while (p) {
-        elements.push_back(p->first());
-        p = p->remainder();
+    for (uint32_t i = 0; i < p->length(); ++i) {
+        elements.push_back(p->element(i));
     }
     return elements;
 }
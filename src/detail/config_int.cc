@@ -9,8 +9,11 @@
 namespace config {
 
 ConfigInt::ConfigInt(const ConfigOriginPtr& origin, int32_t value, const std::string& originalText) :
-    ConfigNumber(origin, originalText),
+    ConfigNumber(origin, ConfigValueKind::INT, originalText),
     value(value) {
+    if (this->originalText.empty()) {
+        this->originalText = boost::lexical_cast<std::string>(value);
+    }
 }
 
 ConfigValueType ConfigInt::valueType() {
@@ -21,16 +24,6 @@ ConfigVariant ConfigInt::unwrapped() {
     return value;
 }
 
-std::string ConfigInt::transformToString() {
-    std::string s = ConfigNumber::transformToString();
-    if (s.empty()) {
-        return boost::lexical_cast<std::string>(value);
-    }
-    else {
-        return s;
-    }
-}
-
 int64_t ConfigInt::int64Value() {
     return static_cast<int64_t>(value);
 }
@@ -9,8 +9,11 @@
 namespace config {
 
 ConfigInt64::ConfigInt64(const ConfigOriginPtr& origin, int64_t value, const std::string& originalText) :
-    ConfigNumber(origin, originalText),
+    ConfigNumber(origin, ConfigValueKind::INT64, originalText),
     value(value) {
+    if (this->originalText.empty()) {
+        this->originalText = boost::lexical_cast<std::string>(value);
+    }
 }
 
 ConfigValueType ConfigInt64::valueType() {
@@ -21,16 +24,6 @@ ConfigVariant ConfigInt64::unwrapped() {
     return value;
 }
 
-std::string ConfigInt64::transformToString() {
-    std::string s = ConfigNumber::transformToString();
-    if (s.empty()) {
-        return boost::lexical_cast<std::string>(value);
-    }
-    else {
-        return s;
-    }
-}
-
 int64_t ConfigInt64::int64Value() {
     return value;
 }
@@ -9,7 +9,7 @@
 namespace config {
 
 ConfigNull::ConfigNull(const ConfigOriginPtr& origin) :
-    AbstractConfigValue(origin) {
+    AbstractConfigValue(origin, ConfigValueKind::NULL_VALUE) {
 }
 
 ConfigValueType ConfigNull::valueType() {
@@ -12,8 +12,8 @@
 
 namespace config {
 
-ConfigNumber::ConfigNumber(const ConfigOriginPtr& origin, const std::string& originalText) :
-    AbstractConfigValue(origin),
+ConfigNumber::ConfigNumber(const ConfigOriginPtr& origin, ConfigValueKind kind, const std::string& originalText) :
+    AbstractConfigValue(origin, kind),
     originalText(originalText) {
 }
 
@@ -21,6 +21,10 @@ std::string ConfigNumber::transformToString() {
     return originalText;
 }
 
+const std::string* ConfigNumber::borrowString() {
+    return &originalText;
+}
+
 int32_t ConfigNumber::intValueRangeChecked(const std::string& path) {
     int64_t l = int64Value();
 
@@ -20,7 +20,7 @@ ConfigReference::ConfigReference(const ConfigOriginPtr& origin, const Substituti
 }
 
 ConfigReference::ConfigReference(const ConfigOriginPtr& origin, const SubstitutionExpressionPtr& expr, uint32_t prefixLength) :
-    AbstractConfigValue(origin),
+    AbstractConfigValue(origin, ConfigValueKind::REFERENCE),
     expr(expr),
     prefixLength(prefixLength) {
 }
@@ -11,8 +11,8 @@
 namespace config {
 
 ConfigString::ConfigString(const ConfigOriginPtr& origin, const std::string& value) :
-    AbstractConfigValue(origin),
-    value(value) {
+    AbstractConfigValue(origin, ConfigValueKind::STRING),
+    value(value, ConfigMemoryScope::current()) {
 }
 
 ConfigValueType ConfigString::valueType() {
@@ -20,11 +20,15 @@ ConfigValueType ConfigString::valueType() {
 }
 
 ConfigVariant ConfigString::unwrapped() {
-    return value;
+    return value.str();
 }
 
 std::string ConfigString::transformToString() {
-    return value;
+    return value.str();
+}
+
+const std::string* ConfigString::borrowString() {
+    return &value.str();
 }
 
 void ConfigString::render(std::string& s, uint32_t indent, const ConfigRenderOptionsPtr& options) {
@@ -9,6 +9,7 @@
 #include "configcpp/detail/config_null.h"
 #include "configcpp/detail/config_boolean.h"
 #include "configcpp/detail/config_string.h"
+#include "configcpp/detail/number_parser.h"
 #include "configcpp/config_value_type.h"
 
 namespace config {
@@ -17,19 +18,16 @@ AbstractConfigValuePtr DefaultTransformer::transform(const AbstractConfigValuePt
     if (value->valueType() == ConfigValueType::STRING) {
         std::string s = value->unwrapped<std::string>();
         switch (requested) {
-            case ConfigValueType::NUMBER:
-                try {
-                    int64_t v = boost::lexical_cast<int64_t>(s);
-                    return ConfigInt64::make_instance(value->origin(), v, s);
-                }
-                catch (boost::bad_lexical_cast&) {
+            case ConfigValueType::NUMBER: {
+                    int64_t i;
+                    if (NumberParser::parseInt64(s, i)) {
+                        return ConfigInt64::make_instance(value->origin(), i, s);
+                    }
                     // try double
-                }
-                try {
-                    double v = boost::lexical_cast<double>(s);
-                    return ConfigDouble::make_instance(value->origin(), v, s);
-                }
-                catch (boost::bad_lexical_cast&) {
+                    double d;
+                    if (NumberParser::parseDouble(s, d)) {
+                        return ConfigDouble::make_instance(value->origin(), d, s);
+                    }
                     // oh well
                 }
                 break;
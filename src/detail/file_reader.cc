@@ -29,10 +29,23 @@ int32_t FileReader::read() {
     return static_cast<int32_t>(buffer[position++]);
 }
 
+bool FileReader::readChunk(const char*& begin, const char*& end) {
+    if (position >= size) {
+        if (!fillBuffer()) {
+            begin = end = buffer;
+            return false;
+        }
+    }
+    begin = buffer + position;
+    end = buffer + size;
+    position = size;
+    return true;
+}
+
 bool FileReader::fillBuffer() {
     try {
         if (file.eof()) {
-            return READER_EOF;
+            return false;
         }
         file.read(buffer, BUFFER_SIZE);
         size = file.gcount();
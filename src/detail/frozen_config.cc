@@ -0,0 +1,244 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/detail/frozen_config.h"
+#include "configcpp/detail/abstract_config_object.h"
+#include "configcpp/detail/config_number.h"
+#include "configcpp/config_path.h"
+#include "configcpp/config_exception.h"
+#include "configcpp/config_value_type.h"
+
+namespace config {
+
+FrozenConfig::FrozenConfig(const AbstractConfigObjectPtr& object) :
+    SimpleConfig(object) {
+    if (object->resolveStatus() != ResolveStatus::RESOLVED) {
+        throw ConfigExceptionNotResolved("need to Config::resolve() before freezing a config");
+    }
+    build();
+}
+
+ConfigPtr FrozenConfig::freeze() {
+    return shared_from_this();
+}
+
+uint64_t FrozenConfig::hashKey(const std::string& key) {
+    // FNV-1a, finished with the MurmurHash3 mixer so the high bits are good
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto c : key) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+uint32_t FrozenConfig::slotHash(uint64_t hash, uint32_t seed) {
+    uint64_t h = hash ^ (seed * 0x9e3779b97f4a7c15ULL);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<uint32_t>(h);
+}
+
+uint32_t FrozenConfig::reduce(uint32_t hash, uint32_t n) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(hash) * n) >> 32);
+}
+
+void FrozenConfig::build() {
+    auto entries = entrySet();
+    std::vector<PairStringValue> leaves(entries.begin(), entries.end());
+    uint32_t count = leaves.size();
+    if (count == 0) {
+        return;
+    }
+
+    // about three keys to a bucket, each bucket gets a seed that places all
+    // of its keys in free slots
+    seeds.resize(count / 3 + 1, 0);
+    slots.resize(count, Slot());
+
+    std::vector<uint64_t> hashes(count);
+    std::vector<std::vector<uint32_t>> buckets(seeds.size());
+    for (uint32_t i = 0; i < count; ++i) {
+        hashes[i] = hashKey(leaves[i].first);
+        buckets[reduce(static_cast<uint32_t>(hashes[i] >> 32), seeds.size())].push_back(i);
+    }
+
+    // place the biggest buckets first, while the table is emptiest
+    std::vector<uint32_t> order(seeds.size());
+    for (uint32_t b = 0; b < order.size(); ++b) {
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    std::vector<bool> taken(count, false);
+    std::vector<uint32_t> placed;
+    for (auto b : order) {
+        auto& bucket = buckets[b];
+        if (bucket.empty()) {
+            break;
+        }
+
+        uint32_t seed = 0;
+        bool fits = false;
+        while (!fits) {
+            if (++seed == 0) {
+                throw ConfigExceptionBugOrBroken("no perfect hash for frozen config");
+            }
+            placed.clear();
+            fits = true;
+            for (auto i : bucket) {
+                uint32_t slot = reduce(slotHash(hashes[i], seed), count);
+                if (taken[slot] || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                    fits = false;
+                    break;
+                }
+                placed.push_back(slot);
+            }
+        }
+        seeds[b] = seed;
+
+        for (uint32_t k = 0; k < bucket.size(); ++k) {
+            taken[placed[k]] = true;
+
+            auto& leaf = leaves[bucket[k]];
+            auto& slot = slots[placed[k]];
+            slot.keyOffset = arena.size();
+            slot.keyLength = leaf.first.length();
+            arena += leaf.first;
+
+            slot.type = leaf.second->valueType();
+            if (slot.type == ConfigValueType::NUMBER) {
+                auto number = std::dynamic_pointer_cast<ConfigNumber>(leaf.second);
+                slot.int64Value = number->int64Value();
+                slot.doubleValue = number->doubleValue();
+            }
+            else if (slot.type == ConfigValueType::BOOLEAN) {
+                slot.int64Value = leaf.second->unwrapped<bool>() ? 1 : 0;
+            }
+            else if (slot.type == ConfigValueType::STRING) {
+                std::string s = leaf.second->unwrapped<std::string>();
+                slot.int64Value = arena.size();
+                slot.stringLength = s.length();
+                arena += s;
+            }
+        }
+    }
+}
+
+const FrozenConfig::Slot* FrozenConfig::lookup(const std::string& path) {
+    if (slots.empty()) {
+        return nullptr;
+    }
+    uint64_t hash = hashKey(path);
+    uint32_t seed = seeds[reduce(static_cast<uint32_t>(hash >> 32), seeds.size())];
+    auto& slot = slots[reduce(slotHash(hash, seed), slots.size())];
+    if (slot.keyLength == path.length() && std::memcmp(arena.data() + slot.keyOffset, path.data(), path.length()) == 0) {
+        return &slot;
+    }
+    return nullptr;
+}
+
+uint32_t FrozenConfig::size() {
+    return slots.size();
+}
+
+bool FrozenConfig::hasPath(const std::string& path) {
+    return lookup(path) || SimpleConfig::hasPath(ConfigPath::parse(path));
+}
+
+bool FrozenConfig::hasPath(const ConfigPathPtr& path) {
+    return lookup(path->expression()) || SimpleConfig::hasPath(path);
+}
+
+bool FrozenConfig::getBoolean(const std::string& path) {
+    auto slot = lookup(path);
+    if (slot && slot->type == ConfigValueType::BOOLEAN) {
+        return slot->int64Value != 0;
+    }
+    return SimpleConfig::getBoolean(ConfigPath::parse(path));
+}
+
+bool FrozenConfig::getBoolean(const ConfigPathPtr& path) {
+    auto slot = lookup(path->expression());
+    if (slot && slot->type == ConfigValueType::BOOLEAN) {
+        return slot->int64Value != 0;
+    }
+    return SimpleConfig::getBoolean(path);
+}
+
+int32_t FrozenConfig::getInt(const std::string& path) {
+    // out of range values go the long way round for the exception
+    auto slot = lookup(path);
+    if (slot && slot->type == ConfigValueType::NUMBER && slot->int64Value == static_cast<int32_t>(slot->int64Value)) {
+        return static_cast<int32_t>(slot->int64Value);
+    }
+    return SimpleConfig::getInt(ConfigPath::parse(path));
+}
+
+int32_t FrozenConfig::getInt(const ConfigPathPtr& path) {
+    auto slot = lookup(path->expression());
+    if (slot && slot->type == ConfigValueType::NUMBER && slot->int64Value == static_cast<int32_t>(slot->int64Value)) {
+        return static_cast<int32_t>(slot->int64Value);
+    }
+    return SimpleConfig::getInt(path);
+}
+
+int64_t FrozenConfig::getInt64(const std::string& path) {
+    auto slot = lookup(path);
+    if (slot && slot->type == ConfigValueType::NUMBER) {
+        return slot->int64Value;
+    }
+    return SimpleConfig::getInt64(ConfigPath::parse(path));
+}
+
+int64_t FrozenConfig::getInt64(const ConfigPathPtr& path) {
+    auto slot = lookup(path->expression());
+    if (slot && slot->type == ConfigValueType::NUMBER) {
+        return slot->int64Value;
+    }
+    return SimpleConfig::getInt64(path);
+}
+
+double FrozenConfig::getDouble(const std::string& path) {
+    auto slot = lookup(path);
+    if (slot && slot->type == ConfigValueType::NUMBER) {
+        return slot->doubleValue;
+    }
+    return SimpleConfig::getDouble(ConfigPath::parse(path));
+}
+
+double FrozenConfig::getDouble(const ConfigPathPtr& path) {
+    auto slot = lookup(path->expression());
+    if (slot && slot->type == ConfigValueType::NUMBER) {
+        return slot->doubleValue;
+    }
+    return SimpleConfig::getDouble(path);
+}
+
+std::string FrozenConfig::getString(const std::string& path) {
+    auto slot = lookup(path);
+    if (slot && slot->type == ConfigValueType::STRING) {
+        return arena.substr(slot->int64Value, slot->stringLength);
+    }
+    return SimpleConfig::getString(ConfigPath::parse(path));
+}
+
+std::string FrozenConfig::getString(const ConfigPathPtr& path) {
+    auto slot = lookup(path->expression());
+    if (slot && slot->type == ConfigValueType::STRING) {
+        return arena.substr(slot->int64Value, slot->stringLength);
+    }
+    return SimpleConfig::getString(path);
+}
+
+}
@@ -0,0 +1,311 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/detail/json_parser.h"
+#include "configcpp/detail/parser.h"
+#include "configcpp/detail/tokenizer.h"
+#include "configcpp/detail/chunk_reader.h"
+#include "configcpp/detail/string_reader.h"
+#include "configcpp/detail/char_scanner.h"
+#include "configcpp/detail/number_parser.h"
+#include "configcpp/detail/simple_config_origin.h"
+#include "configcpp/detail/simple_config_object.h"
+#include "configcpp/detail/simple_config_list.h"
+#include "configcpp/detail/config_string.h"
+#include "configcpp/detail/config_number.h"
+#include "configcpp/detail/config_boolean.h"
+#include "configcpp/detail/config_null.h"
+#include "configcpp/config_parse_options.h"
+#include "configcpp/config_origin_detail.h"
+#include "configcpp/config_syntax.h"
+#include "configcpp/config_exception.h"
+
+namespace config {
+
+JsonParser::JsonParser(const ConfigOriginPtr& origin, const char* begin, const char* end, ConfigOriginDetail originDetail) :
+    origin_(std::dynamic_pointer_cast<SimpleConfigOrigin>(origin)),
+    position(begin),
+    end(end),
+    keepLines(originDetail != ConfigOriginDetail::FILE),
+    lineNumber(1) {
+}
+
+AbstractConfigValuePtr JsonParser::parse(const ChunkReaderPtr& input, const ConfigOriginPtr& origin, const ConfigParseOptionsPtr& options, const ConfigIncludeContextPtr& includeContext) {
+    std::string buffer;
+    const char* begin;
+    const char* end;
+    try {
+        input->readRemaining(buffer, begin, end);
+    }
+    catch (ConfigExceptionIO& e) {
+        throw ConfigExceptionIO(origin, std::string("read error: ") + e.what());
+    }
+
+    auto result = make_instance(origin, begin, end, options->getOriginDetail())->parseDocument();
+    if (result) {
+        return result;
+    }
+
+    // the general parser reports the error, or copes with whatever
+    // the fast path doesn't handle
+    auto tokens = Tokenizer::tokenize(origin, StringReader::make_instance(begin, end),
+                                      ConfigSyntax::JSON, options->getOriginDetail());
+    return Parser::parse(tokens, origin, options, includeContext);
+}
+
+AbstractConfigValuePtr JsonParser::parseDocument() {
+    skipWhitespace();
+    if (position == end || (*position != '{' && *position != '[')) {
+        return nullptr;
+    }
+    auto result = parseValue();
+    if (!result) {
+        return nullptr;
+    }
+    skipWhitespace();
+    return position == end ? result : nullptr;
+}
+
+AbstractConfigValuePtr JsonParser::parseValue() {
+    if (position == end) {
+        return nullptr;
+    }
+    switch (*position) {
+        case '{':
+            return parseObject();
+        case '[':
+            return parseArray();
+        case '"': {
+                int32_t line = lineNumber;
+                std::string s;
+                if (!parseString(s)) {
+                    return nullptr;
+                }
+                return atLine(ConfigString::make_instance(origin_, s), line);
+            }
+        case 't':
+        case 'f':
+        case 'n':
+            return parseLiteral();
+        default:
+            return parseNumber();
+    }
+}
+
+AbstractConfigValuePtr JsonParser::parseObject() {
+    // invoked on the OPEN_CURLY
+    int32_t line = lineNumber;
+    ++position;
+    MapAbstractConfigValue values;
+
+    skipWhitespace();
+    if (position != end && *position == '}') {
+        ++position;
+        return atLine(SimpleConfigObject::make_instance(origin_, values), line);
+    }
+
+    while (true) {
+        std::string key;
+        if (position == end || *position != '"' || !parseString(key)) {
+            return nullptr;
+        }
+        skipWhitespace();
+        if (position == end || *position != ':') {
+            return nullptr;
+        }
+        ++position;
+        skipWhitespace();
+        auto value = parseValue();
+        // duplicate fields are an error in JSON
+        if (!value || !values.insert(std::make_pair(InternedString(key, ConfigMemoryScope::current()), value)).second) {
+            return nullptr;
+        }
+
+        skipWhitespace();
+        if (position == end) {
+            return nullptr;
+        }
+        else if (*position == ',') {
+            ++position;
+            skipWhitespace();
+        }
+        else if (*position == '}') {
+            ++position;
+            return atLine(SimpleConfigObject::make_instance(origin_, values), line);
+        }
+        else {
+            return nullptr;
+        }
+    }
+}
+
+AbstractConfigValuePtr JsonParser::parseArray() {
+    // invoked on the OPEN_SQUARE
+    int32_t line = lineNumber;
+    ++position;
+    VectorAbstractConfigValue values;
+
+    skipWhitespace();
+    if (position != end && *position == ']') {
+        ++position;
+        return atLine(SimpleConfigList::make_instance(origin_, values), line);
+    }
+
+    while (true) {
+        auto value = parseValue();
+        if (!value) {
+            return nullptr;
+        }
+        values.push_back(value);
+
+        skipWhitespace();
+        if (position == end) {
+            return nullptr;
+        }
+        else if (*position == ',') {
+            ++position;
+            skipWhitespace();
+        }
+        else if (*position == ']') {
+            ++position;
+            return atLine(SimpleConfigList::make_instance(origin_, values), line);
+        }
+        else {
+            return nullptr;
+        }
+    }
+}
+
+AbstractConfigValuePtr JsonParser::parseNumber() {
+    // same runs of characters as TokenStream::pullNumber()
+    const char* start = position;
+    if (*position != '-' && (*position < '0' || *position > '9')) {
+        return nullptr;
+    }
+    bool containedDecimalOrE = false;
+    for (++position; position != end; ++position) {
+        char c = *position;
+        if (c == '.' || c == 'e' || c == 'E') {
+            containedDecimalOrE = true;
+        }
+        else if ((c < '0' || c > '9') && c != '+' && c != '-') {
+            break;
+        }
+    }
+
+    std::string s(start, position);
+    if (containedDecimalOrE) {
+        double value;
+        if (NumberParser::parseDouble(s, value)) {
+            return atLine(ConfigNumber::newNumber(origin_, value, s), lineNumber);
+        }
+    }
+    else {
+        int64_t value;
+        if (NumberParser::parseInt64(s, value)) {
+            return atLine(ConfigNumber::newNumber(origin_, value, s), lineNumber);
+        }
+    }
+    return nullptr;
+}
+
+AbstractConfigValuePtr JsonParser::parseLiteral() {
+    // the tokenizer takes these no matter what follows them; anything
+    // that does follow is left for the caller to reject
+    size_t remaining = static_cast<size_t>(end - position);
+    if (remaining >= 4 && std::memcmp(position, "true", 4) == 0) {
+        position += 4;
+        return atLine(ConfigBoolean::make_instance(origin_, true), lineNumber);
+    }
+    else if (remaining >= 4 && std::memcmp(position, "null", 4) == 0) {
+        position += 4;
+        return atLine(ConfigNull::make_instance(origin_), lineNumber);
+    }
+    else if (remaining >= 5 && std::memcmp(position, "false", 5) == 0) {
+        position += 5;
+        return atLine(ConfigBoolean::make_instance(origin_, false), lineNumber);
+    }
+    return nullptr;
+}
+
+bool JsonParser::parseString(std::string& s) {
+    // invoked on the open quote; same escapes as TokenStream::pullEscapeSequence()
+    ++position;
+    while (true) {
+        const char* start = position;
+        position = CharScanner::findQuotedStop(position, end);
+        s.append(start, position);
+        if (position == end) {
+            return false;
+        }
+
+        char c = *position++;
+        if (c == '"') {
+            break;
+        }
+        else if (c != '\\' || position == end) {
+            // control characters are an error
+            return false;
+        }
+
+        char escaped = *position++;
+        switch (escaped) {
+            case '"':
+            case '\\':
+            case '/':
+                s += escaped;
+                break;
+            case 'b':
+                s += '\b';
+                break;
+            case 'f':
+                s += '\f';
+                break;
+            case 'n':
+                s += '\n';
+                break;
+            case 'r':
+                s += '\r';
+                break;
+            case 't':
+                s += '\t';
+                break;
+            case 'u': {
+                    if (end - position < 4) {
+                        return false;
+                    }
+                    std::string digits(position, position + 4);
+                    position += 4;
+                    s += static_cast<char>(strtol(digits.c_str(), 0, 16));
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+
+    // an empty string followed by a quote starts a triple-quoted string
+    return !(s.empty() && position != end && *position == '"');
+}
+
+void JsonParser::skipWhitespace() {
+    while (position != end) {
+        position = CharScanner::skipWhitespace(position, end);
+        if (position == end || *position != '\n') {
+            return;
+        }
+        ++position;
+        ++lineNumber;
+    }
+}
+
+AbstractConfigValuePtr JsonParser::atLine(const AbstractConfigValuePtr& value, int32_t lineNumber) {
+    if (keepLines) {
+        value->setOriginLine(lineNumber);
+    }
+    return value;
+}
+
+}
@@ -0,0 +1,165 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/detail/lexeme.h"
+#include "configcpp/detail/token.h"
+#include "configcpp/detail/tokens.h"
+#include "configcpp/detail/abstract_config_value.h"
+#include "configcpp/detail/config_string.h"
+#include "configcpp/detail/config_number.h"
+#include "configcpp/detail/config_null.h"
+#include "configcpp/detail/config_boolean.h"
+#include "configcpp/config_value_type.h"
+#include "configcpp/config_exception.h"
+
+namespace config {
+
+Lexeme::Lexeme(TokenType type) :
+    type(type),
+    line(-1),
+    valueType(ConfigValueType::STRING),
+    intValue(0),
+    doubleValue(0.0),
+    isDouble(false),
+    booleanValue(false),
+    optional(false),
+    quoted(false) {
+}
+
+void Lexeme::reset(TokenType type, int32_t line) {
+    this->type = type;
+    this->line = line;
+    text.clear();
+    value.reset();
+    token.reset();
+}
+
+Lexeme Lexeme::fromToken(const TokenPtr& token) {
+    Lexeme lexeme(token->tokenType());
+    lexeme.token = token;
+    switch (lexeme.type) {
+        case TokenType::NEWLINE:
+            lexeme.line = token->lineNumber();
+            break;
+        case TokenType::VALUE:
+            lexeme.value = Tokens::getValue(token);
+            break;
+        case TokenType::UNQUOTED_TEXT:
+            lexeme.line = token->originLine();
+            lexeme.text = Tokens::getUnquotedText(token);
+            break;
+        case TokenType::COMMENT:
+            lexeme.text = Tokens::getCommentText(token);
+            break;
+        default:
+            lexeme.line = token->originLine();
+            break;
+    }
+    return lexeme;
+}
+
+TokenPtr Lexeme::toToken(const ConfigOriginPtr& baseOrigin) const {
+    if (token) {
+        return token;
+    }
+    TokenPtr t;
+    switch (type) {
+        case TokenType::START:
+            return Tokens::START();
+        case TokenType::END:
+            return Tokens::END();
+        case TokenType::COMMA:
+            return Tokens::COMMA();
+        case TokenType::EQUALS:
+            return Tokens::EQUALS();
+        case TokenType::COLON:
+            return Tokens::COLON();
+        case TokenType::OPEN_CURLY:
+            return Tokens::OPEN_CURLY();
+        case TokenType::CLOSE_CURLY:
+            return Tokens::CLOSE_CURLY();
+        case TokenType::OPEN_SQUARE:
+            return Tokens::OPEN_SQUARE();
+        case TokenType::CLOSE_SQUARE:
+            return Tokens::CLOSE_SQUARE();
+        case TokenType::PLUS_EQUALS:
+            return Tokens::PLUS_EQUALS();
+        case TokenType::NEWLINE:
+            t = Tokens::newLine(baseOrigin);
+            break;
+        case TokenType::UNQUOTED_TEXT:
+            t = Tokens::newUnquotedText(baseOrigin, text);
+            break;
+        case TokenType::COMMENT:
+            t = Tokens::newComment(baseOrigin, text);
+            break;
+        case TokenType::SUBSTITUTION: {
+            Lexeme key(quoted ? TokenType::VALUE : TokenType::UNQUOTED_TEXT);
+            key.line = line;
+            key.text = text;
+            t = Tokens::newSubstitution(baseOrigin, optional, VectorToken(1, key.toToken(baseOrigin)));
+            break;
+        }
+        case TokenType::VALUE:
+            // the value carries the line
+            return Tokens::newValue(toValue(baseOrigin));
+        default:
+            throw ConfigExceptionBugOrBroken("lexeme of type " + TokenTypeEnum::name(type) + " has no token");
+    }
+    t->setOriginLine(line);
+    return t;
+}
+
+bool Lexeme::isValue() const {
+    return type == TokenType::VALUE;
+}
+
+bool Lexeme::isValueWithType(ConfigValueType valueType) const {
+    if (type != TokenType::VALUE) {
+        return false;
+    }
+    return value ? value->valueType() == valueType : this->valueType == valueType;
+}
+
+AbstractConfigValuePtr Lexeme::toValue(const ConfigOriginPtr& baseOrigin) const {
+    if (value) {
+        return value;
+    }
+    AbstractConfigValuePtr v;
+    switch (valueType) {
+        case ConfigValueType::STRING:
+            v = ConfigString::make_instance(baseOrigin, text);
+            break;
+        case ConfigValueType::NUMBER:
+            if (isDouble) {
+                v = ConfigNumber::newNumber(baseOrigin, doubleValue, text);
+            }
+            else {
+                v = ConfigNumber::newNumber(baseOrigin, intValue, text);
+            }
+            break;
+        case ConfigValueType::BOOLEAN:
+            v = ConfigBoolean::make_instance(baseOrigin, booleanValue);
+            break;
+        case ConfigValueType::NONE:
+            v = ConfigNull::make_instance(baseOrigin);
+            break;
+        default:
+            throw ConfigExceptionBugOrBroken("bug: lexeme has no value of type " + ConfigValueTypeEnum::name(valueType));
+    }
+    v->setOriginLine(line);
+    return v;
+}
+
+std::string Lexeme::stringValue() const {
+    return value ? value->transformToString() : text;
+}
+
+std::string Lexeme::toString() const {
+    // only for error messages, so it doesn't matter that this makes a token
+    return toToken(nullptr)->toString();
+}
+
+}
@@ -0,0 +1,123 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/detail/mapped_file_reader.h"
+#include "configcpp/config_exception.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace config {
+
+MappedFileReader::MappedFileReader(const std::string& file) :
+    fd(::open(file.c_str(), O_RDONLY)),
+    data(nullptr),
+    size(0),
+    position(0),
+    mapped_(false) {
+    if (fd == -1) {
+        throw ConfigExceptionFileNotFound(file);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            ::madvise(mapping, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+            size = static_cast<size_t>(info.st_size);
+            mapped_ = true;
+            // the mapping keeps the file contents alive
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    if (!mapped_) {
+        buffer.resize(BUFFER_SIZE);
+        data = buffer.data();
+    }
+}
+
+MappedFileReader::~MappedFileReader() {
+    close();
+}
+
+int32_t MappedFileReader::read() {
+    if (position >= size) {
+        if (mapped_ || !fillBuffer()) {
+            return READER_EOF;
+        }
+    }
+    return static_cast<int32_t>(data[position++]);
+}
+
+bool MappedFileReader::readChunk(const char*& begin, const char*& end) {
+    if (position >= size) {
+        if (mapped_ || !fillBuffer()) {
+            begin = end = data;
+            return false;
+        }
+    }
+    begin = data + position;
+    end = data + size;
+    position = size;
+    return true;
+}
+
+void MappedFileReader::readRemaining(std::string& buffer, const char*& begin, const char*& end) {
+    if (!mapped_) {
+        ChunkReader::readRemaining(buffer, begin, end);
+        return;
+    }
+    begin = data + position;
+    end = data + size;
+    position = size;
+}
+
+bool MappedFileReader::mapped() {
+    return mapped_;
+}
+
+bool MappedFileReader::fillBuffer() {
+    if (fd == -1) {
+        return false;
+    }
+    while (true) {
+        ssize_t count = ::read(fd, buffer.data(), buffer.size());
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        size = static_cast<size_t>(count);
+        position = 0;
+        return true;
+    }
+}
+
+void MappedFileReader::unmap() {
+    if (mapped_) {
+        ::munmap(const_cast<char*>(data), size);
+        mapped_ = false;
+    }
+}
+
+void MappedFileReader::close() {
+    unmap();
+    if (fd != -1) {
+        ::close(fd);
+        fd = -1;
+    }
+    data = nullptr;
+    size = 0;
+    position = 0;
+}
+
+}
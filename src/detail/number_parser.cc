@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/detail/number_parser.h"
+#include <cfloat>
+
+namespace config {
+
+bool NumberParser::parseInt64(const std::string& s, int64_t& value) {
+    const char* p = s.data();
+    const char* end = p + s.length();
+    bool negative = p != end && *p == '-';
+    if (p != end && (*p == '-' || *p == '+')) {
+        ++p;
+    }
+    if (p == end) {
+        return false;
+    }
+    // accumulate as unsigned so that the most negative value fits
+    const uint64_t max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    const uint64_t limit = negative ? max + 1 : max;
+    uint64_t result = 0;
+    for (; p != end; ++p) {
+        uint32_t digit = static_cast<uint32_t>(static_cast<uint8_t>(*p)) - '0';
+        if (digit > 9) {
+            return false;
+        }
+        if (result > (limit - digit) / 10) {
+            return false; // overflow
+        }
+        result = result * 10 + digit;
+    }
+    value = negative ? static_cast<int64_t>(0 - result) : static_cast<int64_t>(result);
+    return true;
+}
+
+bool NumberParser::parseDouble(const std::string& s, double& value) {
+    // exact powers of ten for the fast path; 10^22 is the largest that fits
+    // in a double's 53 bit mantissa
+    static const double powersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    static const uint64_t maxExactMantissa = static_cast<uint64_t>(1) << 53;
+
+    // The grammar lexical_cast (via std::num_get) accepts:
+    //   [+-] (digits [. digits*] | . digits) [(e|E) [+-] digits]
+    // plus inf, infinity and nan, which are left to the slow path.
+    const char* p = s.data();
+    const char* end = p + s.length();
+    bool negative = p != end && *p == '-';
+    if (p != end && (*p == '-' || *p == '+')) {
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    uint32_t significantDigits = 0;
+    int32_t exponent = 0;
+    bool foundMantissa = false;
+    for (; p != end && static_cast<uint8_t>(*p - '0') <= 9; ++p) {
+        foundMantissa = true;
+        if (mantissa != 0 || *p != '0') {
+            if (significantDigits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint32_t>(*p - '0');
+            }
+            else {
+                ++exponent; // digit dropped, exactness is checked below
+            }
+            ++significantDigits;
+        }
+    }
+    if (p != end && *p == '.') {
+        for (++p; p != end && static_cast<uint8_t>(*p - '0') <= 9; ++p) {
+            foundMantissa = true;
+            if (mantissa != 0 || *p != '0') {
+                if (significantDigits < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint32_t>(*p - '0');
+                    --exponent;
+                }
+                ++significantDigits;
+            }
+            else {
+                --exponent;
+            }
+        }
+    }
+    if (!foundMantissa) {
+        return p != end && (*p == 'i' || *p == 'I' || *p == 'n' || *p == 'N') && parseDoubleSlow(s, value);
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = p != end && *p == '-';
+        if (p != end && (*p == '-' || *p == '+')) {
+            ++p;
+        }
+        if (p == end) {
+            return false;
+        }
+        int32_t explicitExponent = 0;
+        for (; p != end; ++p) {
+            uint32_t digit = static_cast<uint32_t>(static_cast<uint8_t>(*p)) - '0';
+            if (digit > 9) {
+                return false;
+            }
+            if (explicitExponent < 100000) {
+                explicitExponent = explicitExponent * 10 + static_cast<int32_t>(digit);
+            }
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if (p != end) {
+        return false;
+    }
+
+    // Clinger's fast path: an exactly representable mantissa scaled by an
+    // exactly representable power of ten needs a single, correctly rounded
+    // multiply or divide, which gives the same result as strtod. This needs
+    // plain double arithmetic (not x87 extended precision).
+    if (FLT_EVAL_METHOD == 0) {
+        if (mantissa == 0) {
+            value = negative ? -0.0 : 0.0;
+            return true;
+        }
+        if (significantDigits <= 19 && mantissa <= maxExactMantissa && exponent >= -22 && exponent <= 22) {
+            double result = static_cast<double>(mantissa);
+            result = exponent < 0 ? result / powersOfTen[-exponent] : result * powersOfTen[exponent];
+            value = negative ? -result : result;
+            return true;
+        }
+    }
+    return parseDoubleSlow(s, value);
+}
+
+bool NumberParser::parseDoubleSlow(const std::string& s, double& value) {
+    try {
+        value = boost::lexical_cast<double>(s);
+        return true;
+    }
+    catch (boost::bad_lexical_cast&) {
+        return false;
+    }
+}
+
+}
@@ -5,6 +5,7 @@
 
 #include "configcpp/detail/parseable.h"
 #include "configcpp/detail/config_impl.h"
+#include "configcpp/detail/config_arena.h"
 #include "configcpp/detail/simple_includer.h"
 #include "configcpp/detail/simple_include_context.h"
 #include "configcpp/detail/simple_config_origin.h"
@@ -12,8 +13,10 @@
 #include "configcpp/detail/abstract_config_object.h"
 #include "configcpp/detail/tokenizer.h"
 #include "configcpp/detail/parser.h"
+#include "configcpp/detail/json_parser.h"
+#include "configcpp/detail/chunk_reader.h"
 #include "configcpp/detail/string_reader.h"
-#include "configcpp/detail/file_reader.h"
+#include "configcpp/detail/mapped_file_reader.h"
 #include "configcpp/config_syntax.h"
 #include "configcpp/config_value.h"
 #include "configcpp/config_value_type.h"
@@ -52,8 +55,6 @@ ConfigParseOptionsPtr Parseable::fixupOptions(const ConfigParseOptionsPtr& baseO
 void Parseable::postConstruct(const ConfigParseOptionsPtr& baseOptions) {
     this->initialOptions = fixupOptions(baseOptions);
 
-    this->includeContext_ = SimpleIncludeContext::make_instance(shared_from_this());
-
     std::string originDescription = initialOptions->getOriginDescription();
     if (!originDescription.empty()) {
         initialOrigin = SimpleConfigOrigin::newSimple(originDescription);
@@ -78,7 +79,10 @@ ConfigParseablePtr Parseable::relativeTo(const std::string& filename) {
 }
 
 ConfigIncludeContextPtr Parseable::includeContext() {
-    return includeContext_;
+    // made on demand: a context kept here would keep this alive through the
+    // context's reference back, along with the origin and any memory
+    // resource it came from
+    return SimpleIncludeContext::make_instance(shared_from_this());
 }
 
 AbstractConfigObjectPtr Parseable::forceParsedToObject(const ConfigValuePtr& value) {
@@ -143,6 +147,7 @@ AbstractConfigValuePtr Parseable::parseValue(const ConfigParseOptionsPtr& baseOp
 }
 
 AbstractConfigValuePtr Parseable::parseValue(const ConfigOriginPtr& origin, const ConfigParseOptionsPtr& finalOptions) {
+    ConfigMemoryScope memory(ConfigArena::forOptions(finalOptions->getUseArena(), finalOptions->getMemoryResource()));
     try {
         return rawParseValue(origin, finalOptions);
     }
@@ -177,7 +182,10 @@ AbstractConfigValuePtr Parseable::rawParseValue(const ConfigOriginPtr& origin, c
 }
 
 AbstractConfigValuePtr Parseable::rawParseValue(const ReaderPtr& reader, const ConfigOriginPtr& origin, const ConfigParseOptionsPtr& finalOptions) {
-    auto tokens = Tokenizer::tokenize(origin, reader, finalOptions->getSyntax());
+    if (finalOptions->getSyntax() == ConfigSyntax::JSON) {
+        return JsonParser::parse(ReaderChunkAdapter::adapt(reader), origin, finalOptions, includeContext());
+    }
+    auto tokens = Tokenizer::tokenize(origin, reader, finalOptions->getSyntax(), finalOptions->getOriginDetail());
     return Parser::parse(tokens, origin, finalOptions, includeContext());
 }
 
@@ -277,7 +285,8 @@ ReaderPtr ParseableString::reader() {
     if (ConfigImpl::traceLoadsEnabled()) {
         trace("Loading config from a string: " + input);
     }
-    return StringReader::make_instance(input);
+    // the reader never outlives this parseable, so read from input in place
+    return StringReader::make_instance(input.data(), input.data() + input.length());
 }
 
 ConfigOriginPtr ParseableString::createOrigin() {
@@ -301,7 +310,7 @@ ReaderPtr ParseableFile::reader() {
     if (ConfigImpl::traceLoadsEnabled()) {
         trace("Loading config from a file: " + input);
     }
-    return FileReader::make_instance(input);
+    return MappedFileReader::make_instance(input);
 }
 
 ConfigSyntax ParseableFile::guessSyntax() {
@@ -11,6 +11,7 @@
 #include "configcpp/detail/simple_config_list.h"
 #include "configcpp/detail/tokens.h"
 #include "configcpp/detail/token.h"
+#include "configcpp/detail/token_type.h"
 #include "configcpp/detail/tokenizer.h"
 #include "configcpp/detail/config_string.h"
 #include "configcpp/detail/config_reference.h"
@@ -21,130 +22,207 @@
 #include "configcpp/detail/string_reader.h"
 #include "configcpp/config_parse_options.h"
 #include "configcpp/config_syntax.h"
+#include "configcpp/config_origin_detail.h"
 #include "configcpp/config_value_type.h"
 
 namespace config {
 
 AbstractConfigValuePtr Parser::parse(const TokenIteratorPtr& tokens, const ConfigOriginPtr& origin, const ConfigParseOptionsPtr& options, const ConfigIncludeContextPtr& includeContext) {
-    auto context = ParseContext::make_instance(options->getSyntax(), origin, tokens, SimpleIncluder::makeFull(options->getIncluder()), includeContext);
+    auto context = ParseContext::make_instance(options->getSyntax(), options->getOriginDetail(), origin, tokens, SimpleIncluder::makeFull(options->getIncluder()), includeContext);
     return context->parse();
 }
 
-TokenWithComments::TokenWithComments(const TokenPtr& token, const VectorToken& comments) :
-    token(token),
-    comments(comments) {
+TokenWithComments::TokenWithComments(Lexeme token, VectorString comments) :
+    token(std::move(token)),
+    comments(std::move(comments)) {
 }
 
-TokenWithCommentsPtr TokenWithComments::prepend(const VectorToken& earlier) {
-    if (comments.empty()) {
-        return TokenWithComments::make_instance(token, earlier);
-    }
-    else {
-        VectorToken merged(earlier);
-        merged.insert(merged.end(), comments.begin(), comments.end());
-        return TokenWithComments::make_instance(token, merged);
+void TokenWithComments::prepend(const VectorString& earlier) {
+    if (!earlier.empty()) {
+        comments.insert(comments.begin(), earlier.begin(), earlier.end());
     }
 }
 
-SimpleConfigOriginPtr TokenWithComments::setComments(const SimpleConfigOriginPtr& origin) {
+SimpleConfigOriginPtr TokenWithComments::setComments(const SimpleConfigOriginPtr& origin) const {
     if (comments.empty()) {
         return origin;
     }
     else {
-        VectorString newComments;
-        for (auto& c : comments) {
-            newComments.push_back(Tokens::getCommentText(c));
-        }
-        return origin->setComments(newComments);
+        return origin->setComments(comments);
     }
 }
 
-std::string TokenWithComments::toString() {
+std::string TokenWithComments::toString() const {
     // this ends up in user-visible error messages, so we don't want the comments
-    return token->toString();
+    return token.toString();
+}
+
+PathExpression::PathExpression(const ConfigOriginPtr& origin, int32_t line, const std::string& originalText) :
+    origin(origin),
+    line(line),
+    originalText(originalText),
+    keys_(1),
+    canBeEmpty(false),
+    haveEmptyKey(false) {
+}
+
+void PathExpression::add(const Lexeme& t) {
+    if (t.isValueWithType(ConfigValueType::STRING)) {
+        // this is a quoted string; so any periods
+        // in here don't count as path separators
+        if (t.value) {
+            add(true, t.value->transformToString());
+        }
+        else {
+            add(true, t.text);
+        }
+    }
+    else if (t.type == TokenType::VALUE || t.type == TokenType::UNQUOTED_TEXT) {
+        // any periods outside of a quoted string count as
+        // separators. Appending a number here may add
+        // a period, but we _do_ count those as path
+        // separators, because we basically want
+        // "foo 3.0bar" to parse as a string even
+        // though there's a number in it. The fact that
+        // we tokenize non-string values is largely an
+        // implementation detail.
+        if (t.value) {
+            add(false, t.value->transformToString());
+        }
+        else {
+            add(false, t.text);
+        }
+    }
+    else {
+        throw badPath("Token not allowed in path expression: " + t.toString() +
+                      " (you can double-quote this token if you really want it here)");
+    }
+}
+
+void PathExpression::add(bool wasQuoted, const std::string& text) {
+    std::string::size_type start = 0;
+    std::string::size_type i = wasQuoted ? std::string::npos : text.find('.');
+    while (i != std::string::npos) {
+        // the current key plus up to the period is a key,
+        // then the rest starts a new one
+        keys_.back().append(text, start, i - start);
+        endKey();
+        keys_.emplace_back();
+        start = i + 1;
+        i = text.find('.', start);
+    }
+    keys_.back().append(text, start, std::string::npos);
+    // any empty quoted string means this key can now be empty.
+    if (wasQuoted && keys_.back().empty()) {
+        canBeEmpty = true;
+    }
 }
 
-ParseContext::ParseContext(ConfigSyntax flavor, const ConfigOriginPtr& origin, const TokenIteratorPtr& tokens, const FullIncluderPtr& includer, const ConfigIncludeContextPtr& includeContext) :
+void PathExpression::endKey() {
+    if (keys_.back().empty() && !canBeEmpty) {
+        haveEmptyKey = true;
+    }
+    canBeEmpty = false;
+}
+
+VectorString PathExpression::keys() {
+    endKey();
+    if (haveEmptyKey) {
+        throw badPath("path has a leading, trailing, or two "
+                      "adjacent period '.' (use quoted \"\" "
+                      "empty string if you want an empty element)");
+    }
+    return std::move(keys_);
+}
+
+PathPtr PathExpression::result() {
+    return Path::make_instance(keys());
+}
+
+ConfigExceptionBadPath PathExpression::badPath(const std::string& message) {
+    auto at = line < 0 ? origin : std::dynamic_pointer_cast<SimpleConfigOrigin>(origin)->setLineNumber(line);
+    return ConfigExceptionBadPath(at, originalText, message);
+}
+
+ParseContext::ParseContext(ConfigSyntax flavor, ConfigOriginDetail originDetail, const ConfigOriginPtr& origin, const TokenIteratorPtr& tokens, const FullIncluderPtr& includer, const ConfigIncludeContextPtr& includeContext) :
     lineNumber(1),
     tokens(tokens),
     includer(includer),
     includeContext(includeContext),
     flavor(flavor),
+    originDetail(originDetail),
     baseOrigin(origin),
     equalsCount(0) {
 }
 
-void ParseContext::consolidateCommentBlock(const TokenPtr& commentToken) {
+void ParseContext::consolidateCommentBlock(Lexeme next) {
     // a comment block "goes with" the following token
     // unless it's separated from it by a blank line.
     // we want to build a list of newline tokens followed
     // by a non-newline non-comment token; with all comments
     // associated with that final non-newline non-comment token.
-    VectorToken newlines;
-    VectorToken comments;
+    std::vector<int32_t> newlines;
+    VectorString comments;
 
-    TokenPtr previous;
-    auto next = commentToken;
+    bool previousWasNewline = false;
     while (true) {
-        if (Tokens::isNewline(next)) {
-            if (previous && Tokens::isNewline(previous)) {
+        if (next.type == TokenType::NEWLINE) {
+            if (previousWasNewline) {
                 // blank line; drop all comments to this point and
                 // start a new comment block
                 comments.clear();
             }
-            newlines.push_back(next);
+            newlines.push_back(next.line);
+            previousWasNewline = true;
         }
-        else if (Tokens::isComment(next)) {
-            comments.push_back(next);
+        else if (next.type == TokenType::COMMENT) {
+            comments.push_back(next.text);
+            previousWasNewline = false;
         }
         else {
             // a non-newline non-comment token
             break;
         }
 
-        previous = next;
-        next = tokens->next();
+        tokens->nextLexeme(next);
     }
 
     // put our concluding token in the queue with all the comments attached
-    buffer.push_front(TokenWithComments::make_instance(next, comments));
+    buffer.push_back(TokenWithComments(std::move(next), std::move(comments)));
 
     // now put all the newlines back in front of it
     for (auto li = newlines.rbegin(); li != newlines.rend(); ++li) {
-        buffer.push_front(TokenWithComments::make_instance(*li));
+        Lexeme newline(TokenType::NEWLINE);
+        newline.line = *li;
+        buffer.push_back(TokenWithComments(std::move(newline)));
     }
 }
 
-TokenWithCommentsPtr ParseContext::popToken() {
+TokenWithComments ParseContext::popToken() {
     if (buffer.empty()) {
-        auto t = tokens->next();
-        if (Tokens::isComment(t)) {
-            consolidateCommentBlock(t);
-            auto token = buffer.front();
-            buffer.pop_front();
-            return token;
+        TokenWithComments t;
+        tokens->nextLexeme(t.token);
+        if (t.token.type != TokenType::COMMENT) {
+            // the common case: straight from the lexer, no comments
+            return t;
         }
-        else {
-            return TokenWithComments::make_instance(t);
-        }
-    }
-    else {
-        auto token = buffer.front();
-        buffer.pop_front();
-        return token;
+        consolidateCommentBlock(std::move(t.token));
     }
+    TokenWithComments token = std::move(buffer.back());
+    buffer.pop_back();
+    return token;
 }
 
-TokenWithCommentsPtr ParseContext::nextToken() {
+TokenWithComments ParseContext::nextToken() {
     auto withComments = popToken();
-    auto t = withComments->token;
+    auto& t = withComments.token;
 
-    if (Tokens::isProblem(t)) {
-        auto origin = t->origin();
-        std::string message = Tokens::getProblemMessage(t);
-        bool suggestQuotes = Tokens::getProblemSuggestQuotes(t);
+    if (t.type == TokenType::PROBLEM) {
+        auto origin = t.token->origin();
+        std::string message = Tokens::getProblemMessage(t.token);
+        bool suggestQuotes = Tokens::getProblemSuggestQuotes(t.token);
         if (suggestQuotes) {
-            message = addQuoteSuggestion(t->toString(), message);
+            message = addQuoteSuggestion(t.token->toString(), message);
         }
         else {
             message = addKeyName(message);
@@ -153,11 +231,10 @@ TokenWithCommentsPtr ParseContext::nextToken() {
     }
     else {
         if (flavor == ConfigSyntax::JSON) {
-            if (Tokens::isUnquotedText(t)) {
-                throw parseError(addKeyName("Token not allowed in valid JSON: '" +
-                                 Tokens::getUnquotedText(t) + "'"));
+            if (t.type == TokenType::UNQUOTED_TEXT) {
+                throw parseError(addKeyName("Token not allowed in valid JSON: '" + t.text + "'"));
             }
-            else if (Tokens::isSubstitution(t)) {
+            else if (t.type == TokenType::SUBSTITUTION) {
                 throw parseError(addKeyName("Substitutions (${} syntax) not allowed in JSON"));
             }
         }
@@ -166,17 +243,17 @@ TokenWithCommentsPtr ParseContext::nextToken() {
     }
 }
 
-void ParseContext::putBack(const TokenWithCommentsPtr& token) {
-    buffer.push_front(token);
+void ParseContext::putBack(TokenWithComments token) {
+    buffer.push_back(std::move(token));
 }
 
-TokenWithCommentsPtr ParseContext::nextTokenIgnoringNewline() {
+TokenWithComments ParseContext::nextTokenIgnoringNewline() {
     auto t = nextToken();
 
-    while (Tokens::isNewline(t->token)) {
+    while (t.token.type == TokenType::NEWLINE) {
         // line number tokens have the line that was _ended_ by the
         // newline, so we have to add one.
-        lineNumber = t->token->lineNumber() + 1;
+        lineNumber = t.token.line + 1;
 
         t = nextToken();
     }
@@ -187,11 +264,11 @@ TokenWithCommentsPtr ParseContext::nextTokenIgnoringNewline() {
 bool ParseContext::checkElementSeparator() {
     if (flavor == ConfigSyntax::JSON) {
         auto t = nextTokenIgnoringNewline();
-        if (t->token == Tokens::COMMA()) {
+        if (t.token.type == TokenType::COMMA) {
             return true;
         }
         else {
-            putBack(t);
+            putBack(std::move(t));
             return false;
         }
     }
@@ -199,20 +276,20 @@ bool ParseContext::checkElementSeparator() {
         bool sawSeparatorOrNewline = false;
         auto t = nextToken();
         while (true) {
-            if (Tokens::isNewline(t->token)) {
+            if (t.token.type == TokenType::NEWLINE) {
                 // newline number is the line just ended, so add one
-                lineNumber = t->token->lineNumber() + 1;
+                lineNumber = t.token.line + 1;
                 sawSeparatorOrNewline = true;
 
                 // we want to continue to also eat
                 // a comma if there is one.
             }
-            else if (t->token == Tokens::COMMA()) {
+            else if (t.token.type == TokenType::COMMA) {
                 return true;
             }
             else {
                 // non-newline-or-comma
-                putBack(t);
+                putBack(std::move(t));
                 return sawSeparatorOrNewline;
             }
             t = nextToken();
@@ -220,10 +297,16 @@ bool ParseContext::checkElementSeparator() {
     }
 }
 
-SubstitutionExpressionPtr ParseContext::tokenToSubstitutionExpression(const TokenPtr& valueToken) {
-    auto expression = Tokens::getSubstitutionPathExpression(valueToken);
-    auto path = Parser::parsePathExpression(TokenIterator::make_instance(expression), valueToken->origin());
-    bool optional = Tokens::getSubstitutionOptional(valueToken);
+SubstitutionExpressionPtr ParseContext::substitutionExpression(const Lexeme& t) {
+    if (!t.token) {
+        // the lexer kept the path's one key
+        PathExpression path(baseOrigin, t.line);
+        path.add(t.quoted, t.text);
+        return SubstitutionExpression::make_instance(path.result(), t.optional);
+    }
+    auto expression = Tokens::getSubstitutionPathExpression(t.token);
+    auto path = Parser::parsePathExpression(TokenIterator::make_instance(expression), t.token->origin());
+    bool optional = Tokens::getSubstitutionOptional(t.token);
     return SubstitutionExpression::make_instance(path, optional);
 }
 
@@ -232,26 +315,29 @@ void ParseContext::consolidateValueTokens() {
     if (flavor == ConfigSyntax::JSON)
         return;
 
-    // create only if we have value tokens
-    boost::optional<VectorAbstractConfigValue> values;
-    TokenWithCommentsPtr firstValueWithComments;
+    // create only if we have more than one value token
+    AbstractConfigValuePtr firstValue;
+    VectorAbstractConfigValue values;
+    TokenWithComments firstValueWithComments;
     // ignore a newline up front
     auto t = nextTokenIgnoringNewline();
     while (true) {
         AbstractConfigValuePtr v;
-        if (Tokens::isValue(t->token)) {
+        if (t.token.isValue()) {
             // if we consolidateValueTokens() multiple times then
             // this value could be a concatenation, object, array,
             // or substitution already.
-            v = Tokens::getValue(t->token);
+            v = t.token.toValue(baseOrigin);
         }
-        else if (Tokens::isUnquotedText(t->token)) {
-            v = ConfigString::make_instance(t->token->origin(), Tokens::getUnquotedText(t->token));
+        else if (t.token.type == TokenType::UNQUOTED_TEXT) {
+            v = ConfigString::make_instance(baseOrigin, t.token.text);
+            v->setOriginLine(t.token.line);
         }
-        else if (Tokens::isSubstitution(t->token)) {
-            v = ConfigReference::make_instance(t->token->origin(), tokenToSubstitutionExpression(t->token));
+        else if (t.token.type == TokenType::SUBSTITUTION) {
+            v = ConfigReference::make_instance(t.token.token ? t.token.token->baseOrigin() : baseOrigin, substitutionExpression(t.token));
+            v->setOriginLine(t.token.line);
         }
-        else if (t->token == Tokens::OPEN_CURLY() || t->token == Tokens::OPEN_SQUARE()) {
+        else if (t.token.type == TokenType::OPEN_CURLY || t.token.type == TokenType::OPEN_SQUARE) {
             // there may be newlines _within_ the objects and arrays
             v = parseValue(t);
         }
@@ -263,62 +349,67 @@ void ParseContext::consolidateValueTokens() {
             throw ConfigExceptionBugOrBroken("no value");
         }
 
-        if (!values) {
-            values = VectorAbstractConfigValue();
-            firstValueWithComments = t;
+        if (!firstValue) {
+            firstValue = v;
+            firstValueWithComments = std::move(t);
+        }
+        else {
+            if (values.empty()) {
+                values.push_back(firstValue);
+            }
+            values.push_back(v);
         }
-        values->push_back(v);
 
         t = nextToken(); // but don't consolidate across a newline
     }
     // the last one wasn't a value token
-    putBack(t);
+    putBack(std::move(t));
 
-    if (!values) {
+    if (!firstValue) {
         return;
     }
 
-    auto consolidated = ConfigConcatenation::concatenate(*values);
+    Lexeme consolidated(TokenType::VALUE);
+    consolidated.value = values.empty() ? firstValue : ConfigConcatenation::concatenate(values);
 
-    putBack(TokenWithComments::make_instance(Tokens::newValue(consolidated), firstValueWithComments->comments));
+    putBack(TokenWithComments(std::move(consolidated), std::move(firstValueWithComments.comments)));
 }
 
 ConfigOriginPtr ParseContext::lineOrigin() {
     return std::dynamic_pointer_cast<SimpleConfigOrigin>(baseOrigin)->setLineNumber(lineNumber);
 }
 
+ConfigOriginPtr ParseContext::valueOrigin() {
+    return originDetail == ConfigOriginDetail::FILE ? baseOrigin : lineOrigin();
+}
+
 ConfigExceptionParse ParseContext::parseError(const std::string& message) {
     return ConfigExceptionParse(lineOrigin(), message);
 }
 
-std::string ParseContext::previousFieldName(const PathPtr& lastPath) {
-    if (lastPath) {
-        return lastPath->render();
+std::string ParseContext::previousFieldName(const VectorString& lastPath) {
+    if (!lastPath.empty()) {
+        return Path::make_instance(lastPath)->render();
     }
     else if (pathStack.empty()) {
         return "";
     }
     else {
-        return pathStack.front()->render();
+        return Path::make_instance(pathStack.front())->render();
     }
 }
 
 PathPtr ParseContext::fullCurrentPath() {
-    PathPtr full;
+    VectorString keys;
     // pathStack has top of stack at front
-    for (auto& p : pathStack) {
-        if (!full) {
-            full = p;
-        }
-        else {
-            full = full->prepend(p);
-        }
+    for (auto p = pathStack.rbegin(); p != pathStack.rend(); ++p) {
+        keys.insert(keys.end(), p->begin(), p->end());
     }
-    return full;
+    return keys.empty() ? nullptr : Path::make_instance(std::move(keys));
 }
 
 std::string ParseContext::previousFieldName() {
-    return previousFieldName(nullptr);
+    return previousFieldName(VectorString());
 }
 
 std::string ParseContext::addKeyName(const std::string& message) {
@@ -332,10 +423,10 @@ std::string ParseContext::addKeyName(const std::string& message) {
 }
 
 std::string ParseContext::addQuoteSuggestion(const std::string& badToken, const std::string& message) {
-    return addQuoteSuggestion(nullptr, equalsCount > 0, badToken, message);
+    return addQuoteSuggestion(VectorString(), equalsCount > 0, badToken, message);
 }
 
-std::string ParseContext::addQuoteSuggestion(const PathPtr& lastPath, bool insideEquals, const std::string& badToken, const std::string& message) {
+std::string ParseContext::addQuoteSuggestion(const VectorString& lastPath, bool insideEquals, const std::string& badToken, const std::string& message) {
     std::string previousFieldName_ = previousFieldName(lastPath);
 
     std::string part;
@@ -371,99 +462,97 @@ std::string ParseContext::addQuoteSuggestion(const PathPtr& lastPath, bool insid
     }
 }
 
-AbstractConfigValuePtr ParseContext::parseValue(const TokenWithCommentsPtr& t) {
+AbstractConfigValuePtr ParseContext::parseValue(const TokenWithComments& t) {
     AbstractConfigValuePtr v;
 
-    if (Tokens::isValue(t->token)) {
-        v = Tokens::getValue(t->token);
+    if (t.token.isValue()) {
+        v = t.token.toValue(baseOrigin);
     }
-    else if (t->token == Tokens::OPEN_CURLY()) {
+    else if (t.token.type == TokenType::OPEN_CURLY) {
         v = std::static_pointer_cast<AbstractConfigValue>(parseObject(true));
     }
-    else if (t->token == Tokens::OPEN_SQUARE()) {
+    else if (t.token.type == TokenType::OPEN_SQUARE) {
         v = std::static_pointer_cast<AbstractConfigValue>(parseArray());
     }
     else {
-        throw parseError(addQuoteSuggestion(t->token->toString(),
-                         "Expecting a value but got wrong token: " + t->token->toString()));
+        throw parseError(addQuoteSuggestion(t.toString(),
+                         "Expecting a value but got wrong token: " + t.toString()));
     }
 
-    v = v->withOrigin(t->setComments(std::dynamic_pointer_cast<SimpleConfigOrigin>(v->origin())));
+    // only touch the origin if there are comments to attach; asking for it
+    // would otherwise create a per-line origin for every value
+    if (!t.comments.empty()) {
+        v = v->withOrigin(t.setComments(std::dynamic_pointer_cast<SimpleConfigOrigin>(v->origin())));
+    }
 
     return v;
 }
 
-AbstractConfigObjectPtr ParseContext::createValueUnderPath(const PathPtr& path, const AbstractConfigValuePtr& value) {
+AbstractConfigObjectPtr ParseContext::createValueUnderPath(VectorString::const_iterator begin, VectorString::const_iterator end, const AbstractConfigValuePtr& value) {
     // for path foo.bar, we are creating
     // { "foo" : { "bar" : value } }
-    VectorString keys;
-
-    std::string key = path->first();
-    auto remaining = path->remainder();
-    while (!key.empty()) {
-        keys.push_back(key);
-        if (!remaining) {
-            break;
-        }
-        else {
-            key = remaining->first();
-            remaining = remaining->remainder();
-        }
-    }
 
     // the setComments(VectorString()) is to ensure comments are only
     // on the exact leaf node they apply to.
     // a comment before "foo.bar" applies to the full setting
     // "foo.bar" not also to "foo"
-    auto i = keys.rbegin();
-    std::string deepest = *i++;
-    auto o = SimpleConfigObject::make_instance(std::dynamic_pointer_cast<SimpleConfigOrigin>(value->origin())->setComments({}), MapAbstractConfigValue({{deepest, value}}));
-    for (; i != keys.rend(); ++i) {
-        o = SimpleConfigObject::make_instance(std::dynamic_pointer_cast<SimpleConfigOrigin>(value->origin())->setComments({}), MapAbstractConfigValue({{*i, o}}));
+    auto origin = std::dynamic_pointer_cast<SimpleConfigOrigin>(value->origin())->setComments({});
+    auto& resource = ConfigMemoryScope::current();
+    auto i = end;
+    --i;
+    auto o = SimpleConfigObject::make_instance(origin, MapAbstractConfigValue({{InternedString(*i, resource), value}}));
+    while (i != begin) {
+        --i;
+        o = SimpleConfigObject::make_instance(origin, MapAbstractConfigValue({{InternedString(*i, resource), o}}));
     }
 
     return o;
 }
 
-PathPtr ParseContext::parseKey(const TokenWithCommentsPtr& token) {
+VectorString ParseContext::parseKey(const TokenWithComments& token) {
     if (flavor == ConfigSyntax::JSON) {
-        if (Tokens::isValueWithType(token->token, ConfigValueType::STRING)) {
-            std::string key = Tokens::getValue(token->token)->unwrapped<std::string>();
-            return Path::newKey(key);
+        if (token.token.isValueWithType(ConfigValueType::STRING)) {
+            return VectorString(1, token.token.stringValue());
         }
         else {
-            throw parseError(addKeyName("Expecting close brace } or a field name here, got " + token->toString()));
+            throw parseError(addKeyName("Expecting close brace } or a field name here, got " + token.toString()));
         }
     }
     else {
-        VectorToken expression;
-        auto t = token;
-        while (Tokens::isValue(t->token) || Tokens::isUnquotedText(t->token)) {
-            expression.push_back(t->token);
-            t = nextToken(); // note: don't cross a newline
+        if (!isKeyToken(token.token)) {
+            throw parseError(addKeyName("expecting a close brace or a field name here, got " + token.toString()));
         }
 
-        if (expression.empty()) {
-            throw parseError(addKeyName("expecting a close brace or a field name here, got " + t->toString()));
+        // the key's tokens go into the path as they come, so a key is
+        // never made into tokens
+        PathExpression path(baseOrigin, lineNumber);
+        path.add(token.token);
+        auto t = nextToken(); // note: don't cross a newline
+        while (isKeyToken(t.token)) {
+            path.add(t.token);
+            t = nextToken();
         }
 
-        putBack(t); // put back the token we ended with
-        return Parser::parsePathExpression(TokenIterator::make_instance(expression), lineOrigin());
+        putBack(std::move(t)); // put back the token we ended with
+
+        return path.keys();
     }
 }
 
-bool ParseContext::isIncludeKeyword(const TokenPtr& t) {
-    return Tokens::isUnquotedText(t) && Tokens::getUnquotedText(t) == "include";
+bool ParseContext::isKeyToken(const Lexeme& t) {
+    return t.type == TokenType::VALUE || t.type == TokenType::UNQUOTED_TEXT;
+}
+
+bool ParseContext::isIncludeKeyword(const Lexeme& t) {
+    return t.type == TokenType::UNQUOTED_TEXT && t.text == "include";
 }
 
-bool ParseContext::isUnquotedWhitespace(const TokenPtr& t) {
-    if (!Tokens::isUnquotedText(t)) {
+bool ParseContext::isUnquotedWhitespace(const Lexeme& t) {
+    if (t.type != TokenType::UNQUOTED_TEXT) {
         return false;
     }
 
-    std::string s = Tokens::getUnquotedText(t);
-
-    for (auto& c : s) {
+    for (auto& c : t.text) {
         if (!std::isspace(c)) {
             return false;
         }
@@ -473,50 +562,50 @@ bool ParseContext::isUnquotedWhitespace(const TokenPtr& t) {
 
 void ParseContext::parseInclude(MapAbstractConfigValue& values) {
     auto t = nextTokenIgnoringNewline();
-    while (isUnquotedWhitespace(t->token)) {
+    while (isUnquotedWhitespace(t.token)) {
         t = nextTokenIgnoringNewline();
     }
 
     AbstractConfigObjectPtr obj;
 
     // we either have a quoted string or the "file()" syntax
-    if (Tokens::isUnquotedText(t->token)) {
+    if (t.token.type == TokenType::UNQUOTED_TEXT) {
         // get foo(
-        std::string kind = Tokens::getUnquotedText(t->token);
+        std::string kind = t.token.text;
 
         if (kind =="file(") {
         }
         else {
             throw parseError("expecting include parameter to be quoted filename, "
                              "or file(). No spaces are allowed before the open "
-                             "paren. Not expecting: " + t->toString());
+                             "paren. Not expecting: " + t.toString());
         }
 
         // skip space inside parens
         t = nextTokenIgnoringNewline();
-        while (isUnquotedWhitespace(t->token)) {
+        while (isUnquotedWhitespace(t.token)) {
             t = nextTokenIgnoringNewline();
         }
 
         // quoted string
         std::string name;
-        if (Tokens::isValueWithType(t->token, ConfigValueType::STRING)) {
-            name = Tokens::getValue(t->token)->unwrapped<std::string>();
+        if (t.token.isValueWithType(ConfigValueType::STRING)) {
+            name = t.token.stringValue();
         }
         else {
-            throw parseError("expecting a quoted string inside file(), rather than: " + t->toString());
+            throw parseError("expecting a quoted string inside file(), rather than: " + t.toString());
         }
         // skip space after string, inside parens
         t = nextTokenIgnoringNewline();
-        while (isUnquotedWhitespace(t->token)) {
+        while (isUnquotedWhitespace(t.token)) {
             t = nextTokenIgnoringNewline();
         }
 
-        if (Tokens::isUnquotedText(t->token) && Tokens::getUnquotedText(t->token) == ")") {
+        if (t.token.type == TokenType::UNQUOTED_TEXT && t.token.text == ")") {
             // OK, close paren
         }
         else {
-            throw parseError("expecting a close parentheses ')' here, not: " + t->toString());
+            throw parseError("expecting a close parentheses ')' here, not: " + t.toString());
         }
 
         if (kind == "file(") {
@@ -526,91 +615,95 @@ void ParseContext::parseInclude(MapAbstractConfigValue& values) {
             throw ConfigExceptionBugOrBroken("should not be reached");
         }
     }
-    else if (Tokens::isValueWithType(t->token, ConfigValueType::STRING)) {
-        std::string name = Tokens::getValue(t->token)->unwrapped<std::string>();
+    else if (t.token.isValueWithType(ConfigValueType::STRING)) {
+        std::string name = t.token.stringValue();
         obj = std::dynamic_pointer_cast<AbstractConfigObject>(includer->include(includeContext, name));
     }
     else {
-        throw parseError("include keyword is not followed by a quoted string, but by: " + t->toString());
+        throw parseError("include keyword is not followed by a quoted string, but by: " + t.toString());
     }
 
     if (!pathStack.empty()) {
-        auto prefix = Path::make_instance(VectorPath(pathStack.begin(), pathStack.end()));
+        VectorString keys;
+        for (auto& p : pathStack) {
+            keys.insert(keys.end(), p.begin(), p.end());
+        }
+        auto prefix = Path::make_instance(std::move(keys));
         obj = std::static_pointer_cast<AbstractConfigObject>(obj->relativized(prefix));
     }
 
     for (auto& pair : *obj) {
-        auto v = std::dynamic_pointer_cast<AbstractConfigValue>(pair.second);
-        auto existing = values.find(pair.first);
+        auto v = AbstractConfigValue::cast(pair.second);
+        auto existing = values.find(pair.key);
         if (existing != values.end()) {
-            values[pair.first] = std::dynamic_pointer_cast<AbstractConfigValue>(v->withFallback(existing->second));
+            values[pair.key] = v->withFallbackValue(existing->second);
         }
         else {
-            values[pair.first] = v;
+            values[pair.key] = v;
         }
     }
 }
 
-bool ParseContext::isKeyValueSeparatorToken(const TokenPtr& t) {
+bool ParseContext::isKeyValueSeparatorToken(const Lexeme& t) {
     if (flavor == ConfigSyntax::JSON) {
-        return t == Tokens::COLON();
+        return t.type == TokenType::COLON;
     }
     else {
-        return t == Tokens::COLON() || t == Tokens::EQUALS() || t == Tokens::PLUS_EQUALS();
+        return t.type == TokenType::COLON || t.type == TokenType::EQUALS || t.type == TokenType::PLUS_EQUALS;
     }
 }
 
 AbstractConfigObjectPtr ParseContext::parseObject(bool hadOpenCurly) {
     // invoked just after the OPEN_CURLY (or START, if !hadOpenCurly)
     MapAbstractConfigValue values;
-    auto objectOrigin = lineOrigin();
+    auto objectOrigin = valueOrigin();
     bool afterComma = false;
-    PathPtr lastPath;
+    VectorString lastPath;
     bool lastInsideEquals = false;
 
     while (true) {
         auto t = nextTokenIgnoringNewline();
-        if (t->token == Tokens::CLOSE_CURLY()) {
+        if (t.token.type == TokenType::CLOSE_CURLY) {
             if (flavor == ConfigSyntax::JSON && afterComma) {
-                throw parseError(addQuoteSuggestion(t->toString(),
+                throw parseError(addQuoteSuggestion(t.toString(),
                                  "expecting a field name after a comma, got a close brace } instead"));
             }
             else if (!hadOpenCurly) {
-                throw parseError(addQuoteSuggestion(t->toString(), "unbalanced close brace '}' with no open brace"));
+                throw parseError(addQuoteSuggestion(t.toString(), "unbalanced close brace '}' with no open brace"));
             }
             break;
         }
-        else if (t->token == Tokens::END() && !hadOpenCurly) {
-            putBack(t);
+        else if (t.token.type == TokenType::END && !hadOpenCurly) {
+            putBack(std::move(t));
             break;
         }
-        else if (flavor != ConfigSyntax::JSON && isIncludeKeyword(t->token)) {
+        else if (flavor != ConfigSyntax::JSON && isIncludeKeyword(t.token)) {
             parseInclude(values);
             afterComma = false;
         }
         else {
-            auto keyToken = t;
+            auto keyToken = std::move(t);
             auto path = parseKey(keyToken);
             auto afterKey = nextTokenIgnoringNewline();
             bool insideEquals = false;
 
             // path must be on-stack while we parse the value
-            pathStack.push_front(path);
+            pathStack.push_front(std::move(path));
 
-            TokenWithCommentsPtr valueToken;
+            TokenWithComments valueToken;
             AbstractConfigValuePtr newValue;
-            if (flavor == ConfigSyntax::CONF && afterKey->token == Tokens::OPEN_CURLY()) {
+            if (flavor == ConfigSyntax::CONF && afterKey.token.type == TokenType::OPEN_CURLY) {
                 // can omit the ':' or '=' before an object value
                 valueToken = afterKey;
             }
             else {
-                if (!isKeyValueSeparatorToken(afterKey->token)) {
-                    throw parseError(addQuoteSuggestion(afterKey->toString(),
-                                     "Key '" + path->render() +
-                                     "' may not be followed by token: " + afterKey->toString()));
+                if (!isKeyValueSeparatorToken(afterKey.token)) {
+                    throw parseError(addQuoteSuggestion(afterKey.toString(),
+                                     "Key '" + previousFieldName() +
+                                     "' may not be followed by token: " + afterKey.toString()));
                 }
 
-                if (afterKey->token == Tokens::EQUALS()) {
+                if (afterKey.token.type == TokenType::EQUALS) {
                     insideEquals = true;
                     equalsCount++;
                 }
@@ -619,9 +712,10 @@ AbstractConfigObjectPtr ParseContext::parseObject(bool hadOpenCurly) {
                 valueToken = nextTokenIgnoringNewline();
             }
 
-            newValue = parseValue(valueToken->prepend(keyToken->comments));
+            valueToken.prepend(keyToken.comments);
+            newValue = parseValue(valueToken);
 
-            if (afterKey->token == Tokens::PLUS_EQUALS()) {
+            if (afterKey.token.type == TokenType::PLUS_EQUALS) {
                 VectorAbstractConfigValue concat;
                 auto previousRef = ConfigReference::make_instance(newValue->origin(), SubstitutionExpression::make_instance(fullCurrentPath(), true));
                 auto list = SimpleConfigList::make_instance(newValue->origin(), VectorAbstractConfigValue({newValue}));
@@ -630,17 +724,17 @@ AbstractConfigObjectPtr ParseContext::parseObject(bool hadOpenCurly) {
                 newValue = ConfigConcatenation::concatenate(concat);
             }
 
-            lastPath = pathStack.front();
+            lastPath.swap(pathStack.front());
             pathStack.pop_front();
             if (insideEquals) {
                 equalsCount--;
             }
             lastInsideEquals = insideEquals;
 
-            std::string key = path->first();
-            auto remaining = path->remainder();
+            // interned once here rather than at each use below
+            InternedString key(lastPath.front(), ConfigMemoryScope::current());
 
-            if (!remaining) {
+            if (lastPath.size() == 1) {
                 auto existing = values.find(key);
                 if (existing != values.end()) {
                     // In strict JSON, dups should be an error; while in
@@ -654,7 +748,7 @@ AbstractConfigObjectPtr ParseContext::parseObject(bool hadOpenCurly) {
                                          existing->second->origin()->description());
                     }
                     else {
-                        newValue = std::dynamic_pointer_cast<AbstractConfigValue>(newValue->withFallback(existing->second));
+                        newValue = newValue->withFallbackValue(existing->second);
                     }
                 }
                 values[key] = newValue;
@@ -664,7 +758,7 @@ AbstractConfigObjectPtr ParseContext::parseObject(bool hadOpenCurly) {
                     throw ConfigExceptionBugOrBroken("somehow got multi-element path in JSON mode");
                 }
 
-                auto obj = createValueUnderPath(remaining, newValue);
+                auto obj = createValueUnderPath(lastPath.begin() + 1, lastPath.end(), newValue);
                 auto existing = values.find(key);
                 if (existing != values.end()) {
                     obj = std::dynamic_pointer_cast<AbstractConfigObject>(obj->withFallback(existing->second));
@@ -681,25 +775,25 @@ AbstractConfigObjectPtr ParseContext::parseObject(bool hadOpenCurly) {
         }
         else {
             t = nextTokenIgnoringNewline();
-            if (t->token == Tokens::CLOSE_CURLY()) {
+            if (t.token.type == TokenType::CLOSE_CURLY) {
                 if (!hadOpenCurly) {
                     throw parseError(addQuoteSuggestion(lastPath, lastInsideEquals,
-                                     t->toString(), "unbalanced close brace '}' with no open brace"));
+                                     t.toString(), "unbalanced close brace '}' with no open brace"));
                 }
                 break;
             }
             else if (hadOpenCurly) {
                 throw parseError(addQuoteSuggestion(lastPath, lastInsideEquals,
-                                 t->toString(), "Expecting close brace } or a comma, got " + t->toString()));
+                                 t.toString(), "Expecting close brace } or a comma, got " + t.toString()));
             }
             else {
-                if (t->token == Tokens::END()) {
-                    putBack(t);
+                if (t.token.type == TokenType::END) {
+                    putBack(std::move(t));
                     break;
                 }
                 else {
                     throw parseError(addQuoteSuggestion(lastPath, lastInsideEquals,
-                                     t->toString(), "Expecting end of input or a comma, got " + t->toString()));
+                                     t.toString(), "Expecting end of input or a comma, got " + t.toString()));
                 }
             }
         }
@@ -710,7 +804,7 @@ AbstractConfigObjectPtr ParseContext::parseObject(bool hadOpenCurly) {
 
 SimpleConfigListPtr ParseContext::parseArray() {
     // invoked just after the OPEN_SQUARE
-    auto arrayOrigin = lineOrigin();
+    auto arrayOrigin = valueOrigin();
     VectorAbstractConfigValue values;
 
     consolidateValueTokens();
@@ -718,15 +812,15 @@ SimpleConfigListPtr ParseContext::parseArray() {
     auto t = nextTokenIgnoringNewline();
 
     // special-case the first element
-    if (t->token == Tokens::CLOSE_SQUARE()) {
+    if (t.token.type == TokenType::CLOSE_SQUARE) {
         return SimpleConfigList::make_instance(arrayOrigin, VectorAbstractConfigValue());
     }
-    else if (Tokens::isValue(t->token) || t->token == Tokens::OPEN_CURLY() || t->token == Tokens::OPEN_SQUARE()) {
+    else if (t.token.isValue() || t.token.type == TokenType::OPEN_CURLY || t.token.type == TokenType::OPEN_SQUARE) {
         values.push_back(parseValue(t));
     }
     else {
         throw parseError(addKeyName("List should have ] or a first element after the open [, instead had token: " +
-                         t->toString() + " (if you want " + t->toString() + " to be part of a string value, then double-quote it)"));
+                         t.toString() + " (if you want " + t.toString() + " to be part of a string value, then double-quote it)"));
     }
 
     // now remaining elements
@@ -737,12 +831,12 @@ SimpleConfigListPtr ParseContext::parseArray() {
         }
         else {
             t = nextTokenIgnoringNewline();
-            if (t->token == Tokens::CLOSE_SQUARE()) {
+            if (t.token.type == TokenType::CLOSE_SQUARE) {
                 return SimpleConfigList::make_instance(arrayOrigin, values);
             }
             else {
                 throw parseError(addKeyName("List should have ended with ] or had a comma, instead had token: " +
-                                 t->toString() + " (if you want " + t->toString() + " to be part of a string value, then double-quote it)"));
+                                 t.toString() + " (if you want " + t.toString() + " to be part of a string value, then double-quote it)"));
             }
         }
 
@@ -750,16 +844,16 @@ SimpleConfigListPtr ParseContext::parseArray() {
         consolidateValueTokens();
 
         t = nextTokenIgnoringNewline();
-        if (Tokens::isValue(t->token) || t->token == Tokens::OPEN_CURLY() || t->token == Tokens::OPEN_SQUARE()) {
+        if (t.token.isValue() || t.token.type == TokenType::OPEN_CURLY || t.token.type == TokenType::OPEN_SQUARE) {
             values.push_back(parseValue(t));
         }
-        else if (flavor != ConfigSyntax::JSON && t->token == Tokens::CLOSE_SQUARE()) {
+        else if (flavor != ConfigSyntax::JSON && t.token.type == TokenType::CLOSE_SQUARE) {
             // we allow one trailing comma
-            putBack(t);
+            putBack(std::move(t));
         }
         else {
             throw parseError(addKeyName("List should have had new element after a comma, instead had token: " +
-                             t->toString() + " (if you want the comma or " + t->toString() +
+                             t.toString() + " (if you want the comma or " + t.toString() +
                              " to be part of a string value, then double-quote it)"));
         }
     }
@@ -767,32 +861,32 @@ SimpleConfigListPtr ParseContext::parseArray() {
 
 AbstractConfigValuePtr ParseContext::parse() {
     auto t = nextTokenIgnoringNewline();
-    if (t->token == Tokens::START()) {
+    if (t.token.type == TokenType::START) {
         // OK
     }
     else {
-        throw ConfigExceptionBugOrBroken("token stream did not begin with START, had " + t->toString());
+        throw ConfigExceptionBugOrBroken("token stream did not begin with START, had " + t.toString());
     }
 
     t = nextTokenIgnoringNewline();
     AbstractConfigValuePtr result;
-    if (t->token == Tokens::OPEN_CURLY() || t->token == Tokens::OPEN_SQUARE()) {
+    if (t.token.type == TokenType::OPEN_CURLY || t.token.type == TokenType::OPEN_SQUARE) {
         result = parseValue(t);
     }
     else {
         if (flavor == ConfigSyntax::JSON) {
-            if (t->token == Tokens::END()) {
+            if (t.token.type == TokenType::END) {
                 throw parseError("Empty document");
             }
             else {
-                throw parseError("Document must have an object or array at root, unexpected token: " + t->toString());
+                throw parseError("Document must have an object or array at root, unexpected token: " + t.toString());
             }
         }
         else {
             // the root object can omit the surrounding braces.
             // this token should be the first field's key, or part
             // of it, so put it back.
-            putBack(t);
+            putBack(std::move(t));
             result = parseObject(false);
             // in this case we don't try to use commentsStack comments
             // since they would all presumably apply to fields not the
@@ -801,47 +895,16 @@ AbstractConfigValuePtr ParseContext::parse() {
     }
 
     t = nextTokenIgnoringNewline();
-    if (t->token == Tokens::END()) {
+    if (t.token.type == TokenType::END) {
         return result;
     }
     else {
-        throw parseError("Document has trailing tokens after first object or array: " + t->toString());
-    }
-}
-
-Element::Element(const std::string& initial, bool canBeEmpty) :
-    element(initial),
-    canBeEmpty(canBeEmpty) {
-}
-
-std::string Element::toString() {
-    return "Element(" + element + "," + (canBeEmpty ? "true" : "false") + ")";
-}
-
-void Parser::addPathText(VectorElement& buf, bool wasQuoted, const std::string& newText) {
-    std::string::size_type i = wasQuoted ? std::string::npos : newText.find('.');
-    auto current = buf.back();
-    if (i == std::string::npos) {
-        // add to current path element
-        current->element += newText;
-        // any empty quoted string means this element can now be empty.
-        if (wasQuoted && current->element.empty())
-            current->canBeEmpty = true;
-    }
-    else {
-        // "buf" plus up to the period is an element
-        current->element += newText.substr(0, i);
-        // then start a new element
-        buf.push_back(Element::make_instance("", false));
-        // recurse to consume remainder of newText
-        addPathText(buf, false, newText.substr(i + 1));
+        throw parseError("Document has trailing tokens after first object or array: " + t.toString());
     }
 }
 
 PathPtr Parser::parsePathExpression(const TokenIteratorPtr& expression, const ConfigOriginPtr& origin, const std::string& originalText) {
-    // each builder in "buf" is an element in the path.
-    VectorElement buf;
-    buf.push_back(Element::make_instance("", false));
+    PathExpression path(origin, -1, originalText);
 
     if (!expression->hasNext()) {
         throw ConfigExceptionBadPath(origin, originalText,
@@ -850,67 +913,24 @@ PathPtr Parser::parsePathExpression(const TokenIteratorPtr& expression, const Co
 
     while (expression->hasNext()) {
         auto t = expression->next();
-        if (Tokens::isValueWithType(t, ConfigValueType::STRING)) {
-            auto v = Tokens::getValue(t);
-            // this is a quoted string; so any periods
-            // in here don't count as path separators
-            std::string s = v->transformToString();
-
-            addPathText(buf, true, s);
-        }
-        else if (t == Tokens::END()) {
+        if (t == Tokens::END()) {
             // ignore this; when parsing a file, it should not happen
             // since we're parsing a token list rather than the main
             // token iterator, and when parsing a path expression from the
             // API, it's expected to have an END.
         }
         else {
-            // any periods outside of a quoted string count as
-            // separators
-            std::string text;
-            if (Tokens::isValue(t)) {
-                // appending a number here may add
-                // a period, but we _do_ count those as path
-                // separators, because we basically want
-                // "foo 3.0bar" to parse as a string even
-                // though there's a number in it. The fact that
-                // we tokenize non-string values is largely an
-                // implementation detail.
-                auto v = Tokens::getValue(t);
-                text = v->transformToString();
-            }
-            else if (Tokens::isUnquotedText(t)) {
-                text = Tokens::getUnquotedText(t);
-            }
-            else {
-                throw ConfigExceptionBadPath(origin, originalText,
-                                             "Token not allowed in path expression: " +
-                                             t->toString() +
-                                             " (you can double-quote this token if you really want it here)");
-            }
-
-            addPathText(buf, false, text);
-        }
-    }
-
-    auto pb = PathBuilder::make_instance();
-    for (auto& e : buf) {
-        if (e->element.empty() && !e->canBeEmpty) {
-            throw ConfigExceptionBadPath(origin, originalText,
-                                         "path has a leading, trailing, or two "
-                                         "adjacent period '.' (use quoted \"\" "
-                                         "empty string if you want an empty element)");
-        }
-        else {
-            pb->appendKey(e->element);
+            path.add(Lexeme::fromToken(t));
         }
     }
 
-    return pb->result();
+    return path.result();
 }
 
 PathPtr Parser::parsePath(const std::string& path) {
-    static auto apiOrigin = SimpleConfigOrigin::newSimple("path parameter");
+    static auto apiOrigin = ConfigHeapScope::make([]() {
+        return SimpleConfigOrigin::newSimple("path parameter");
+    });
 
     auto speculated = speculativeFastParsePath(path);
     if (speculated) {
@@ -4,7 +4,6 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "configcpp/detail/path.h"
-#include "configcpp/detail/path_builder.h"
 #include "configcpp/detail/config_impl_util.h"
 #include "configcpp/detail/parser.h"
 #include "configcpp/detail/variant_utils.h"
@@ -12,23 +11,45 @@
 
 namespace config {
 
-Path::Path(const std::string& first, const PathPtr& remainder) :
-    first_(first),
-    remainder_(remainder) {
+Path::Segments::Segments(VectorInternedString keys) :
+    keys(std::move(keys)) {
+    // the same per-key terms the recursive hash of a linked path summed
+    hashes.reserve(this->keys.size() + 1);
+    hashes.push_back(0);
+    for (auto& key : this->keys) {
+        hashes.push_back(hashes.back() + hashKey(key));
+    }
+}
+
+Path::Path(const std::string& first, const PathPtr& remainder) {
+    VectorInternedString keys(1, first);
+    if (remainder) {
+        remainder->appendKeys(keys);
+    }
+    end_ = keys.size();
+    segments_ = std::make_shared<Segments>(std::move(keys));
+    begin_ = 0;
+    hash_ = segments_->hashes[end_];
 }
 
 Path::Path(const VectorString& elements) {
     if (elements.empty()) {
         throw ConfigExceptionBugOrBroken("empty path");
     }
-    first_ = elements[0];
-    if (elements.size() > 1) {
-        auto pb = PathBuilder::make_instance();
-        for (uint32_t i = 1; i < elements.size(); ++i) {
-            pb->appendKey(elements[i]);
-        }
-        remainder_ = pb->result();
+    segments_ = std::make_shared<Segments>(VectorInternedString(elements.begin(), elements.end()));
+    begin_ = 0;
+    end_ = elements.size();
+    hash_ = segments_->hashes[end_];
+}
+
+Path::Path(VectorInternedString&& elements) {
+    if (elements.empty()) {
+        throw ConfigExceptionBugOrBroken("empty path");
     }
+    end_ = elements.size();
+    segments_ = std::make_shared<Segments>(std::move(elements));
+    begin_ = 0;
+    hash_ = segments_->hashes[end_];
 }
 
 Path::Path(const VectorPath& pathsToConcat) {
@@ -36,100 +57,98 @@ Path::Path(const VectorPath& pathsToConcat) {
         throw ConfigExceptionBugOrBroken("empty path");
     }
 
-    auto i = pathsToConcat.begin();
-    auto firstPath = *(i++);
-    first_ = firstPath->first_;
-
-    auto pb = PathBuilder::make_instance();
-    if (firstPath->remainder_) {
-        pb->appendPath(firstPath->remainder_);
+    VectorInternedString keys;
+    for (auto& path : pathsToConcat) {
+        path->appendKeys(keys);
     }
-    while (i != pathsToConcat.end()) {
-        pb->appendPath(*(i++));
-    }
-    remainder_ = pb->result();
+    end_ = keys.size();
+    segments_ = std::make_shared<Segments>(std::move(keys));
+    begin_ = 0;
+    hash_ = segments_->hashes[end_];
+}
+
+Path::Path(const SegmentsPtr& segments, uint32_t begin, uint32_t end) :
+    segments_(segments),
+    begin_(begin),
+    end_(end),
+    hash_(segments->hashes[end] - segments->hashes[begin]) {
 }
 
-std::string Path::first() {
-    return first_;
+const std::string& Path::first() {
+    return segments_->keys[begin_].str();
 }
 
 PathPtr Path::remainder() {
-    return remainder_;
+    if (end_ - begin_ == 1) {
+        return nullptr;
+    }
+    return make_instance(segments_, begin_ + 1, end_);
 }
 
 PathPtr Path::parent() {
-    if (!remainder_) {
+    if (end_ - begin_ == 1) {
         return nullptr;
     }
+    return make_instance(segments_, begin_, end_ - 1);
+}
 
-    auto pb = PathBuilder::make_instance();
-    auto p = shared_from_this();
-    while (p->remainder_) {
-        pb->appendKey(p->first_);
-        p = p->remainder_;
-    }
-    return pb->result();
+const std::string& Path::last() {
+    return segments_->keys[end_ - 1].str();
 }
 
-std::string Path::last() {
-    auto p = shared_from_this();
-    while (p->remainder_) {
-        p = p->remainder_;
-    }
-    return p->first_;
+const std::string& Path::element(uint32_t index) {
+    return segments_->keys[begin_ + index].str();
+}
+
+const InternedString& Path::key(uint32_t index) {
+    return segments_->keys[begin_ + index];
 }
 
 PathPtr Path::prepend(const PathPtr& toPrepend) {
-    auto pb = PathBuilder::make_instance();
-    pb->appendPath(toPrepend);
-    pb->appendPath(shared_from_this());
-    return pb->result();
+    VectorInternedString keys;
+    keys.reserve(toPrepend->length() + length());
+    toPrepend->appendKeys(keys);
+    appendKeys(keys);
+    return make_instance(std::move(keys));
 }
 
 uint32_t Path::length() {
-    uint32_t count = 1;
-    auto p = remainder_;
-    while (p) {
-        count += 1;
-        p = p->remainder_;
-    }
-    return count;
+    return end_ - begin_;
 }
 
 PathPtr Path::subPath(uint32_t removeFromFront) {
-    int32_t count = removeFromFront;
-    auto p = shared_from_this();
-    while (p && count > 0) {
-        count -= 1;
-        p = p->remainder_;
+    if (removeFromFront == 0) {
+        return shared_from_this();
+    }
+    else if (removeFromFront >= length()) {
+        return nullptr;
     }
-    return p;
+    return make_instance(segments_, begin_ + removeFromFront, end_);
 }
 
 PathPtr Path::subPath(uint32_t firstIndex, uint32_t lastIndex) {
     if (lastIndex < firstIndex) {
         throw ConfigExceptionBugOrBroken("bad call to subPath");
     }
-
-    auto from = subPath(firstIndex);
-    auto pb = PathBuilder::make_instance();
-    uint32_t count = lastIndex - firstIndex;
-    while (count > 0) {
-        count -= 1;
-        pb->appendKey(from->first());
-        from = from->remainder();
-        if (!from) {
-            throw ConfigExceptionBugOrBroken("subPath lastIndex out of range " + boost::lexical_cast<std::string>(lastIndex));
-        }
+    else if (lastIndex == firstIndex) {
+        // an empty path is null
+        return nullptr;
+    }
+    else if (lastIndex >= length()) {
+        throw ConfigExceptionBugOrBroken("subPath lastIndex out of range " + boost::lexical_cast<std::string>(lastIndex));
     }
-    return pb->result();
+    return make_instance(segments_, begin_ + firstIndex, begin_ + lastIndex);
 }
 
 bool Path::equals(const ConfigVariant& other) {
     if (instanceof<Path>(other)) {
         auto that = static_get<Path>(other);
-        return this->first_ == that->first_ && ConfigImplUtil::equalsHandlingNull(this->remainder_, that->remainder_);
+        if (this->hash_ != that->hash_ || this->length() != that->length()) {
+            return false;
+        }
+        return std::equal(this->segments_->keys.begin() + this->begin_,
+                          this->segments_->keys.begin() + this->end_,
+                          that->segments_->keys.begin() + that->begin_);
     }
     else {
         return false;
@@ -137,7 +156,12 @@ bool Path::equals(const ConfigVariant& other) {
 }
 
 uint32_t Path::hashCode() {
-    return 41 * (41 + std::hash<std::string>()(first_)) + (!remainder_ ? 0 : remainder_->hashCode());
+    return hash_;
+}
+
+uint32_t Path::hashKey(const InternedString& key) {
+    // hashCode() is std::hash<std::string> of the key
+    return 41 * (41 + static_cast<uint32_t>(key.hashCode()));
 }
 
 bool Path::hasFunkyChars(const std::string& s) {
@@ -170,18 +194,24 @@ bool Path::hasFunkyChars(const std::string& s) {
 }
 
 void Path::appendToStream(std::string& s) {
-    if (hasFunkyChars(first_) || first_.empty()) {
-        s += ConfigImplUtil::renderJsonString(first_);
-    }
-    else {
-        s += first_;
-    }
-    if (remainder_) {
-        s += ".";
-        remainder_->appendToStream(s);
+    for (uint32_t i = begin_; i < end_; ++i) {
+        auto& key = segments_->keys[i].str();
+        if (i != begin_) {
+            s += ".";
+        }
+        if (hasFunkyChars(key) || key.empty()) {
+            s += ConfigImplUtil::renderJsonString(key);
+        }
+        else {
+            s += key;
+        }
     }
 }
 
+void Path::appendKeys(VectorInternedString& keys) {
+    keys.insert(keys.end(), segments_->keys.begin() + begin_, segments_->keys.begin() + end_);
+}
+
 std::string Path::toString() {
     std::string s = "Path(";
     appendToStream(s);
@@ -196,7 +226,7 @@ std::string Path::render() {
 }
 
 PathPtr Path::newKey(const std::string& key) {
-    return make_instance(key, nullptr);
+    return make_instance(VectorInternedString(1, key));
 }
 
 PathPtr Path::newPath(const std::string& path) {
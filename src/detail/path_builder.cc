@@ -18,36 +18,21 @@ void PathBuilder::checkCanAppend() {
 void PathBuilder::appendKey(const std::string& key) {
     checkCanAppend();
 
-    keys.push_front(key);
+    keys.push_back(key);
 }
 
 void PathBuilder::appendPath(const PathPtr& path) {
     checkCanAppend();
 
-    std::string first = path->first();
-    auto remainder = path->remainder();
-    while (true) {
-        keys.push_front(first);
-        if (remainder) {
-            first = remainder->first();
-            remainder = remainder->remainder();
-        }
-        else {
-            break;
-        }
+    for (uint32_t i = 0; i < path->length(); ++i) {
+        keys.push_back(path->element(i));
     }
 }
 
 PathPtr PathBuilder::result() {
     // note: if keys is empty, we want to return null, which is a valid empty path
-    if (!result_) {
-        PathPtr remainder;
-        while (!keys.empty()) {
-            std::string key = keys.front();
-            keys.pop_front();
-            remainder = Path::make_instance(key, remainder);
-        }
-        result_ = remainder;
+    if (!result_ && !keys.empty()) {
+        result_ = Path::make_instance(std::move(keys));
     }
     return result_;
 }
@@ -0,0 +1,174 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/detail/path_cache.h"
+#include "configcpp/config_path.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace config {
+
+/// A cached path, and whether it was looked up since the hand passed; the
+/// flag is set by lookups that don't take the lock.
+struct PathCache::Entry {
+    Entry(const ConfigPathPtr& path) :
+        path(path),
+        referenced(false) {
+    }
+
+    ConfigPathPtr path;
+    std::atomic<bool> referenced;
+};
+
+struct PathCache::State {
+    State() :
+        limit(DEFAULT_LIMIT),
+        hand(0),
+        generation(0),
+        hits(0),
+        misses(0) {
+    }
+
+    void clear() {
+        index.clear();
+        slots.clear();
+        hand = 0;
+        // the threads' recent paths are dropped the next time they look
+        generation.fetch_add(1, std::memory_order_release);
+    }
+
+    std::mutex mutex;
+    std::unordered_map<std::string, uint32_t> index;
+    std::vector<std::shared_ptr<Entry>> slots;
+    uint32_t limit;
+    uint32_t hand;
+    std::atomic<uint64_t> generation;
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+};
+
+/// The entries one thread looked up last, by hash of the expression.
+struct PathCache::Front {
+    static const uint32_t SIZE = 64;
+
+    Front() :
+        generation(0) {
+    }
+
+    uint64_t generation;
+    std::shared_ptr<Entry> entries[SIZE];
+};
+
+PathCache::State& PathCache::state() {
+    static State state;
+    return state;
+}
+
+PathCache::Front& PathCache::front() {
+    static thread_local Front front;
+    return front;
+}
+
+ConfigPathPtr PathCache::get(const std::string& path) {
+    auto& cache = state();
+    auto& local = front();
+    uint64_t generation = cache.generation.load(std::memory_order_acquire);
+    if (local.generation != generation) {
+        for (auto& entry : local.entries) {
+            entry.reset();
+        }
+        local.generation = generation;
+    }
+
+    auto& recent = local.entries[std::hash<std::string>()(path) % Front::SIZE];
+    if (recent && recent->path->expression() == path) {
+        cache.hits.fetch_add(1, std::memory_order_relaxed);
+        recent->referenced.store(true, std::memory_order_relaxed);
+        return recent->path;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto cached = cache.index.find(path);
+        if (cached != cache.index.end()) {
+            cache.hits.fetch_add(1, std::memory_order_relaxed);
+            recent = cache.slots[cached->second];
+            recent->referenced.store(true, std::memory_order_relaxed);
+            return recent->path;
+        }
+        cache.misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // parse outside the lock; a bad path throws and isn't cached
+    auto parsed = ConfigPath::make_instance(path);
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.limit == 0) {
+        return parsed;
+    }
+    auto cached = cache.index.find(path);
+    if (cached != cache.index.end()) {
+        // another thread got there first
+        recent = cache.slots[cached->second];
+        return recent->path;
+    }
+    auto entry = std::make_shared<Entry>(parsed);
+    if (cache.slots.size() < cache.limit) {
+        cache.index.insert(std::make_pair(path, static_cast<uint32_t>(cache.slots.size())));
+        cache.slots.push_back(entry);
+    }
+    else {
+        // clock: give referenced paths a second chance, replace the first
+        // that hasn't been looked up since the hand last went by
+        while (cache.slots[cache.hand]->referenced.exchange(false, std::memory_order_relaxed)) {
+            cache.hand = (cache.hand + 1) % cache.limit;
+        }
+        auto& victim = cache.slots[cache.hand];
+        cache.index.erase(victim->path->expression());
+        cache.index.insert(std::make_pair(path, cache.hand));
+        victim = entry;
+        cache.hand = (cache.hand + 1) % cache.limit;
+    }
+    recent = entry;
+    return parsed;
+}
+
+uint32_t PathCache::limit() {
+    auto& cache = state();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.limit;
+}
+
+void PathCache::setLimit(uint32_t limit) {
+    auto& cache = state();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.limit = limit;
+    cache.clear();
+}
+
+uint32_t PathCache::size() {
+    auto& cache = state();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return static_cast<uint32_t>(cache.slots.size());
+}
+
+uint64_t PathCache::hits() {
+    return state().hits.load(std::memory_order_relaxed);
+}
+
+uint64_t PathCache::misses() {
+    return state().misses.load(std::memory_order_relaxed);
+}
+
+void PathCache::clear() {
+    auto& cache = state();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.clear();
+    cache.hits.store(0, std::memory_order_relaxed);
+    cache.misses.store(0, std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/detail/path_index.h"
+#include "configcpp/detail/path.h"
+#include "configcpp/detail/abstract_config_object.h"
+#include "configcpp/detail/variant_utils.h"
+#include "configcpp/config_exception.h"
+
+namespace config {
+
+const uint32_t PathIndex::NO_PARENT = std::numeric_limits<uint32_t>::max();
+
+PathIndex::PathIndex(const AbstractConfigObjectPtr& root) {
+    if (root->resolveStatus() != ResolveStatus::RESOLVED) {
+        throw ConfigExceptionNotResolved("need to Config::resolve() before indexing paths");
+    }
+    addObject(NO_PARENT, 0, root);
+
+    // keep the table at most half full
+    uint32_t capacity = 16;
+    while (capacity < entries.size() * 2) {
+        capacity *= 2;
+    }
+    slots.resize(capacity, 0);
+    mask = capacity - 1;
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        uint32_t slot = entries[i].hash & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = i + 1;
+    }
+}
+
+void PathIndex::addObject(uint32_t parent, uint32_t parentHash, const AbstractConfigObjectPtr& obj) {
+    for (auto& child : *obj) {
+        Entry entry;
+        entry.key = child.first;
+        entry.parent = parent;
+        // same hash as Path::hashCode() of the full path
+        entry.hash = parentHash + Path::hashKey(child.key);
+        entry.value = AbstractConfigValue::cast(child.second);
+        entries.push_back(entry);
+
+        if (entry.value->isObject()) {
+            addObject(entries.size() - 1, entry.hash, std::static_pointer_cast<AbstractConfigObject>(entry.value));
+        }
+    }
+}
+
+bool PathIndex::matches(uint32_t entry, const PathPtr& path) {
+    for (uint32_t i = path->length(); i > 0; --i) {
+        if (entry == NO_PARENT || entries[entry].key != path->element(i - 1)) {
+            return false;
+        }
+        entry = entries[entry].parent;
+    }
+    return entry == NO_PARENT;
+}
+
+AbstractConfigValue* PathIndex::find(const PathPtr& path) {
+    uint32_t hash = path->hashCode();
+    for (uint32_t slot = hash & mask; slots[slot] != 0; slot = (slot + 1) & mask) {
+        uint32_t entry = slots[slot] - 1;
+        if (entries[entry].hash == hash && matches(entry, path)) {
+            return entries[entry].value.get();
+        }
+    }
+    return nullptr;
+}
+
+uint32_t PathIndex::size() {
+    return entries.size();
+}
+
+}
@@ -9,8 +9,10 @@
 #include "configcpp/detail/resolve_memos.h"
 #include "configcpp/detail/abstract_config_value.h"
 #include "configcpp/detail/path.h"
+#include "configcpp/detail/config_arena.h"
 #include "configcpp/detail/memo_key.h"
 #include "configcpp/detail/substitution_expression.h"
+#include "configcpp/config_resolve_options.h"
 #include "configcpp/config_exception.h"
 
 namespace config {
@@ -132,6 +134,7 @@ AbstractConfigValuePtr ResolveContext::resolve(const AbstractConfigValuePtr& ori
 }
 
 AbstractConfigValuePtr ResolveContext::resolve(const AbstractConfigValuePtr& value, const AbstractConfigObjectPtr& root, const ConfigResolveOptionsPtr& options, const PathPtr& restrictToChildOrNull) {
+    ConfigMemoryScope memory(ConfigArena::forOptions(options->getUseArena(), options->getMemoryResource()));
     auto context = ResolveContext::make_instance(root, options, nullptr);
 
     try {
@@ -9,12 +9,17 @@
 #include "configcpp/detail/abstract_config_value.h"
 #include "configcpp/detail/resolve_context.h"
 #include "configcpp/detail/path.h"
+#include "configcpp/detail/path_index.h"
+#include "configcpp/detail/frozen_config.h"
 #include "configcpp/detail/config_impl.h"
+#include "configcpp/detail/config_arena.h"
 #include "configcpp/detail/config_null.h"
 #include "configcpp/detail/config_number.h"
 #include "configcpp/detail/config_string.h"
 #include "configcpp/detail/default_transformer.h"
+#include "configcpp/detail/number_parser.h"
 #include "configcpp/config_resolve_options.h"
+#include "configcpp/config_path.h"
 #include "configcpp/config_exception.h"
 #include "configcpp/config_value_type.h"
 #include "configcpp/config_list.h"
@@ -22,7 +27,13 @@
 namespace config {
 
 SimpleConfig::SimpleConfig(const AbstractConfigObjectPtr& object) :
-    object(object) {
+    object(object),
+    arena_(ConfigArena::current()),
+    indexed(false) {
+}
+
+ConfigMemoryResourcePtr SimpleConfig::arena() {
+    return arena_;
 }
 
 ConfigObjectPtr SimpleConfig::root() {
@@ -38,6 +49,8 @@ ConfigPtr SimpleConfig::resolve() {
 }
 
 ConfigPtr SimpleConfig::resolve(const ConfigResolveOptionsPtr& options) {
+    // resolve into our own arena, so the resolved config owns it too
+    ConfigMemoryScope memory(ConfigArena::forOptions(options->getUseArena(), options->getMemoryResource(), arena_));
     auto resolved = ResolveContext::resolve(object, object, options);
 
     if (resolved == object) {
@@ -48,8 +61,16 @@ ConfigPtr SimpleConfig::resolve(const ConfigResolveOptionsPtr& options) {
     }
 }
 
-bool SimpleConfig::hasPath(const std::string& pathExpression) {
-    auto path = Path::newPath(pathExpression);
+bool SimpleConfig::hasPath(const std::string& path) {
+    return hasPath(ConfigPath::parse(path));
+}
+
+bool SimpleConfig::hasPath(const ConfigPathPtr& pathExpression) {
+    auto& path = pathExpression->path();
+    if (indexed.load(std::memory_order_acquire)) {
+        auto indexed = index->find(path);
+        return indexed && indexed->valueType() != ConfigValueType::NONE;
+    }
     ConfigValuePtr peeked;
     try {
         peeked = object->peekPath(path);
@@ -72,10 +93,11 @@ void SimpleConfig::findPaths(SetConfigValue& entries, const PathPtr& parent, con
         if (parent) {
             path = path->prepend(parent);
         }
-        if (instanceof<AbstractConfigObject>(v)) {
-            findPaths(entries, path, std::dynamic_pointer_cast<AbstractConfigObject>(v));
+        auto value = AbstractConfigValue::borrow(v);
+        if (value->isObject()) {
+            findPaths(entries, path, std::static_pointer_cast<AbstractConfigObject>(AbstractConfigValue::cast(v)));
         }
-        else if (instanceof<ConfigNull>(v)) {
+        else if (value->kind() == ConfigValueKind::NULL_VALUE) {
             // nothing; nulls are conceptually not in a Config
         }
         else {
@@ -90,24 +112,46 @@ SetConfigValue SimpleConfig::entrySet() {
     return entries;
 }
 
-AbstractConfigValuePtr SimpleConfig::findKey(const AbstractConfigObjectPtr& self, const std::string& key, ConfigValueType expected, const PathPtr& originalPath) {
-    auto v = self->peekAssumingResolved(key, originalPath);
-    if (!v) {
-        throw ConfigExceptionMissing(originalPath->render());
+void SimpleConfig::indexPaths() {
+    std::call_once(indexOnce, [this]() {
+        index = PathIndex::make_instance(object);
+        indexed.store(true, std::memory_order_release);
+    });
+}
+
+ConfigPtr SimpleConfig::freeze() {
+    return FrozenConfig::make_instance(object);
+}
+
+/// The first depth elements of originalPath, for error messages.
+static PathPtr pathTo(const PathPtr& originalPath, uint32_t depth) {
+    return depth == originalPath->length() ? originalPath : originalPath->subPath(0, depth);
+}
+
+AbstractConfigValuePtr SimpleConfig::share(AbstractConfigValue* found, const AbstractConfigValuePtr& held) {
+    if (found == held.get()) {
+        return held;
     }
-    if (expected != ConfigValueType::NONE) {
-        v = DefaultTransformer::transform(v, expected);
+    return std::static_pointer_cast<AbstractConfigValue>(found->ConfigBase::shared_from_this());
+}
+
+AbstractConfigValue* SimpleConfig::checkFound(AbstractConfigValue* found, ConfigValueType expected, const PathPtr& originalPath, uint32_t depth, AbstractConfigValuePtr& held) {
+    auto v = found;
+    if (expected != ConfigValueType::NONE && v->valueType() != expected) {
+        auto transformed = DefaultTransformer::transform(share(v, held), expected);
+        held.swap(transformed);
+        v = held.get();
     }
     if (v->valueType() == ConfigValueType::NONE) {
         throw ConfigExceptionNull(
             v->origin(),
-            originalPath->render(),
+            pathTo(originalPath, depth)->render(),
             expected != ConfigValueType::NONE ? ConfigValueTypeEnum::name(expected) : "");
     }
     else if (expected != ConfigValueType::NONE && v->valueType() != expected) {
         throw ConfigExceptionWrongType(
             v->origin(),
-            originalPath->render(),
+            pathTo(originalPath, depth)->render(),
             ConfigValueTypeEnum::name(expected),
             ConfigValueTypeEnum::name(v->valueType()));
     }
@@ -116,17 +160,22 @@ AbstractConfigValuePtr SimpleConfig::findKey(const AbstractConfigObjectPtr& self
     }
 }
 
-AbstractConfigValuePtr SimpleConfig::find(const AbstractConfigObjectPtr& self, const PathPtr& path, ConfigValueType expected, const PathPtr& originalPath) {
+AbstractConfigValue* SimpleConfig::find(AbstractConfigObject* self, const PathPtr& path, ConfigValueType expected, const PathPtr& originalPath, AbstractConfigValuePtr& held) {
     try {
-        std::string key = path->first();
-        auto next = path->remainder();
-        if (!next) {
-            return findKey(self, key, expected, originalPath);
-        }
-        else {
-            auto o = std::static_pointer_cast<AbstractConfigObject>(findKey(self, key, ConfigValueType::OBJECT, originalPath->subPath(0, originalPath->length() - next->length())));
-            assert(o); // missing was supposed to throw
-            return find(o, next, expected, originalPath);
+        // walk the keys in place rather than through remainder() paths,
+        // borrowing the objects passed through
+        auto o = self;
+        uint32_t length = path->length();
+        uint32_t prefix = originalPath->length() - length;
+        for (uint32_t i = 0; ; ++i) {
+            auto v = o->peekBorrowed(path->key(i), held);
+            if (!v) {
+                throw ConfigExceptionMissing(pathTo(originalPath, prefix + i + 1)->render());
+            }
+            if (i + 1 == length) {
+                return checkFound(v, expected, originalPath, prefix + i + 1, held);
+            }
+            o = static_cast<AbstractConfigObject*>(checkFound(v, ConfigValueType::OBJECT, originalPath, prefix + i + 1, held));
         }
     }
     catch (ConfigExceptionNotResolved& e) {
@@ -134,110 +183,377 @@ AbstractConfigValuePtr SimpleConfig::find(const AbstractConfigObjectPtr& self, c
     }
 }
 
-AbstractConfigValuePtr SimpleConfig::find(const PathPtr& pathExpression, ConfigValueType expected, const PathPtr& originalPath) {
-    return find(object, pathExpression, expected, originalPath);
+AbstractConfigValue* SimpleConfig::find(const ConfigPathPtr& pathExpression, ConfigValueType expected, AbstractConfigValuePtr& held) {
+    auto& path = pathExpression->path();
+    if (indexed.load(std::memory_order_acquire)) {
+        auto v = index->find(path);
+        if (v) {
+            return checkFound(v, expected, path, path->length(), held);
+        }
+        // let the walk throw the right exception
+    }
+    return find(object.get(), path, expected, path, held);
 }
 
-AbstractConfigValuePtr SimpleConfig::find(const std::string& pathExpression, ConfigValueType expected) {
-    auto path = Path::newPath(pathExpression);
-    return find(path, expected, path);
+AbstractConfigValuePtr SimpleConfig::find(const ConfigPathPtr& pathExpression, ConfigValueType expected) {
+    AbstractConfigValuePtr held;
+    return share(find(pathExpression, expected, held), held);
+}
+
+AbstractConfigValue* SimpleConfig::tryCheck(AbstractConfigValue* found, ConfigValueType expected, ConfigError& error, AbstractConfigValuePtr& held) {
+    if (!found) {
+        error = ConfigError::MISSING;
+        return nullptr;
+    }
+    auto v = found;
+    if (expected != ConfigValueType::NONE && v->valueType() != expected) {
+        auto transformed = DefaultTransformer::transform(share(v, held), expected);
+        held.swap(transformed);
+        v = held.get();
+    }
+    if (v->valueType() == ConfigValueType::NONE) {
+        error = ConfigError::NULL_VALUE;
+        return nullptr;
+    }
+    else if (expected != ConfigValueType::NONE && v->valueType() != expected) {
+        error = ConfigError::WRONG_TYPE;
+        return nullptr;
+    }
+    error = ConfigError::NONE;
+    return v;
+}
+
+AbstractConfigValue* SimpleConfig::tryFind(const PathPtr& path, ConfigValueType expected, ConfigError& error, AbstractConfigValuePtr& held) {
+    if (indexed.load(std::memory_order_acquire)) {
+        auto v = index->find(path);
+        if (v) {
+            return tryCheck(v, expected, error, held);
+        }
+        // walk to find out why it's missing
+    }
+    try {
+        AbstractConfigObject* o = object.get();
+        uint32_t last = path->length() - 1;
+        for (uint32_t i = 0; i < last; ++i) {
+            auto v = tryCheck(o->peekBorrowed(path->key(i), held), ConfigValueType::OBJECT, error, held);
+            if (!v) {
+                return nullptr;
+            }
+            o = static_cast<AbstractConfigObject*>(v);
+        }
+        return tryCheck(o->peekBorrowed(path->key(last), held), expected, error, held);
+    }
+    catch (ConfigExceptionNotResolved&) {
+        error = ConfigError::NOT_RESOLVED;
+        return nullptr;
+    }
 }
 
 ConfigValuePtr SimpleConfig::getValue(const std::string& path) {
+    return getValue(ConfigPath::parse(path));
+}
+
+ConfigValuePtr SimpleConfig::getValue(const ConfigPathPtr& path) {
     return find(path, ConfigValueType::NONE);
 }
 
 bool SimpleConfig::getBoolean(const std::string& path) {
-    auto v = find(path, ConfigValueType::BOOLEAN);
+    return getBoolean(ConfigPath::parse(path));
+}
+
+bool SimpleConfig::getBoolean(const ConfigPathPtr& path) {
+    AbstractConfigValuePtr held;
+    auto v = find(path, ConfigValueType::BOOLEAN, held);
     return v->unwrapped<bool>();
 }
 
 ConfigNumberPtr SimpleConfig::getConfigNumber(const std::string& path) {
+    return getConfigNumber(ConfigPath::parse(path));
+}
+
+ConfigNumberPtr SimpleConfig::getConfigNumber(const ConfigPathPtr& path) {
     auto v = find(path, ConfigValueType::NUMBER);
     return std::dynamic_pointer_cast<ConfigNumber>(v);
 }
 
 int32_t SimpleConfig::getInt(const std::string& path) {
-    auto n = getConfigNumber(path);
-    return n->intValueRangeChecked(path);
+    return getInt(ConfigPath::parse(path));
+}
+
+int32_t SimpleConfig::getInt(const ConfigPathPtr& path) {
+    AbstractConfigValuePtr held;
+    auto n = dynamic_cast<ConfigNumber*>(find(path, ConfigValueType::NUMBER, held));
+    return n->intValueRangeChecked(path->expression());
 }
 
 int64_t SimpleConfig::getInt64(const std::string& path) {
-    auto u = getConfigNumber(path)->unwrapped();
+    return getInt64(ConfigPath::parse(path));
+}
+
+int64_t SimpleConfig::getInt64(const ConfigPathPtr& path) {
+    AbstractConfigValuePtr held;
+    auto u = find(path, ConfigValueType::NUMBER, held)->unwrapped();
     return boost::apply_visitor(VariantInt64(), u);
 }
 
 double SimpleConfig::getDouble(const std::string& path) {
-    auto u = getConfigNumber(path)->unwrapped();
+    return getDouble(ConfigPath::parse(path));
+}
+
+double SimpleConfig::getDouble(const ConfigPathPtr& path) {
+    AbstractConfigValuePtr held;
+    auto u = find(path, ConfigValueType::NUMBER, held)->unwrapped();
     return boost::apply_visitor(VariantDouble(), u);
 }
 
 std::string SimpleConfig::getString(const std::string& path) {
-    auto v = find(path, ConfigValueType::STRING);
+    return getString(ConfigPath::parse(path));
+}
+
+std::string SimpleConfig::getString(const ConfigPathPtr& path) {
+    AbstractConfigValuePtr held;
+    auto v = find(path, ConfigValueType::STRING, held);
     return v->unwrapped<std::string>();
 }
 
 ConfigListPtr SimpleConfig::getList(const std::string& path) {
+    return getList(ConfigPath::parse(path));
+}
+
+ConfigListPtr SimpleConfig::getList(const ConfigPathPtr& path) {
     auto v = find(path, ConfigValueType::LIST);
     return std::dynamic_pointer_cast<ConfigList>(v);
 }
 
 ConfigObjectPtr SimpleConfig::getObject(const std::string& path) {
+    return getObject(ConfigPath::parse(path));
+}
+
+ConfigObjectPtr SimpleConfig::getObject(const ConfigPathPtr& path) {
     auto obj = std::static_pointer_cast<AbstractConfigObject>(find(path, ConfigValueType::OBJECT));
     return obj;
 }
 
 ConfigPtr SimpleConfig::getConfig(const std::string& path) {
+    return getConfig(ConfigPath::parse(path));
+}
+
+ConfigPtr SimpleConfig::getConfig(const ConfigPathPtr& path) {
     return getObject(path)->toConfig();
 }
 
 ConfigVariant SimpleConfig::getVariant(const std::string& path) {
-    auto v = find(path, ConfigValueType::NONE);
+    return getVariant(ConfigPath::parse(path));
+}
+
+ConfigVariant SimpleConfig::getVariant(const ConfigPathPtr& path) {
+    AbstractConfigValuePtr held;
+    auto v = find(path, ConfigValueType::NONE, held);
     return v->unwrapped();
 }
 
 uint64_t SimpleConfig::getBytes(const std::string& path) {
-    uint64_t size = 0;
-    try {
-        size = getInt64(path);
+    return getBytes(ConfigPath::parse(path));
+}
+
+uint64_t SimpleConfig::getBytes(const ConfigPathPtr& path) {
+    ConfigError error;
+    AbstractConfigValuePtr held;
+    auto n = tryFind(path->path(), ConfigValueType::NUMBER, error, held);
+    if (n) {
+        return boost::apply_visitor(VariantInt64(), n->unwrapped());
     }
-    catch (ConfigExceptionWrongType&) {
-        auto v = find(path, ConfigValueType::STRING);
-        size = parseBytes(v->unwrapped<std::string>(), v->origin(), path);
+    else if (error != ConfigError::WRONG_TYPE) {
+        // throws whatever stopped us finding a number
+        return getInt64(path);
     }
-    return size;
+    auto v = find(path, ConfigValueType::STRING, held);
+    return parseBytes(v->unwrapped<std::string>(), v->origin(), path->expression());
 }
 
 uint64_t SimpleConfig::getMilliseconds(const std::string& path) {
+    return getMilliseconds(ConfigPath::parse(path));
+}
+
+uint64_t SimpleConfig::getMilliseconds(const ConfigPathPtr& path) {
     return getNanoseconds(path) / 1000000;
 }
 
 uint64_t SimpleConfig::getNanoseconds(const std::string& path) {
-    uint64_t size = 0;
+    return getNanoseconds(ConfigPath::parse(path));
+}
+
+uint64_t SimpleConfig::getNanoseconds(const ConfigPathPtr& path) {
+    ConfigError error;
+    AbstractConfigValuePtr held;
+    auto n = tryFind(path->path(), ConfigValueType::NUMBER, error, held);
+    if (n) {
+        return boost::apply_visitor(VariantInt64(), n->unwrapped()) * 1000000;
+    }
+    else if (error != ConfigError::WRONG_TYPE) {
+        // throws whatever stopped us finding a number
+        return getInt64(path) * 1000000;
+    }
+    auto v = find(path, ConfigValueType::STRING, held);
+    return parseDuration(v->unwrapped<std::string>(), v->origin(), path->expression());
+}
+
+ConfigResult<ConfigPathPtr> SimpleConfig::tryParsePath(const std::string& path) {
     try {
-        size = getInt64(path) * 1000000;
+        return ConfigPath::parse(path);
+    }
+    catch (ConfigExceptionBadPath&) {
+        return ConfigError::BAD_PATH;
+    }
+}
+
+ConfigResult<bool> SimpleConfig::tryGetBoolean(const std::string& path) {
+    auto parsed = tryParsePath(path);
+    return parsed ? tryGetBoolean(*parsed) : ConfigResult<bool>(parsed.error());
+}
+
+ConfigResult<bool> SimpleConfig::tryGetBoolean(const ConfigPathPtr& path) {
+    ConfigError error;
+    AbstractConfigValuePtr held;
+    auto v = tryFind(path->path(), ConfigValueType::BOOLEAN, error, held);
+    return v ? ConfigResult<bool>(v->unwrapped<bool>()) : ConfigResult<bool>(error);
+}
+
+ConfigResult<int32_t> SimpleConfig::tryGetInt(const std::string& path) {
+    auto parsed = tryParsePath(path);
+    return parsed ? tryGetInt(*parsed) : ConfigResult<int32_t>(parsed.error());
+}
+
+ConfigResult<int32_t> SimpleConfig::tryGetInt(const ConfigPathPtr& path) {
+    auto value = tryGetInt64(path);
+    if (!value) {
+        return value.error();
+    }
+    else if (*value < std::numeric_limits<int32_t>::min() || *value > std::numeric_limits<int32_t>::max()) {
+        // getInt() reports this as the wrong type too
+        return ConfigError::WRONG_TYPE;
+    }
+    return static_cast<int32_t>(*value);
+}
+
+ConfigResult<int64_t> SimpleConfig::tryGetInt64(const std::string& path) {
+    auto parsed = tryParsePath(path);
+    return parsed ? tryGetInt64(*parsed) : ConfigResult<int64_t>(parsed.error());
+}
+
+ConfigResult<int64_t> SimpleConfig::tryGetInt64(const ConfigPathPtr& path) {
+    ConfigError error;
+    AbstractConfigValuePtr held;
+    auto v = tryFind(path->path(), ConfigValueType::NUMBER, error, held);
+    if (!v) {
+        return error;
+    }
+    return boost::apply_visitor(VariantInt64(), v->unwrapped());
+}
+
+ConfigResult<double> SimpleConfig::tryGetDouble(const std::string& path) {
+    auto parsed = tryParsePath(path);
+    return parsed ? tryGetDouble(*parsed) : ConfigResult<double>(parsed.error());
+}
+
+ConfigResult<double> SimpleConfig::tryGetDouble(const ConfigPathPtr& path) {
+    ConfigError error;
+    AbstractConfigValuePtr held;
+    auto v = tryFind(path->path(), ConfigValueType::NUMBER, error, held);
+    if (!v) {
+        return error;
+    }
+    return boost::apply_visitor(VariantDouble(), v->unwrapped());
+}
+
+ConfigResult<std::string> SimpleConfig::tryGetString(const std::string& path) {
+    auto parsed = tryParsePath(path);
+    return parsed ? tryGetString(*parsed) : ConfigResult<std::string>(parsed.error());
+}
+
+ConfigResult<std::string> SimpleConfig::tryGetString(const ConfigPathPtr& path) {
+    ConfigError error;
+    AbstractConfigValuePtr held;
+    auto v = tryFind(path->path(), ConfigValueType::STRING, error, held);
+    return v ? ConfigResult<std::string>(v->unwrapped<std::string>()) : ConfigResult<std::string>(error);
+}
+
+ConfigResult<uint64_t> SimpleConfig::tryGetBytes(const std::string& path) {
+    auto parsed = tryParsePath(path);
+    return parsed ? tryGetBytes(*parsed) : ConfigResult<uint64_t>(parsed.error());
+}
+
+ConfigResult<uint64_t> SimpleConfig::tryGetBytes(const ConfigPathPtr& path) {
+    ConfigError error;
+    AbstractConfigValuePtr held;
+    auto v = tryFind(path->path(), ConfigValueType::NUMBER, error, held);
+    if (v) {
+        return static_cast<uint64_t>(boost::apply_visitor(VariantInt64(), v->unwrapped()));
+    }
+    else if (error == ConfigError::WRONG_TYPE) {
+        v = tryFind(path->path(), ConfigValueType::STRING, error, held);
+    }
+    if (!v) {
+        return error;
+    }
+    uint64_t bytes = 0;
+    std::string problem;
+    if (!parseBytes(v->unwrapped<std::string>(), bytes, problem)) {
+        return ConfigError::BAD_VALUE;
+    }
+    return bytes;
+}
+
+ConfigResult<uint64_t> SimpleConfig::tryGetMilliseconds(const std::string& path) {
+    auto parsed = tryParsePath(path);
+    return parsed ? tryGetMilliseconds(*parsed) : ConfigResult<uint64_t>(parsed.error());
+}
+
+ConfigResult<uint64_t> SimpleConfig::tryGetMilliseconds(const ConfigPathPtr& path) {
+    auto nanos = tryGetNanoseconds(path);
+    return nanos ? ConfigResult<uint64_t>(*nanos / 1000000) : nanos;
+}
+
+ConfigResult<uint64_t> SimpleConfig::tryGetNanoseconds(const std::string& path) {
+    auto parsed = tryParsePath(path);
+    return parsed ? tryGetNanoseconds(*parsed) : ConfigResult<uint64_t>(parsed.error());
+}
+
+ConfigResult<uint64_t> SimpleConfig::tryGetNanoseconds(const ConfigPathPtr& path) {
+    ConfigError error;
+    AbstractConfigValuePtr held;
+    auto v = tryFind(path->path(), ConfigValueType::NUMBER, error, held);
+    if (v) {
+        return static_cast<uint64_t>(boost::apply_visitor(VariantInt64(), v->unwrapped()) * 1000000);
+    }
+    else if (error == ConfigError::WRONG_TYPE) {
+        v = tryFind(path->path(), ConfigValueType::STRING, error, held);
+    }
+    if (!v) {
+        return error;
     }
-    catch (ConfigExceptionWrongType&) {
-        auto v = find(path, ConfigValueType::STRING);
-        size = parseDuration(v->unwrapped<std::string>(), v->origin(), path);
+    uint64_t nanos = 0;
+    std::string problem;
+    if (!parseDuration(v->unwrapped<std::string>(), nanos, problem)) {
+        return ConfigError::BAD_VALUE;
     }
-    return size;
+    return nanos;
 }
 
-VectorVariant SimpleConfig::getHomogeneousUnwrappedList(const std::string& path, ConfigValueType expected) {
+VectorVariant SimpleConfig::getHomogeneousUnwrappedList(const ConfigPathPtr& path, ConfigValueType expected) {
     VectorVariant variantList;
     auto list = getList(path);
     variantList.reserve(list->size());
     for (auto& cv : *list) {
         // variance would be nice, but stupid cast will do
-        auto v = std::dynamic_pointer_cast<AbstractConfigValue>(cv);
+        auto v = AbstractConfigValue::cast(cv);
         if (expected != ConfigValueType::NONE) {
             v = DefaultTransformer::transform(v, expected);
         }
         if (v->valueType() != expected) {
             throw ConfigExceptionWrongType(
                 v->origin(),
-                path,
+                path->expression(),
                 "list of " + ConfigValueTypeEnum::name(expected),
                 "list of " + ConfigValueTypeEnum::name(v->valueType()));
         }
@@ -247,6 +563,14 @@ VectorVariant SimpleConfig::getHomogeneousUnwrappedList(const std::string& path,
 }
 
 VectorBool SimpleConfig::getBooleanList(const std::string& path) {
+    return getBooleanList(ConfigPath::parse(path));
+}
+
+VectorBool SimpleConfig::getBooleanList(const ConfigPathPtr& path) {
+    ConfigListView<bool> view;
+    if (getSimpleList(path)->booleanView(view)) {
+        return VectorBool(view.begin(), view.end());
+    }
     VectorVariant list = getHomogeneousUnwrappedList(path, ConfigValueType::BOOLEAN);
     VectorBool boolList;
     boolList.reserve(list.size());
@@ -257,16 +581,32 @@ VectorBool SimpleConfig::getBooleanList(const std::string& path) {
 }
 
 VectorInt SimpleConfig::getIntList(const std::string& path) {
+    return getIntList(ConfigPath::parse(path));
+}
+
+VectorInt SimpleConfig::getIntList(const ConfigPathPtr& path) {
+    ConfigListView<int32_t> view;
+    if (getSimpleList(path)->intView(view)) {
+        return VectorInt(view.begin(), view.end());
+    }
     VectorConfigValue list = getHomogeneousWrappedList(path, ConfigValueType::NUMBER);
     VectorInt intList;
     intList.reserve(list.size());
     for (auto& v : list) {
-        intList.push_back(std::dynamic_pointer_cast<ConfigNumber>(v)->intValueRangeChecked(path));
+        intList.push_back(static_cast<ConfigNumber*>(AbstractConfigValue::borrow(v))->intValueRangeChecked(path->expression()));
     }
     return intList;
 }
 
 VectorInt64 SimpleConfig::getInt64List(const std::string& path) {
+    return getInt64List(ConfigPath::parse(path));
+}
+
+VectorInt64 SimpleConfig::getInt64List(const ConfigPathPtr& path) {
+    ConfigListView<int64_t> view;
+    if (getSimpleList(path)->int64View(view)) {
+        return VectorInt64(view.begin(), view.end());
+    }
     VectorVariant list = getHomogeneousUnwrappedList(path, ConfigValueType::NUMBER);
     VectorInt64 int64List;
     int64List.reserve(list.size());
@@ -277,6 +617,14 @@ VectorInt64 SimpleConfig::getInt64List(const std::string& path) {
 }
 
 VectorDouble SimpleConfig::getDoubleList(const std::string& path) {
+    return getDoubleList(ConfigPath::parse(path));
+}
+
+VectorDouble SimpleConfig::getDoubleList(const ConfigPathPtr& path) {
+    ConfigListView<double> view;
+    if (getSimpleList(path)->doubleView(view)) {
+        return VectorDouble(view.begin(), view.end());
+    }
     VectorVariant list = getHomogeneousUnwrappedList(path, ConfigValueType::NUMBER);
     VectorDouble doubleList;
     doubleList.reserve(list.size());
@@ -287,6 +635,10 @@ VectorDouble SimpleConfig::getDoubleList(const std::string& path) {
 }
 
 VectorString SimpleConfig::getStringList(const std::string& path) {
+    return getStringList(ConfigPath::parse(path));
+}
+
+VectorString SimpleConfig::getStringList(const ConfigPathPtr& path) {
     VectorVariant list = getHomogeneousUnwrappedList(path, ConfigValueType::STRING);
     VectorString stringList;
     stringList.reserve(list.size());
@@ -296,20 +648,20 @@ VectorString SimpleConfig::getStringList(const std::string& path) {
     return stringList;
 }
 
-VectorConfigValue SimpleConfig::getHomogeneousWrappedList(const std::string& path, ConfigValueType expected) {
+VectorConfigValue SimpleConfig::getHomogeneousWrappedList(const ConfigPathPtr& path, ConfigValueType expected) {
     VectorConfigValue wrappedList;
     auto list = getList(path);
     wrappedList.reserve(list->size());
     for (auto& cv : *list) {
         // variance would be nice, but stupid cast will do
-        auto v = std::dynamic_pointer_cast<AbstractConfigValue>(cv);
+        auto v = AbstractConfigValue::cast(cv);
         if (expected != ConfigValueType::NONE) {
             v = DefaultTransformer::transform(v, expected);
         }
         if (v->valueType() != expected) {
             throw ConfigExceptionWrongType(
                 v->origin(),
-                path,
+                path->expression(),
                 "list of " + ConfigValueTypeEnum::name(expected),
                 "list of " + ConfigValueTypeEnum::name(v->valueType()));
         }
@@ -319,6 +671,10 @@ VectorConfigValue SimpleConfig::getHomogeneousWrappedList(const std::string& pat
 }
 
 VectorConfigObject SimpleConfig::getObjectList(const std::string& path) {
+    return getObjectList(ConfigPath::parse(path));
+}
+
+VectorConfigObject SimpleConfig::getObjectList(const ConfigPathPtr& path) {
     VectorConfigValue list = getHomogeneousWrappedList(path, ConfigValueType::OBJECT);
     VectorConfigObject objectList;
     objectList.reserve(list.size());
@@ -329,16 +685,24 @@ VectorConfigObject SimpleConfig::getObjectList(const std::string& path) {
 }
 
 VectorConfig SimpleConfig::getConfigList(const std::string& path) {
-    VectorVariant list = getHomogeneousUnwrappedList(path, ConfigValueType::OBJECT);
+    return getConfigList(ConfigPath::parse(path));
+}
+
+VectorConfig SimpleConfig::getConfigList(const ConfigPathPtr& path) {
+    VectorConfigValue list = getHomogeneousWrappedList(path, ConfigValueType::OBJECT);
     VectorConfig configList;
     configList.reserve(list.size());
     for (auto& v : list) {
-        configList.push_back(dynamic_get<ConfigObject>(v)->toConfig());
+        configList.push_back(std::dynamic_pointer_cast<ConfigObject>(v)->toConfig());
     }
     return configList;
 }
 
 VectorVariant SimpleConfig::getVariantList(const std::string& path) {
+    return getVariantList(ConfigPath::parse(path));
+}
+
+VectorVariant SimpleConfig::getVariantList(const ConfigPathPtr& path) {
     VectorVariant variantList;
     auto list = getList(path);
     variantList.reserve(list->size());
@@ -349,6 +713,10 @@ VectorVariant SimpleConfig::getVariantList(const std::string& path) {
 }
 
 VectorInt64 SimpleConfig::getBytesList(const std::string& path) {
+    return getBytesList(ConfigPath::parse(path));
+}
+
+VectorInt64 SimpleConfig::getBytesList(const ConfigPathPtr& path) {
     VectorInt64 int64List;
     auto list = getList(path);
     int64List.reserve(list->size());
@@ -359,12 +727,12 @@ VectorInt64 SimpleConfig::getBytesList(const std::string& path) {
         }
         else if (v->valueType() == ConfigValueType::STRING) {
             std::string s = v->unwrapped<std::string>();
-            int64List.push_back(parseBytes(s, v->origin(), path));
+            int64List.push_back(parseBytes(s, v->origin(), path->expression()));
         }
         else {
             throw ConfigExceptionWrongType(
                 v->origin(),
-                path,
+                path->expression(),
                 "memory size string or number of bytes",
                 ConfigValueTypeEnum::name(v->valueType()));
         }
@@ -373,6 +741,10 @@ VectorInt64 SimpleConfig::getBytesList(const std::string& path) {
 }
 
 VectorInt64 SimpleConfig::getMillisecondsList(const std::string& path) {
+    return getMillisecondsList(ConfigPath::parse(path));
+}
+
+VectorInt64 SimpleConfig::getMillisecondsList(const ConfigPathPtr& path) {
     VectorInt64 nanos = getNanosecondsList(path);
     VectorInt64 int64List;
     int64List.reserve(nanos.size());
@@ -383,6 +755,10 @@ VectorInt64 SimpleConfig::getMillisecondsList(const std::string& path) {
 }
 
 VectorInt64 SimpleConfig::getNanosecondsList(const std::string& path) {
+    return getNanosecondsList(ConfigPath::parse(path));
+}
+
+VectorInt64 SimpleConfig::getNanosecondsList(const ConfigPathPtr& path) {
     VectorInt64 int64List;
     auto list = getList(path);
     int64List.reserve(list->size());
@@ -393,12 +769,12 @@ VectorInt64 SimpleConfig::getNanosecondsList(const std::string& path) {
         }
         else if (v->valueType() == ConfigValueType::STRING) {
             std::string s = v->unwrapped<std::string>();
-            int64List.push_back(parseDuration(s, v->origin(), path));
+            int64List.push_back(parseDuration(s, v->origin(), path->expression()));
         }
         else {
             throw ConfigExceptionWrongType(
                 v->origin(),
-                path,
+                path->expression(),
                 "duration string or number of nanoseconds",
                 ConfigValueTypeEnum::name(v->valueType()));
         }
@@ -406,13 +782,153 @@ VectorInt64 SimpleConfig::getNanosecondsList(const std::string& path) {
     return int64List;
 }
 
+const std::string& SimpleConfig::getStringRef(const std::string& path) {
+    return getStringRef(ConfigPath::parse(path));
+}
+
+const std::string& SimpleConfig::getStringRef(const ConfigPathPtr& path) {
+    // not find(path, STRING), which would convert a number or boolean into
+    // a new value that doesn't outlive this call
+    AbstractConfigValuePtr held;
+    auto v = find(path, ConfigValueType::NONE, held);
+    auto s = v->borrowString();
+    if (!s) {
+        throw ConfigExceptionWrongType(
+            v->origin(),
+            path->path()->render(),
+            ConfigValueTypeEnum::name(ConfigValueType::STRING),
+            ConfigValueTypeEnum::name(v->valueType()));
+    }
+    return *s;
+}
+
+VectorStringRef SimpleConfig::getStringRefList(const std::string& path) {
+    return getStringRefList(ConfigPath::parse(path));
+}
+
+VectorStringRef SimpleConfig::getStringRefList(const ConfigPathPtr& path) {
+    VectorStringRef stringList;
+    auto list = getList(path);
+    stringList.reserve(list->size());
+    for (auto& cv : *list) {
+        auto v = AbstractConfigValue::cast(cv);
+        auto s = v->borrowString();
+        if (!s) {
+            throw ConfigExceptionWrongType(
+                v->origin(),
+                path->expression(),
+                "list of " + ConfigValueTypeEnum::name(ConfigValueType::STRING),
+                "list of " + ConfigValueTypeEnum::name(v->valueType()));
+        }
+        stringList.push_back(std::cref(*s));
+    }
+    return stringList;
+}
+
+SimpleConfigListPtr SimpleConfig::getSimpleList(const ConfigPathPtr& path) {
+    return std::static_pointer_cast<SimpleConfigList>(find(path, ConfigValueType::LIST));
+}
+
+ConfigListView<bool> SimpleConfig::getBooleanListView(const std::string& path) {
+    return getBooleanListView(ConfigPath::parse(path));
+}
+
+ConfigListView<bool> SimpleConfig::getBooleanListView(const ConfigPathPtr& path) {
+    ConfigListView<bool> view;
+    if (!getSimpleList(path)->booleanView(view)) {
+        // the list getter throws the right exception
+        getBooleanList(path);
+        throw ConfigExceptionBugOrBroken("list at " + path->expression() + " converts but wasn't packed");
+    }
+    return view;
+}
+
+void SimpleConfig::getBooleanList(const std::string& path, VectorBool& list) {
+    getBooleanList(ConfigPath::parse(path), list);
+}
+
+void SimpleConfig::getBooleanList(const ConfigPathPtr& path, VectorBool& list) {
+    auto view = getBooleanListView(path);
+    list.assign(view.begin(), view.end());
+}
+
+ConfigListView<int32_t> SimpleConfig::getIntListView(const std::string& path) {
+    return getIntListView(ConfigPath::parse(path));
+}
+
+ConfigListView<int32_t> SimpleConfig::getIntListView(const ConfigPathPtr& path) {
+    ConfigListView<int32_t> view;
+    if (!getSimpleList(path)->intView(view)) {
+        // the list getter throws the right exception
+        getIntList(path);
+        throw ConfigExceptionBugOrBroken("list at " + path->expression() + " converts but wasn't packed");
+    }
+    return view;
+}
+
+void SimpleConfig::getIntList(const std::string& path, VectorInt& list) {
+    getIntList(ConfigPath::parse(path), list);
+}
+
+void SimpleConfig::getIntList(const ConfigPathPtr& path, VectorInt& list) {
+    auto view = getIntListView(path);
+    list.assign(view.begin(), view.end());
+}
+
+ConfigListView<int64_t> SimpleConfig::getInt64ListView(const std::string& path) {
+    return getInt64ListView(ConfigPath::parse(path));
+}
+
+ConfigListView<int64_t> SimpleConfig::getInt64ListView(const ConfigPathPtr& path) {
+    ConfigListView<int64_t> view;
+    if (!getSimpleList(path)->int64View(view)) {
+        // the list getter throws the right exception
+        getInt64List(path);
+        throw ConfigExceptionBugOrBroken("list at " + path->expression() + " converts but wasn't packed");
+    }
+    return view;
+}
+
+void SimpleConfig::getInt64List(const std::string& path, VectorInt64& list) {
+    getInt64List(ConfigPath::parse(path), list);
+}
+
+void SimpleConfig::getInt64List(const ConfigPathPtr& path, VectorInt64& list) {
+    auto view = getInt64ListView(path);
+    list.assign(view.begin(), view.end());
+}
+
+ConfigListView<double> SimpleConfig::getDoubleListView(const std::string& path) {
+    return getDoubleListView(ConfigPath::parse(path));
+}
+
+ConfigListView<double> SimpleConfig::getDoubleListView(const ConfigPathPtr& path) {
+    ConfigListView<double> view;
+    if (!getSimpleList(path)->doubleView(view)) {
+        // the list getter throws the right exception
+        getDoubleList(path);
+        throw ConfigExceptionBugOrBroken("list at " + path->expression() + " converts but wasn't packed");
+    }
+    return view;
+}
+
+void SimpleConfig::getDoubleList(const std::string& path, VectorDouble& list) {
+    getDoubleList(ConfigPath::parse(path), list);
+}
+
+void SimpleConfig::getDoubleList(const ConfigPathPtr& path, VectorDouble& list) {
+    auto view = getDoubleListView(path);
+    list.assign(view.begin(), view.end());
+}
+
 ConfigValuePtr SimpleConfig::toFallbackValue() {
     return object;
 }
 
 ConfigMergeablePtr SimpleConfig::withFallback(const ConfigMergeablePtr& other) {
     // this can return "this" if the withFallback doesn't need a new ConfigObject
-    return std::dynamic_pointer_cast<AbstractConfigObject>(object->withFallback(other))->toConfig();
+    auto fallback = AbstractConfigValue::cast(std::dynamic_pointer_cast<MergeableValue>(other)->toFallbackValue());
+    return std::static_pointer_cast<AbstractConfigObject>(object->withFallbackValue(fallback))->toConfig();
 }
 
 bool SimpleConfig::equals(const ConfigVariant& other) {
@@ -445,6 +961,15 @@ std::string SimpleConfig::getUnits(const std::string& s) {
 }
 
 uint64_t SimpleConfig::parseDuration(const std::string& input, const ConfigOriginPtr& originForException, const std::string& pathForException) {
+    uint64_t nanos = 0;
+    std::string problem;
+    if (!parseDuration(input, nanos, problem)) {
+        throw ConfigExceptionBadValue(originForException, pathForException, problem);
+    }
+    return nanos;
+}
+
+bool SimpleConfig::parseDuration(const std::string& input, uint64_t& nanos, std::string& problem) {
     std::string s = boost::trim_copy(input);
     std::string originalUnitString = getUnits(s);
     std::string unitString = originalUnitString;
@@ -454,10 +979,8 @@ uint64_t SimpleConfig::parseDuration(const std::string& input, const ConfigOrigi
     // this would be caught later anyway, but the error message
     // is more helpful if we check it here.
     if (numberString.empty()) {
-        throw ConfigExceptionBadValue(
-            originForException,
-            pathForException,
-            "No number in duration value '" + input + "'");
+        problem = "No number in duration value '" + input + "'";
+        return false;
     }
 
     if (unitString.length() > 2 && !boost::ends_with(unitString, "s")) {
@@ -487,28 +1010,28 @@ uint64_t SimpleConfig::parseDuration(const std::string& input, const ConfigOrigi
         units = 60000000000LL;
     }
     else {
-        throw ConfigExceptionBadValue(
-            originForException,
-            pathForException,
-            "Could not parse time unit '" + originalUnitString + "' (try ns, us, ms, s, m, d)");
+        problem = "Could not parse time unit '" + originalUnitString + "' (try ns, us, ms, s, m, d)";
+        return false;
     }
 
-    try {
-        // if the string is purely digits, parse as an integer to avoid
-        // possible precision loss; otherwise as a double.
-        if (std::all_of(numberString.begin(), numberString.end(), (int(*)(int))std::isdigit)) {
-            return boost::lexical_cast<int64_t>(numberString) * units;
-        }
-        else {
-            return static_cast<int64_t>(boost::lexical_cast<double>(numberString) * units);
+    // if the string is purely digits, parse as an integer to avoid
+    // possible precision loss; otherwise as a double.
+    if (std::all_of(numberString.begin(), numberString.end(), (int(*)(int))std::isdigit)) {
+        int64_t value;
+        if (NumberParser::parseInt64(numberString, value)) {
+            nanos = value * units;
+            return true;
         }
     }
-    catch (boost::bad_lexical_cast&) {
-        throw ConfigExceptionBadValue(
-            originForException,
-            pathForException,
-            "Could not parse duration number '" + numberString + "'");
+    else {
+        double value;
+        if (NumberParser::parseDouble(numberString, value)) {
+            nanos = static_cast<int64_t>(value * units);
+            return true;
+        }
     }
+    problem = "Could not parse duration number '" + numberString + "'";
+    return false;
 }
 
 MemoryUnit::MemoryUnit(const std::string& prefix, uint32_t powerOf, uint32_t power) :
@@ -589,6 +1112,15 @@ bool MemoryUnit::isNull(const MemoryUnit& unit) {
 }
 
 uint64_t SimpleConfig::parseBytes(const std::string& input, const ConfigOriginPtr& originForException, const std::string& pathForException) {
+    uint64_t bytes = 0;
+    std::string problem;
+    if (!parseBytes(input, bytes, problem)) {
+        throw ConfigExceptionBadValue(originForException, pathForException, problem);
+    }
+    return bytes;
+}
+
+bool SimpleConfig::parseBytes(const std::string& input, uint64_t& bytes, std::string& problem) {
     std::string s = boost::trim_copy(input);
     std::string unitString = getUnits(s);
     std::string numberString = boost::trim_copy(s.substr(0, s.length() - unitString.length()));
@@ -596,35 +1128,34 @@ uint64_t SimpleConfig::parseBytes(const std::string& input, const ConfigOriginPt
     // this would be caught later anyway, but the error message
     // is more helpful if we check it here.
     if (numberString.empty()) {
-        throw ConfigExceptionBadValue(
-            originForException,
-            pathForException,
-            "No number in size-in-bytes value '" + input + "'");
+        problem = "No number in size-in-bytes value '" + input + "'";
+        return false;
     }
     MemoryUnit units = MemoryUnit::parseUnit(unitString);
 
     if (MemoryUnit::isNull(units)) {
-        throw ConfigExceptionBadValue(
-            originForException,
-            pathForException,
-            "Could not parse size-in-bytes unit '" + unitString + "' (try k, K, kB, KiB, kilobytes, kibibytes)");
+        problem = "Could not parse size-in-bytes unit '" + unitString + "' (try k, K, kB, KiB, kilobytes, kibibytes)";
+        return false;
     }
 
-    try {
-        // if the string is purely digits, parse as an integer to avoid
-        // possible precision loss; otherwise as a double.
-        if (std::all_of(numberString.begin(), numberString.end(), (int(*)(int))std::isdigit)) {
-            return boost::lexical_cast<int64_t>(numberString) * units.bytes;
+    // if the string is purely digits, parse as an integer to avoid
+    // possible precision loss; otherwise as a double.
+    if (std::all_of(numberString.begin(), numberString.end(), (int(*)(int))std::isdigit)) {
+        int64_t value;
+        if (NumberParser::parseInt64(numberString, value)) {
+            bytes = value * units.bytes;
+            return true;
         }
-        else {
-            return static_cast<int64_t>(boost::lexical_cast<double>(numberString) * units.bytes);
+    }
+    else {
+        double value;
+        if (NumberParser::parseDouble(numberString, value)) {
+            bytes = static_cast<int64_t>(value * units.bytes);
+            return true;
         }
-    } catch (boost::bad_lexical_cast&) {
-        throw ConfigExceptionBadValue(
-            originForException,
-            pathForException,
-            "Could not parse size-in-bytes number '" + numberString + "'");
     }
+    problem = "Could not parse size-in-bytes number '" + numberString + "'";
+    return false;
 }
 
 AbstractConfigValuePtr SimpleConfig::peekPath(const PathPtr& path) {
@@ -673,7 +1204,7 @@ bool SimpleConfig::couldBeNull(const AbstractConfigValuePtr& v) {
 }
 
 bool SimpleConfig::haveCompatibleTypes(const ConfigValuePtr& reference, const AbstractConfigValuePtr& value) {
-    if (couldBeNull(std::dynamic_pointer_cast<AbstractConfigValue>(reference)) || couldBeNull(value)) {
+    if (couldBeNull(AbstractConfigValue::cast(reference)) || couldBeNull(value)) {
         // we allow any setting to be null
         return true;
     }
@@ -730,7 +1261,7 @@ void SimpleConfig::checkValidObject(const PathPtr& path, const AbstractConfigObj
             addMissing(accumulator, entry.second, childPath, value->origin());
         }
         else {
-            checkValid(childPath, entry.second, std::dynamic_pointer_cast<AbstractConfigValue>(v->second), accumulator);
+            checkValid(childPath, entry.second, AbstractConfigValue::cast(v->second), accumulator);
         }
     }
 }
@@ -752,7 +1283,7 @@ void SimpleConfig::checkValid(const PathPtr& path, const ConfigValuePtr& referen
             else {
                 auto refElement = listRef->at(0);
                 for (auto& elem : *listValue) {
-                    auto e = std::dynamic_pointer_cast<AbstractConfigValue>(elem);
+                    auto e = AbstractConfigValue::cast(elem);
                     if (!haveCompatibleTypes(refElement, e)) {
                         addProblem(accumulator, path, e->origin(), "List at '" + path->render() + "' contains wrong value type, expecting list of " + getDesc(refElement) + " but got element of type " + getDesc(e));
                         // don't add a problem for every last array element
@@ -771,13 +1302,13 @@ void SimpleConfig::checkValid(const ConfigPtr& reference, const VectorString& re
     auto ref = std::dynamic_pointer_cast<SimpleConfig>(reference);
 
     // unresolved reference config is a bug in the caller of checkValid
-    if (std::dynamic_pointer_cast<AbstractConfigValue>(ref->root())->resolveStatus() != ResolveStatus::RESOLVED) {
+    if (AbstractConfigValue::cast(ref->root())->resolveStatus() != ResolveStatus::RESOLVED) {
         throw ConfigExceptionBugOrBroken("do not call checkValid() with an unresolved reference config, call Config#resolve(), see Config#resolve() API docs");
     }
 
     // unresolved config under validation is a bug in something,
     // NotResolved is a more specific subclass of BugOrBroken
-    if (std::dynamic_pointer_cast<AbstractConfigValue>(root())->resolveStatus() != ResolveStatus::RESOLVED) {
+    if (AbstractConfigValue::cast(root())->resolveStatus() != ResolveStatus::RESOLVED) {
         throw ConfigExceptionNotResolved("need to Config#resolve() each config before using it, see the API docs for Config#resolve()");
     }
 
@@ -819,8 +1350,12 @@ ConfigPtr SimpleConfig::withoutPath(const std::string& pathExpression) {
     return make_instance(std::dynamic_pointer_cast<AbstractConfigObject>(root())->withoutPath(path));
 }
 
-ConfigPtr SimpleConfig::withValue(const std::string& pathExpression, const ConfigValuePtr& value) {
-    PathPtr path = Path::newPath(pathExpression);
+ConfigPtr SimpleConfig::withValue(const std::string& path, const ConfigValuePtr& value) {
+    return withValue(ConfigPath::parse(path), value);
+}
+
+ConfigPtr SimpleConfig::withValue(const ConfigPathPtr& pathExpression, const ConfigValuePtr& value) {
+    auto path = pathExpression->path();
     return SimpleConfig::make_instance(std::dynamic_pointer_cast<AbstractConfigObject>(std::dynamic_pointer_cast<AbstractConfigObject>(root())->withValue(path, value)));
 }
 
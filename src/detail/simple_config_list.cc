@@ -7,19 +7,32 @@
 #include "configcpp/detail/simple_config_origin.h"
 #include "configcpp/detail/resolve_status.h"
 #include "configcpp/detail/resolve_context.h"
+#include "configcpp/detail/default_transformer.h"
+#include "configcpp/detail/variant_utils.h"
 #include "configcpp/config_value_type.h"
 #include "configcpp/config_render_options.h"
 #include "configcpp/config_origin.h"
 
 namespace config {
 
+/// The list's values as the AbstractConfigValues they are
+static VectorAbstractConfigValue abstractValues(const VectorConfigValue& values) {
+    VectorAbstractConfigValue abstract;
+    abstract.reserve(values.size());
+    for (auto& v : values) {
+        abstract.push_back(AbstractConfigValue::cast(v));
+    }
+    return abstract;
+}
+
 SimpleConfigList::SimpleConfigList(const ConfigOriginPtr& origin, const VectorAbstractConfigValue& value) :
     SimpleConfigList(origin, value, ResolveStatusEnum::fromValues(value)) {
 }
 
 SimpleConfigList::SimpleConfigList(const ConfigOriginPtr& origin, const VectorAbstractConfigValue& value, ResolveStatus status) :
-    AbstractConfigValue(origin),
-    value(value.begin(), value.end()) {
+    AbstractConfigValue(origin, ConfigValueKind::LIST),
+    value(value.begin(), value.end()),
+    packed(nullptr) {
     resolved = (status == ResolveStatus::RESOLVED);
     // kind of an expensive debug check (makes this constructor pointless)
     if (status != ResolveStatusEnum::fromValues(value)) {
@@ -27,6 +40,141 @@ SimpleConfigList::SimpleConfigList(const ConfigOriginPtr& origin, const VectorAb
     }
 }
 
+SimpleConfigList::~SimpleConfigList() {
+    Packed* p = packed.load();
+    if (p) {
+        ConfigMemoryAllocator<Packed> allocator(value.get_allocator());
+        p->~Packed();
+        allocator.deallocate(p, 1);
+    }
+}
+
+template <typename T>
+static void freePacking(T* values, const VectorConfigValue::allocator_type& allocator, std::size_t size) {
+    if (values) {
+        ConfigMemoryAllocator<T>(allocator).deallocate(values, size);
+    }
+}
+
+SimpleConfigList::Packed::Packed(const VectorConfigValue::allocator_type& allocator, std::size_t size) :
+    allocator(allocator),
+    size(size) {
+}
+
+SimpleConfigList::Packed::~Packed() {
+    freePacking(ints.values, allocator, size);
+    freePacking(int64s.values, allocator, size);
+    freePacking(doubles.values, allocator, size);
+    freePacking(booleans.values, allocator, size);
+}
+
+/// v converted to type as the list getters would, or null if it doesn't.
+static AbstractConfigValuePtr convert(const ConfigValuePtr& v, ConfigValueType type) {
+    auto converted = AbstractConfigValue::cast(v);
+    if (converted->valueType() != type) {
+        converted = DefaultTransformer::transform(converted, type);
+    }
+    return converted->valueType() == type ? converted : nullptr;
+}
+
+static bool unbox(const ConfigValuePtr& v, int64_t& unboxed) {
+    auto n = convert(v, ConfigValueType::NUMBER);
+    if (!n) {
+        return false;
+    }
+    unboxed = boost::apply_visitor(VariantInt64(), n->unwrapped());
+    return true;
+}
+
+static bool unbox(const ConfigValuePtr& v, int32_t& unboxed) {
+    int64_t l = 0;
+    if (!unbox(v, l) || l < std::numeric_limits<int32_t>::min() || l > std::numeric_limits<int32_t>::max()) {
+        return false;
+    }
+    unboxed = static_cast<int32_t>(l);
+    return true;
+}
+
+static bool unbox(const ConfigValuePtr& v, double& unboxed) {
+    auto n = convert(v, ConfigValueType::NUMBER);
+    if (!n) {
+        return false;
+    }
+    unboxed = boost::apply_visitor(VariantDouble(), n->unwrapped());
+    return true;
+}
+
+static bool unbox(const ConfigValuePtr& v, bool& unboxed) {
+    auto b = convert(v, ConfigValueType::BOOLEAN);
+    if (!b) {
+        return false;
+    }
+    unboxed = variant_get<bool>(b->unwrapped());
+    return true;
+}
+
+template <typename T>
+bool SimpleConfigList::packedView(Packing<T> Packed::* member, ConfigListView<T>& view) {
+    if (!resolved) {
+        return false;
+    }
+    if (value.empty()) {
+        view = ConfigListView<T>();
+        return true;
+    }
+
+    // lists are shared between threads, so each packing is made just once
+    Packed* p = packed.load(std::memory_order_acquire);
+    if (!p) {
+        ConfigMemoryAllocator<Packed> allocator(value.get_allocator());
+        Packed* made = ::new (static_cast<void*>(allocator.allocate(1))) Packed(value.get_allocator(), value.size());
+        if (packed.compare_exchange_strong(p, made, std::memory_order_acq_rel)) {
+            p = made;
+        }
+        else {
+            made->~Packed();
+            allocator.deallocate(made, 1);
+        }
+    }
+    auto& packing = p->*member;
+    if (!packing.done.load(std::memory_order_acquire)) {
+        std::call_once(packing.once, [this, &packing]() {
+            ConfigMemoryAllocator<T> allocator(value.get_allocator());
+            T* values = allocator.allocate(value.size());
+            for (uint32_t i = 0; i < value.size(); ++i) {
+                if (!unbox(value[i], values[i])) {
+                    allocator.deallocate(values, value.size());
+                    values = nullptr;
+                    break;
+                }
+            }
+            packing.values = values;
+            packing.done.store(true, std::memory_order_release);
+        });
+    }
+    if (!packing.values) {
+        return false;
+    }
+    view = ConfigListView<T>(packing.values, value.size());
+    return true;
+}
+
+bool SimpleConfigList::intView(ConfigListView<int32_t>& view) {
+    return packedView(&Packed::ints, view);
+}
+
+bool SimpleConfigList::int64View(ConfigListView<int64_t>& view) {
+    return packedView(&Packed::int64s, view);
+}
+
+bool SimpleConfigList::doubleView(ConfigListView<double>& view) {
+    return packedView(&Packed::doubles, view);
+}
+
+bool SimpleConfigList::booleanView(ConfigListView<bool>& view) {
+    return packedView(&Packed::booleans, view);
+}
+
 ConfigValueType SimpleConfigList::valueType() {
     return ConfigValueType::LIST;
 }
@@ -61,12 +209,12 @@ SimpleConfigListPtr SimpleConfigList::modifyMayThrow(const ModifierPtr& modifier
     boost::optional<VectorAbstractConfigValue> changed;
     uint32_t i = 0;
     for (auto& v : value) {
-        auto modified = modifier->modifyChildMayThrow("", std::dynamic_pointer_cast<AbstractConfigValue>(v));
+        auto modified = modifier->modifyChildMayThrow("", AbstractConfigValue::cast(v));
 
         if (!changed && modified != v) {
             changed = VectorAbstractConfigValue();
             for (uint32_t j = 0; j < i; ++j) {
-                changed->push_back(std::dynamic_pointer_cast<AbstractConfigValue>(value[j]));
+                changed->push_back(AbstractConfigValue::cast(value[j]));
             }
         }
 
@@ -145,7 +293,7 @@ bool SimpleConfigList::equals(const ConfigVariant& other) {
                 this->value.size() == dynamic_get<SimpleConfigList>(other)->value.size() &&
                 std::equal(this->value.begin(), this->value.end(), dynamic_get<SimpleConfigList>(other)->value.begin(),
                     [&](const VectorConfigValue::value_type& first, const VectorConfigValue::value_type& second) {
-                        return configEquals<AbstractConfigValuePtr>()(std::dynamic_pointer_cast<AbstractConfigValue>(first), std::dynamic_pointer_cast<AbstractConfigValue>(second));
+                        return configEquals<AbstractConfigValuePtr>()(AbstractConfigValue::cast(first), AbstractConfigValue::cast(second));
                 });
     }
     else {
@@ -157,7 +305,7 @@ uint32_t SimpleConfigList::hashCode() {
     // note that "origin" is deliberately NOT part of equality
     size_t hash = 0;
     for (auto& v : value) {
-        boost::hash_combine(hash, std::dynamic_pointer_cast<AbstractConfigValue>(v)->hashCode());
+        boost::hash_combine(hash, AbstractConfigValue::cast(v)->hashCode());
     }
     return static_cast<uint32_t>(hash);
 }
@@ -188,7 +336,7 @@ void SimpleConfigList::render(std::string& s, uint32_t indent_, const ConfigRend
             }
             indent(s, indent_ + 1, options);
 
-            std::dynamic_pointer_cast<AbstractConfigValue>(v)->render(s, indent_ + 1, options);
+            AbstractConfigValue::cast(v)->render(s, indent_ + 1, options);
             s += ",";
             if (options->getFormatted()) {
                 s += "\n";
@@ -261,14 +409,14 @@ ConfigExceptionUnsupportedOperation SimpleConfigList::weAreImmutable(const std::
 }
 
 AbstractConfigValuePtr SimpleConfigList::newCopy(const ConfigOriginPtr& newOrigin) {
-    return SimpleConfigList::make_instance(newOrigin, MiscUtils::dynamic_vector<VectorAbstractConfigValue>(value));
+    return SimpleConfigList::make_instance(newOrigin, abstractValues(value));
 }
 
 SimpleConfigListPtr SimpleConfigList::concatenate(const SimpleConfigListPtr& other) {
     auto combinedOrigin = SimpleConfigOrigin::mergeOrigins(origin(), other->origin());
     VectorConfigValue combined(value);
     combined.insert(combined.end(), other->value.begin(), other->value.end());
-    return SimpleConfigList::make_instance(combinedOrigin, MiscUtils::dynamic_vector<VectorAbstractConfigValue>(combined));
+    return SimpleConfigList::make_instance(combinedOrigin, abstractValues(combined));
 }
 
 }
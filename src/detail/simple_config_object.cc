@@ -15,7 +15,7 @@
 namespace config {
 
 SimpleConfigObject::SimpleConfigObject(const ConfigOriginPtr& origin, const MapAbstractConfigValue& value, ResolveStatus status, bool ignoresFallbacks) :
-    AbstractConfigObject(origin),
+    AbstractConfigObject(origin, ConfigValueKind::OBJECT),
     value(value.begin(), value.end()),
     ignoresFallbacks_(ignoresFallbacks) {
     resolved = (status == ResolveStatus::RESOLVED);
@@ -38,14 +38,24 @@ ConfigObjectPtr SimpleConfigObject::withoutKey(const std::string& key) {
     return withoutPath(Path::newKey(key));
 }
 
+/// The children as AbstractConfigValues, to build a new object from.
+static MapAbstractConfigValue abstractValues(const MapConfigValue& values) {
+    MapAbstractConfigValue abstract;
+    abstract.reserve(values.size());
+    for (auto& kv : values) {
+        abstract.insert(std::make_pair(kv.key, AbstractConfigValue::cast(kv.second)));
+    }
+    return abstract;
+}
+
 AbstractConfigObjectPtr SimpleConfigObject::withOnlyPathOrNull(const PathPtr& path) {
-    std::string key = path->first();
+    const std::string& key = path->first();
     auto next = path->remainder();
     auto val = value.find(key);
-    auto v = val == value.end() ? nullptr : std::dynamic_pointer_cast<AbstractConfigValue>(val->second);
+    auto v = val == value.end() ? nullptr : AbstractConfigValue::cast(val->second);
 
     if (next) {
-        if (v && instanceof<AbstractConfigObject>(v)) {
+        if (v && v->isObject()) {
             v = std::static_pointer_cast<AbstractConfigObject>(v)->withOnlyPathOrNull(next);
         }
         else {
@@ -74,14 +84,14 @@ AbstractConfigObjectPtr SimpleConfigObject::withOnlyPath(const PathPtr& path) {
 }
 
 AbstractConfigObjectPtr SimpleConfigObject::withoutPath(const PathPtr& path) {
-    std::string key = path->first();
+    const std::string& key = path->first();
     auto next = path->remainder();
     auto val = value.find(key);
-    auto v = val == value.end() ? nullptr : std::dynamic_pointer_cast<AbstractConfigValue>(val->second);
+    auto v = val == value.end() ? nullptr : AbstractConfigValue::cast(val->second);
 
-    if (v && next && instanceof<AbstractConfigObject>(v)) {
+    if (v && next && v->isObject()) {
         v = std::static_pointer_cast<AbstractConfigObject>(v)->withoutPath(next);
-        MapAbstractConfigValue updated = MiscUtils::dynamic_map<MapAbstractConfigValue>(value);
+        MapAbstractConfigValue updated = abstractValues(value);
         updated[key] = v;
         return SimpleConfigObject::make_instance(origin(), updated, ResolveStatusEnum::fromValues(updated), ignoresFallbacks_);
     }
@@ -93,7 +103,7 @@ AbstractConfigObjectPtr SimpleConfigObject::withoutPath(const PathPtr& path) {
         MapAbstractConfigValue smaller;
         for (auto& old : value) {
             if (old.first != key) {
-                smaller[old.first] = std::dynamic_pointer_cast<AbstractConfigValue>(old.second);
+                smaller[old.key] = AbstractConfigValue::cast(old.second);
             }
         }
         return SimpleConfigObject::make_instance(origin(), smaller, ResolveStatusEnum::fromValues(smaller), ignoresFallbacks_);
@@ -107,18 +117,18 @@ ConfigObjectPtr SimpleConfigObject::withValue(const std::string& key, const Conf
 
     MapAbstractConfigValue newMap;
     if (value.empty()) {
-        newMap = {{key, std::dynamic_pointer_cast<AbstractConfigValue>(v)}};
+        newMap = {{key, AbstractConfigValue::cast(v)}};
     }
     else {
-        newMap = MiscUtils::dynamic_map<MapAbstractConfigValue>(value);
-        newMap[key] = std::dynamic_pointer_cast<AbstractConfigValue>(v);
+        newMap = abstractValues(value);
+        newMap[key] = AbstractConfigValue::cast(v);
     }
 
     return SimpleConfigObject::make_instance(origin(), newMap, ResolveStatusEnum::fromValues(newMap), ignoresFallbacks_);
 }
 
 ConfigObjectPtr SimpleConfigObject::withValue(const PathPtr& path, const ConfigValuePtr& v) {
-    std::string key = path->first();
+    const std::string& key = path->first();
     PathPtr next = path->remainder();
 
     if (!next) {
@@ -126,27 +136,32 @@ ConfigObjectPtr SimpleConfigObject::withValue(const PathPtr& path, const ConfigV
     }
     else {
         auto val = value.find(key);
-        auto child = val == value.end() ? nullptr : val->second;
-        if (child && instanceof<AbstractConfigObject>(child)) {
+        auto child = val == value.end() ? nullptr : AbstractConfigValue::cast(val->second);
+        if (child && child->isObject()) {
             // if we have an object, add to it
-            return withValue(key, std::dynamic_pointer_cast<ConfigValue>(std::dynamic_pointer_cast<AbstractConfigObject>(child)->withValue(next, v)));
+            return withValue(key, std::static_pointer_cast<AbstractConfigObject>(child)->withValue(next, v));
         }
         else {
             // as soon as we have a non-object, replace it entirely
-            SimpleConfigPtr subtree = std::dynamic_pointer_cast<AbstractConfigValue>(v)->atPath(
+            SimpleConfigPtr subtree = AbstractConfigValue::cast(v)->atPath(
                 SimpleConfigOrigin::newSimple("withValue(" + next->render() + ")"), next);
             return withValue(key, subtree->root());
         }
     }
 }
 
-AbstractConfigValuePtr SimpleConfigObject::attemptPeekWithPartialResolve(const std::string& key) {
+AbstractConfigValuePtr SimpleConfigObject::attemptPeekWithPartialResolve(const InternedString& key) {
+    auto val = value.find(key);
+    return val == value.end() ? nullptr : AbstractConfigValue::cast(val->second);
+}
+
+AbstractConfigValue* SimpleConfigObject::peekBorrowed(const InternedString& key, AbstractConfigValuePtr& held) {
     auto val = value.find(key);
-    return val == value.end() ? nullptr : std::dynamic_pointer_cast<AbstractConfigValue>(val->second);
+    return val == value.end() ? nullptr : AbstractConfigValue::borrow(val->second);
 }
 
 AbstractConfigObjectPtr SimpleConfigObject::newCopy(ResolveStatus newStatus, const ConfigOriginPtr& newOrigin, bool newIgnoresFallbacks) {
-    return SimpleConfigObject::make_instance(newOrigin, MiscUtils::dynamic_map<MapAbstractConfigValue>(value), newStatus, newIgnoresFallbacks);
+    return SimpleConfigObject::make_instance(newOrigin, abstractValues(value), newStatus, newIgnoresFallbacks);
 }
 
 AbstractConfigObjectPtr SimpleConfigObject::newCopy(ResolveStatus newStatus, const ConfigOriginPtr& newOrigin) {
@@ -181,7 +196,7 @@ ConfigVariant SimpleConfigObject::unwrapped() {
 AbstractConfigValuePtr SimpleConfigObject::mergedWithObject(const AbstractConfigObjectPtr& abstractFallback) {
     requireNotIgnoringFallbacks();
 
-    if (!instanceof<SimpleConfigObject>(abstractFallback)) {
+    if (abstractFallback->kind() != ConfigValueKind::OBJECT) {
         throw ConfigExceptionBugOrBroken("should not be reached (merging non-SimpleConfigObject)");
     }
 
@@ -190,21 +205,21 @@ AbstractConfigValuePtr SimpleConfigObject::mergedWithObject(const AbstractConfig
     bool changed = false;
     bool allResolved = true;
     MapAbstractConfigValue merged;
-    SetString allKeys;
+    SetInternedString allKeys;
 
     for (auto& v : value) {
-        allKeys.insert(v.first);
+        allKeys.insert(v.key);
     }
     for (auto& v : fallback->value) {
-        allKeys.insert(v.first);
+        allKeys.insert(v.key);
     }
 
     for (auto& key : allKeys) {
         auto firstVal = value.find(key);
-        auto first = firstVal == value.end() ? nullptr : std::dynamic_pointer_cast<AbstractConfigValue>(firstVal->second);
+        auto first = firstVal == value.end() ? nullptr : AbstractConfigValue::cast(firstVal->second);
 
         auto secondVal = fallback->value.find(key);
-        auto second = secondVal == fallback->value.end() ? nullptr : std::dynamic_pointer_cast<AbstractConfigValue>(secondVal->second);
+        auto second = secondVal == fallback->value.end() ? nullptr : AbstractConfigValue::cast(secondVal->second);
 
         AbstractConfigValuePtr kept;
         if (!first) {
@@ -214,7 +229,7 @@ AbstractConfigValuePtr SimpleConfigObject::mergedWithObject(const AbstractConfig
             kept = first;
         }
         else {
-            kept = std::dynamic_pointer_cast<AbstractConfigValue>(first->withFallback(second));
+            kept = first->withFallbackValue(second);
         }
 
         merged[key] = kept;
@@ -260,12 +275,12 @@ SimpleConfigObjectPtr SimpleConfigObject::modifyMayThrow(const ModifierPtr& modi
     for (auto& kv : value) {
         // "modified" may be null, which means remove the child;
         // to do that we put null in the "changes" map.
-        auto modified = modifier->modifyChildMayThrow(kv.first, std::dynamic_pointer_cast<AbstractConfigValue>(kv.second));
+        auto modified = modifier->modifyChildMayThrow(kv.first, AbstractConfigValue::cast(kv.second));
         if (modified != kv.second) {
             if (!changes) {
                 changes = MapAbstractConfigValue();
             }
-            (*changes)[kv.first] = modified;
+            (*changes)[kv.key] = modified;
         }
     }
 
@@ -276,10 +291,10 @@ SimpleConfigObjectPtr SimpleConfigObject::modifyMayThrow(const ModifierPtr& modi
         MapAbstractConfigValue modified;
         bool sawUnresolved = false;
         for (auto& kv : value) {
-            if (changes->count(kv.first) > 0) {
-                auto newValue = changes->find(kv.first);
+            if (changes->count(kv.key) > 0) {
+                auto newValue = changes->find(kv.key);
                 if (newValue != changes->end() && newValue->second) {
-                    modified[kv.first] = newValue->second;
+                    modified[kv.key] = newValue->second;
                     if (newValue->second->resolveStatus() == ResolveStatus::UNRESOLVED) {
                         sawUnresolved = true;
                     }
@@ -289,9 +304,9 @@ SimpleConfigObjectPtr SimpleConfigObject::modifyMayThrow(const ModifierPtr& modi
                 }
             }
             else {
-                auto newValue = value.find(kv.first);
-                modified[kv.first] = std::dynamic_pointer_cast<AbstractConfigValue>(newValue->second);
-                if (std::dynamic_pointer_cast<AbstractConfigValue>(newValue->second)->resolveStatus() == ResolveStatus::UNRESOLVED) {
+                auto newValue = value.find(kv.key);
+                modified[kv.key] = AbstractConfigValue::cast(newValue->second);
+                if (AbstractConfigValue::cast(newValue->second)->resolveStatus() == ResolveStatus::UNRESOLVED) {
                     sawUnresolved = true;
                 }
             }
@@ -391,7 +406,7 @@ void SimpleConfigObject::render(std::string& s, uint32_t indent_, const ConfigRe
                 }
             }
             indent(s, indent_ + 1, options);
-            std::dynamic_pointer_cast<AbstractConfigValue>(kv.second)->render(s, indent_ + 1, kv.first, options);
+            AbstractConfigValue::cast(kv.second)->render(s, indent_ + 1, kv.first, options);
 
             if (options->getFormatted()) {
                 if (options->getJson()) {
@@ -439,7 +454,7 @@ uint32_t SimpleConfigObject::mapHash(const MapConfigValue& m) {
     uint32_t valuesHash = 0;
     size_t keysHash = 0;
     for (auto& k : keys) {
-        valuesHash += std::dynamic_pointer_cast<AbstractConfigValue>(m.find(k)->second)->hashCode();
+        valuesHash += AbstractConfigValue::cast(m.find(k)->second)->hashCode();
         boost::hash_combine(keysHash, std::hash<std::string>()(k));
     }
     return 41 * (41 + static_cast<uint32_t>(keysHash)) + valuesHash;
@@ -497,7 +512,9 @@ MapConfigValue::const_iterator SimpleConfigObject::find(const MapConfigValue::ke
 
 SimpleConfigObjectPtr SimpleConfigObject::makeEmpty() {
     static std::string EMPTY_NAME = "empty config";
-    static auto emptyInstance = makeEmpty(SimpleConfigOrigin::newSimple(EMPTY_NAME));
+    static auto emptyInstance = ConfigHeapScope::make([]() {
+        return makeEmpty(SimpleConfigOrigin::newSimple(EMPTY_NAME));
+    });
     return emptyInstance;
 }
 
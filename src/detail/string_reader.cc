@@ -9,19 +9,40 @@ namespace config {
 
 StringReader::StringReader(const std::string& str) :
     str(str),
-    position(0) {
+    begin(this->str.data()),
+    end(this->str.data() + this->str.length()),
+    position(begin) {
+}
+
+StringReader::StringReader(const char* begin, const char* end) :
+    begin(begin),
+    end(end),
+    position(begin) {
 }
 
 int32_t StringReader::read() {
-    if (position >= str.length()) {
+    if (position == end) {
         return READER_EOF;
     }
-    return static_cast<int32_t>(str[position++]);
+    return static_cast<int32_t>(*position++);
+}
+
+bool StringReader::readChunk(const char*& begin, const char*& end) {
+    begin = position;
+    end = this->end;
+    position = this->end;
+    return begin != end;
+}
+
+void StringReader::readRemaining(std::string& buffer, const char*& begin, const char*& end) {
+    begin = position;
+    end = this->end;
+    position = this->end;
 }
 
 void StringReader::close() {
     str.clear();
-    position = 0;
+    begin = end = position = nullptr;
 }
 
 }
@@ -6,6 +6,7 @@
 #include "configcpp/detail/token.h"
 #include "configcpp/detail/token_type.h"
 #include "configcpp/detail/variant_utils.h"
+#include "configcpp/detail/simple_config_origin.h"
 #include "configcpp/config_exception.h"
 #include "configcpp/config_origin.h"
 
@@ -14,7 +15,8 @@ namespace config {
 Token::Token(TokenType tokenType, const ConfigOriginPtr& origin, const std::string& debugString) :
     tokenType_(tokenType),
     debugString_(debugString),
-    origin_(origin) {
+    origin_(origin),
+    originLine_(-1) {
 }
 
 TokenPtr Token::newWithoutOrigin(TokenType tokenType, const std::string& debugString) {
@@ -31,11 +33,17 @@ ConfigOriginPtr Token::origin() {
     if (!origin_) {
         throw ConfigExceptionBugOrBroken("tried to get origin from token that doesn't have one: " + toString());
     }
+    if (originLine_ >= 0) {
+        return std::dynamic_pointer_cast<SimpleConfigOrigin>(origin_)->setLineNumber(originLine_);
+    }
     return origin_;
 }
 
 int32_t Token::lineNumber() {
-    if (origin_) {
+    if (originLine_ >= 0) {
+        return originLine_;
+    }
+    else if (origin_) {
         return origin_->lineNumber();
     }
     else {
@@ -43,6 +51,18 @@ int32_t Token::lineNumber() {
     }
 }
 
+void Token::setOriginLine(int32_t lineNumber) {
+    originLine_ = lineNumber;
+}
+
+ConfigOriginPtr Token::baseOrigin() {
+    return origin_;
+}
+
+int32_t Token::originLine() {
+    return originLine_;
+}
+
 std::string Token::toString() {
     if (!debugString_.empty()) {
         return debugString_;
@@ -6,9 +6,14 @@
 #include "configcpp/detail/tokenizer.h"
 #include "configcpp/detail/token.h"
 #include "configcpp/detail/tokens.h"
+#include "configcpp/detail/token_type.h"
 #include "configcpp/detail/simple_config_origin.h"
-#include "configcpp/detail/reader.h"
+#include "configcpp/detail/chunk_reader.h"
+#include "configcpp/detail/char_scanner.h"
+#include "configcpp/detail/number_parser.h"
 #include "configcpp/config_syntax.h"
+#include "configcpp/config_origin_detail.h"
+#include "configcpp/config_value_type.h"
 
 namespace config {
 
@@ -34,7 +39,11 @@ std::string Tokenizer::asString(int32_t codepoint) {
 }
 
 TokenIteratorPtr Tokenizer::tokenize(const ConfigOriginPtr& origin, const ReaderPtr& input, ConfigSyntax flavor) {
-    return TokenStream::make_instance(origin, input, flavor != ConfigSyntax::JSON);
+    return tokenize(origin, input, flavor, ConfigOriginDetail::FULL);
+}
+
+TokenIteratorPtr Tokenizer::tokenize(const ConfigOriginPtr& origin, const ReaderPtr& input, ConfigSyntax flavor, ConfigOriginDetail originDetail) {
+    return TokenStream::make_instance(origin, input, flavor != ConfigSyntax::JSON, originDetail);
 }
 
 WhitespaceSaver::WhitespaceSaver() :
@@ -43,43 +52,50 @@ WhitespaceSaver::WhitespaceSaver() :
 
 void WhitespaceSaver::add(int32_t c) {
     if (lastTokenWasSimpleValue) {
-        whitespace << static_cast<char>(c);
+        whitespace += static_cast<char>(c);
+    }
+}
+
+void WhitespaceSaver::add(const char* begin, const char* end) {
+    if (lastTokenWasSimpleValue) {
+        whitespace.append(begin, end);
     }
 }
 
-TokenPtr WhitespaceSaver::check(const TokenPtr& t, const ConfigOriginPtr& baseOrigin, int32_t lineNumber) {
+bool WhitespaceSaver::check(const Lexeme& t, Lexeme& whitespace, int32_t lineNumber) {
     if (TokenStream::isSimpleValue(t)) {
-        return nextIsASimpleValue(baseOrigin, lineNumber);
+        return nextIsASimpleValue(whitespace, lineNumber);
     }
     else {
         nextIsNotASimpleValue();
-        return nullptr;
+        return false;
     }
 }
 
 void WhitespaceSaver::nextIsNotASimpleValue() {
     lastTokenWasSimpleValue = false;
-    whitespace.str("");
+    whitespace.clear();
 }
 
-TokenPtr WhitespaceSaver::nextIsASimpleValue(const ConfigOriginPtr& baseOrigin, int32_t lineNumber) {
+bool WhitespaceSaver::nextIsASimpleValue(Lexeme& whitespace, int32_t lineNumber) {
     if (lastTokenWasSimpleValue) {
         // need to save whitespace between the two so
         // the parser has the option to concatenate it.
-        if (!whitespace.str().empty()) {
-            auto t = Tokens::newUnquotedText(TokenStream::lineOrigin(baseOrigin, lineNumber), whitespace.str());
-            whitespace.str(""); // reset
-            return t;
+        if (!this->whitespace.empty()) {
+            whitespace.reset(TokenType::UNQUOTED_TEXT, lineNumber);
+            whitespace.text.swap(this->whitespace);
+            this->whitespace.clear(); // reset
+            return true;
         }
         else {
             // lastTokenWasSimpleValue = true still
-            return nullptr;
+            return false;
         }
     }
     else {
         lastTokenWasSimpleValue = true;
-        whitespace.str("");
-        return nullptr;
+        this->whitespace.clear();
+        return false;
     }
 }
 
@@ -96,49 +112,86 @@ TokenPtr TokenIterator::next() {
     return *begin++;
 }
 
-const std::string TokenStream::firstNumberChars = "0123456789-";
-const std::string TokenStream::numberChars = "0123456789eE+-.";
-const std::string TokenStream::notInUnquotedText = "$\"{}[]:=,+#`^?!@*&\\";
+void TokenIterator::nextLexeme(Lexeme& lexeme) {
+    lexeme = Lexeme::fromToken(next());
+}
+
+const uint8_t TokenStream::charClasses[256] = {
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x23, 0x21, 0x23, 0x23, 0x23, 0x20, 0x20, // 0x00 - 0x0f
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, // 0x10 - 0x1f
+    0x03, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x0c, 0x04, 0x18, 0x08, 0x00, // 0x20 - 0x2f
+    0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x04, 0x00, 0x00, 0x04, 0x00, 0x04, // 0x30 - 0x3f
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x40 - 0x4f
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04, 0x00, // 0x50 - 0x5f
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x60 - 0x6f
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x20, // 0x70 - 0x7f
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x80 - 0x8f
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x90 - 0x9f
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0xa0 - 0xaf
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0xb0 - 0xbf
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0xc0 - 0xcf
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0xd0 - 0xdf
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0xe0 - 0xef
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00  // 0xf0 - 0xff
+};
 
-TokenStream::TokenStream(const ConfigOriginPtr& origin, const ReaderPtr& input, bool allowComments) :
+bool TokenStream::isCharClass(int32_t c, uint8_t classes) {
+    // -1 (end of input) maps to 0xff, which is in no class
+    return (charClasses[static_cast<uint8_t>(c)] & classes) != 0;
+}
+
+TokenStream::TokenStream(const ConfigOriginPtr& origin, const ReaderPtr& input, bool allowComments, ConfigOriginDetail originDetail) :
     origin_(std::dynamic_pointer_cast<SimpleConfigOrigin>(origin)),
-    input(input),
+    input(ReaderChunkAdapter::adapt(input)),
     allowComments(allowComments),
+    keepComments(originDetail == ConfigOriginDetail::FULL),
+    keepValueLines(originDetail != ConfigOriginDetail::FILE),
     lineNumber(1),
-    lineOrigin_(origin_->setLineNumber(lineNumber)),
-    tokens(1, Tokens::START()),
-    whitespaceSaver(WhitespaceSaver::make_instance()) {
+    started(false),
+    ended(false),
+    havePending(false),
+    cursor(nullptr),
+    limit(nullptr),
+    bufferSize(0),
+    whitespaceSaver() {
+}
+
+bool TokenStream::nextChunk() {
+    try {
+        return input->readChunk(cursor, limit);
+    }
+    catch (ConfigExceptionIO& e) {
+        throw ConfigExceptionIO(origin_, std::string("read error: ") + e.what());
+    }
+}
+
+bool TokenStream::haveChunk() {
+    return bufferSize == 0 && cursor != limit;
 }
 
 int32_t TokenStream::nextCharRaw() {
-    if (buffer.empty()) {
-        try {
-            return input->read();
-        }
-        catch (ConfigExceptionIO& e) {
-            throw ConfigExceptionIO(origin_, std::string("read error: ") + e.what());
-        }
+    if (bufferSize > 0) {
+        return buffer[--bufferSize];
     }
-    else {
-        int32_t c = buffer.front();
-        buffer.pop_front();
-        return c;
+    if (cursor == limit && !nextChunk()) {
+        return -1;
     }
+    return static_cast<int32_t>(*cursor++);
 }
 
 void TokenStream::putBack(int32_t c) {
-    if (buffer.size() > 2) {
+    if (bufferSize >= MAX_PUT_BACK) {
         throw ConfigExceptionBugOrBroken("bug: putBack() three times, undesirable look-ahead");
     }
-    buffer.push_front(c);
+    buffer[bufferSize++] = c;
 }
 
 bool TokenStream::isWhitespace(int32_t c) {
-    return std::isspace(c);
+    return isCharClass(c, WHITESPACE);
 }
 
 bool TokenStream::isWhitespaceNotNewline(int32_t c) {
-    return c != '\n' && std::isspace(c);
+    return isCharClass(c, WHITESPACE_NOT_NEWLINE);
 }
 
 bool TokenStream::startOfComment(int32_t c) {
@@ -171,8 +224,18 @@ bool TokenStream::startOfComment(int32_t c) {
     }
 }
 
-int32_t TokenStream::nextCharAfterWhitespace(const WhitespaceSaverPtr& saver) {
+int32_t TokenStream::nextCharAfterWhitespace(WhitespaceSaver& saver) {
     while (true) {
+        // skip a run of whitespace straight out of the chunk; often there
+        // is none, which isn't worth calling the scanner for
+        if (haveChunk()) {
+            const char* start = cursor;
+            if (isWhitespaceNotNewline(*cursor)) {
+                cursor = CharScanner::skipWhitespace(cursor + 1, limit);
+                saver.add(start, cursor);
+            }
+        }
+
         int32_t c = nextCharRaw();
 
         if (c == -1) {
@@ -180,7 +243,7 @@ int32_t TokenStream::nextCharAfterWhitespace(const WhitespaceSaverPtr& saver) {
         }
         else {
             if (isWhitespaceNotNewline(c)) {
-                saver->add(c);
+                saver.add(c);
                 continue;
             }
             else {
@@ -190,12 +253,25 @@ int32_t TokenStream::nextCharAfterWhitespace(const WhitespaceSaverPtr& saver) {
     }
 }
 
+bool TokenStream::continuesUnquotedText(const char* p) {
+    if (isCharClass(*p, NOT_IN_UNQUOTED_TEXT | WHITESPACE)) {
+        return false;
+    }
+    else if (*p == '/' && allowComments) {
+        // could be the start of a // comment
+        return p + 1 != limit && p[1] != '/';
+    }
+    else {
+        return true;
+    }
+}
+
 ConfigExceptionTokenizerProblem TokenStream::problem(const std::string& message) {
-    return problem(lineOrigin_, "", message, false);
+    return problem(lineOrigin(origin_, lineNumber), "", message, false);
 }
 
 ConfigExceptionTokenizerProblem TokenStream::problem(const std::string& what, const std::string& message, bool suggestQuotes) {
-    return problem(lineOrigin_, what, message, suggestQuotes);
+    return problem(lineOrigin(origin_, lineNumber), what, message, suggestQuotes);
 }
 
 ConfigExceptionTokenizerProblem TokenStream::problem(const ConfigOriginPtr& origin, const std::string& what, const std::string& message, bool suggestQuotes) {
@@ -210,7 +286,16 @@ ConfigOriginPtr TokenStream::lineOrigin(const ConfigOriginPtr& baseOrigin, int32
     return std::dynamic_pointer_cast<SimpleConfigOrigin>(baseOrigin)->setLineNumber(lineNumber);
 }
 
-TokenPtr TokenStream::pullComment(int32_t firstChar) {
+TokenPtr TokenStream::atLine(const TokenPtr& token, int32_t lineNumber) {
+    token->setOriginLine(lineNumber);
+    return token;
+}
+
+int32_t TokenStream::valueLine() {
+    return keepValueLines ? lineNumber : -1;
+}
+
+bool TokenStream::pullComment(int32_t firstChar, Lexeme& lexeme) {
     if (firstChar == '/') {
         int32_t discard = nextCharRaw();
         if (discard != '/') {
@@ -218,31 +303,41 @@ TokenPtr TokenStream::pullComment(int32_t firstChar) {
         }
     }
 
-    std::string s;
+    lexeme.reset(TokenType::COMMENT, lineNumber);
+    std::string& s = lexeme.text;
     while (true) {
+        if (haveChunk()) {
+            const char* start = cursor;
+            cursor = CharScanner::findNewline(cursor, limit);
+            if (keepComments) {
+                s.append(start, cursor);
+            }
+            if (cursor != limit) {
+                // leave the newline unread
+                return keepComments;
+            }
+        }
+
         int32_t c = nextCharRaw();
         if (c == -1 || c == '\n') {
             putBack(c);
-            return Tokens::newComment(lineOrigin_, s);
+            return keepComments;
         }
-        else {
+        else if (keepComments) {
             s += static_cast<char>(c);
         }
     }
 }
 
-TokenPtr TokenStream::pullUnquotedText() {
-    auto origin = lineOrigin_;
-    std::string sb;
+void TokenStream::pullUnquotedText(Lexeme& lexeme) {
+    lexeme.reset(TokenType::UNQUOTED_TEXT, valueLine());
+    std::string& sb = lexeme.text;
     int32_t c = nextCharRaw();
     while (true) {
         if (c == -1) {
             break;
         }
-        else if (notInUnquotedText.find(c) != std::string::npos) {
-            break;
-        }
-        else if (isWhitespace(c)) {
+        else if (isCharClass(c, NOT_IN_UNQUOTED_TEXT | WHITESPACE)) {
             break;
         }
         else if (startOfComment(c)) {
@@ -257,54 +352,79 @@ TokenPtr TokenStream::pullUnquotedText() {
         // start of the unquoted token.
         if (sb.length() == 4) {
             if (sb == "true") {
-                return Tokens::newBoolean(origin, true);
+                lexeme.type = TokenType::VALUE;
+                lexeme.valueType = ConfigValueType::BOOLEAN;
+                lexeme.booleanValue = true;
+                return;
             }
             else if (sb == "null") {
-                return Tokens::newNull(origin);
+                lexeme.type = TokenType::VALUE;
+                lexeme.valueType = ConfigValueType::NONE;
+                return;
             }
         }
         else if (sb.length() == 5) {
             if (sb == "false") {
-                return Tokens::newBoolean(origin, false);
+                lexeme.type = TokenType::VALUE;
+                lexeme.valueType = ConfigValueType::BOOLEAN;
+                lexeme.booleanValue = false;
+                return;
             }
         }
 
+        // once past the true/false/null check, copy the rest of the
+        // run straight out of the chunk
+        if (sb.length() >= 5 && haveChunk()) {
+            const char* start = cursor;
+            while (cursor != limit && continuesUnquotedText(cursor)) {
+                ++cursor;
+            }
+            sb.append(start, cursor);
+        }
+
         c = nextCharRaw();
     }
 
     // put back the char that ended the unquoted text
     putBack(c);
-
-    return Tokens::newUnquotedText(origin, sb);
 }
 
-TokenPtr TokenStream::pullNumber(int32_t firstChar) {
-    std::string s;
+void TokenStream::pullNumber(int32_t firstChar, Lexeme& lexeme) {
+    lexeme.reset(TokenType::VALUE, valueLine());
+    lexeme.valueType = ConfigValueType::NUMBER;
+    std::string& s = lexeme.text;
     s += static_cast<char>(firstChar);
-    bool containedDecimalOrE = false;
-    int32_t c = nextCharRaw();
-    while (c != -1 && numberChars.find(c) != std::string::npos) {
-        if (c == '.' || c == 'e' || c == 'E') {
-            containedDecimalOrE = true;
+    int32_t c;
+    while (true) {
+        if (haveChunk()) {
+            const char* start = cursor;
+            while (cursor != limit && isCharClass(*cursor, NUMBER)) {
+                ++cursor;
+            }
+            s.append(start, cursor);
         }
-        s += static_cast<char>(c);
         c = nextCharRaw();
+        if (!isCharClass(c, NUMBER)) {
+            break;
+        }
+        s += static_cast<char>(c);
     }
     // the last character we looked at wasn't part of the number, put it back
     putBack(c);
-    try {
-        if (containedDecimalOrE) {
-            // force floating point representation
-            return Tokens::newDouble(lineOrigin_, boost::lexical_cast<double>(s), s);
-        }
-        else {
-            // this should throw if the integer is too large for int64_t
-            return Tokens::newInt64(lineOrigin_, boost::lexical_cast<int64_t>(s), s);
+    lexeme.isDouble = s.find_first_of(".eE") != std::string::npos;
+    if (lexeme.isDouble) {
+        // force floating point representation
+        if (NumberParser::parseDouble(s, lexeme.doubleValue)) {
+            return;
         }
     }
-    catch (boost::bad_lexical_cast&) {
-        throw problem(s, "Invalid number: '" + s + "'", true);
+    else {
+        // this fails if the integer is too large for int64_t
+        if (NumberParser::parseInt64(s, lexeme.intValue)) {
+            return;
+        }
     }
+    throw problem(s, "Invalid number: '" + s + "'", true);
 }
 
 void TokenStream::pullEscapeSequence(std::string& s) {
@@ -386,11 +506,20 @@ void TokenStream::appendTripleQuotedString(std::string& s) {
     }
 }
 
-TokenPtr TokenStream::pullQuotedString() {
+void TokenStream::pullQuotedString(Lexeme& lexeme) {
     // the open quote has already been consumed
-    std::string s;
+    lexeme.reset(TokenType::VALUE);
+    lexeme.valueType = ConfigValueType::STRING;
+    std::string& s = lexeme.text;
     int32_t c = static_cast<int32_t>('\0'); // value doesn't get used
     do {
+        // copy a run of ordinary characters straight out of the chunk
+        if (haveChunk()) {
+            const char* start = cursor;
+            cursor = CharScanner::findQuotedStop(cursor, limit);
+            s.append(start, cursor);
+        }
+
         c = nextCharRaw();
         if (c == -1) {
             throw problem("End of input but string quote was still open");
@@ -401,7 +530,7 @@ TokenPtr TokenStream::pullQuotedString() {
         else if (c == '"') {
             // end the loop, done!
         }
-        else if (std::iscntrl(static_cast<char>(c))) {
+        else if (isCharClass(c, CONTROL)) {
             throw problem(Tokenizer::asString(c), "JSON does not allow unescaped " +
                           Tokenizer::asString(c) + " in quoted strings, use a backslash escape");
         }
@@ -421,22 +550,22 @@ TokenPtr TokenStream::pullQuotedString() {
         }
     }
 
-    return Tokens::newString(lineOrigin_, s);
+    lexeme.line = valueLine();
 }
 
-TokenPtr TokenStream::pullPlusEquals() {
+void TokenStream::pullPlusEquals(Lexeme& lexeme) {
     // the initial '+' has already been consumed
     int32_t c = nextCharRaw();
     if (c != '=') {
         throw problem(Tokenizer::asString(c), "'+' not followed by =, '" +
                       Tokenizer::asString(c) + "' not allowed after '+'", true);
     }
-    return Tokens::PLUS_EQUALS();
+    lexeme.reset(TokenType::PLUS_EQUALS);
 }
 
-TokenPtr TokenStream::pullSubstitution() {
+void TokenStream::pullSubstitution(Lexeme& lexeme) {
     // the initial '$' has already been consumed
-    auto origin = lineOrigin_;
+    int32_t line = lineNumber;
     int32_t c = nextCharRaw();
     if (c != '{') {
         throw problem(Tokenizer::asString(c), "'$' not followed by {, '" +
@@ -452,144 +581,169 @@ TokenPtr TokenStream::pullSubstitution() {
         putBack(c);
     }
 
-    auto saver = WhitespaceSaver::make_instance();
+    // a path expression that is one key, which is nearly all of them, is
+    // kept as the key's text; any other is kept as tokens, which the parser
+    // makes a path out of
+    WhitespaceSaver saver;
     VectorToken expression;
+    bool onlyKey = false;
 
-    TokenPtr t;
+    Lexeme key;
+    Lexeme t;
+    Lexeme whitespace;
     do {
-        t = pullNextToken(saver);
+        pullNextLexeme(saver, t);
 
         // note that we avoid validating the allowed tokens inside
         // the substitution here; we even allow nested substitutions
         // in the tokenizer. The parser sorts it out.
-        if (t == Tokens::CLOSE_CURLY()) {
+        if (t.type == TokenType::CLOSE_CURLY) {
             // end the loop, done!
             break;
         }
-        else if (t == Tokens::END()) {
-            throw problem(origin, "Substitution ${ was not closed with a }");
+        else if (t.type == TokenType::END) {
+            throw problem(lineOrigin(origin_, line), "Substitution ${ was not closed with a }");
         }
         else {
-            auto whitespace = saver->check(t, origin, lineNumber);
-            if (whitespace) {
-                expression.push_back(whitespace);
+            bool haveWhitespace = saver.check(t, whitespace, valueLine());
+            if (!onlyKey && expression.empty()) {
+                std::swap(key, t);
+                onlyKey = true;
+                continue;
             }
-            expression.push_back(t);
+            if (onlyKey) {
+                expression.push_back(key.toToken(origin_));
+                onlyKey = false;
+            }
+            if (haveWhitespace) {
+                expression.push_back(whitespace.toToken(origin_));
+            }
+            expression.push_back(t.toToken(origin_));
         }
     } while (true);
 
-    return Tokens::newSubstitution(origin, optional, expression);
+    lexeme.reset(TokenType::SUBSTITUTION, keepValueLines ? line : -1);
+    lexeme.optional = optional;
+    if (onlyKey && (key.type == TokenType::UNQUOTED_TEXT || key.isValueWithType(ConfigValueType::STRING))) {
+        lexeme.quoted = key.type == TokenType::VALUE;
+        lexeme.text.swap(key.text);
+    }
+    else {
+        if (onlyKey) {
+            expression.push_back(key.toToken(origin_));
+        }
+        lexeme.token = atLine(Tokens::newSubstitution(origin_, optional, expression), lexeme.line);
+    }
 }
 
-TokenPtr TokenStream::pullNextToken(const WhitespaceSaverPtr& saver) {
+void TokenStream::pullNextLexeme(WhitespaceSaver& saver, Lexeme& lexeme) {
     int32_t c = nextCharAfterWhitespace(saver);
     if (c == -1) {
-        return Tokens::END();
+        lexeme.reset(TokenType::END);
     }
     else if (c == '\n') {
         // newline tokens have the just-ended line number
-        auto line = Tokens::newLine(lineOrigin_);
+        lexeme.reset(TokenType::NEWLINE, lineNumber);
         lineNumber += 1;
-        lineOrigin_ = origin_->setLineNumber(lineNumber);
-        return line;
     }
-    else {
-        TokenPtr t;
-        if (startOfComment(c)) {
-            t = pullComment(c);
+    else if (startOfComment(c)) {
+        if (!pullComment(c, lexeme)) {
+            // comment skipped; a newline or the end of input is next
+            pullNextLexeme(saver, lexeme);
         }
-        else {
-            switch (c) {
-                case '"':
-                    t = pullQuotedString();
-                    break;
-                case '$':
-                    t = pullSubstitution();
-                    break;
-                case ':':
-                    t = Tokens::COLON();
-                    break;
-                case ',':
-                    t = Tokens::COMMA();
-                    break;
-                case '=':
-                    t = Tokens::EQUALS();
-                    break;
-                case '{':
-                    t = Tokens::OPEN_CURLY();
-                    break;
-                case '}':
-                    t = Tokens::CLOSE_CURLY();
-                    break;
-                case '[':
-                    t = Tokens::OPEN_SQUARE();
-                    break;
-                case ']':
-                    t = Tokens::CLOSE_SQUARE();
-                    break;
-                case '+':
-                    t = pullPlusEquals();
-                    break;
-                default:
-                    t = nullptr;
-                    break;
-            }
-
-            if (!t) {
-                if (firstNumberChars.find(c) != std::string::npos) {
-                    t = pullNumber(c);
+    }
+    else {
+        switch (c) {
+            case '"':
+                pullQuotedString(lexeme);
+                break;
+            case '$':
+                pullSubstitution(lexeme);
+                break;
+            case ':':
+                lexeme.reset(TokenType::COLON);
+                break;
+            case ',':
+                lexeme.reset(TokenType::COMMA);
+                break;
+            case '=':
+                lexeme.reset(TokenType::EQUALS);
+                break;
+            case '{':
+                lexeme.reset(TokenType::OPEN_CURLY);
+                break;
+            case '}':
+                lexeme.reset(TokenType::CLOSE_CURLY);
+                break;
+            case '[':
+                lexeme.reset(TokenType::OPEN_SQUARE);
+                break;
+            case ']':
+                lexeme.reset(TokenType::CLOSE_SQUARE);
+                break;
+            case '+':
+                pullPlusEquals(lexeme);
+                break;
+            default:
+                if (isCharClass(c, FIRST_NUMBER)) {
+                    pullNumber(c, lexeme);
                 }
-                else if (notInUnquotedText.find(c) != std::string::npos) {
+                else if (isCharClass(c, NOT_IN_UNQUOTED_TEXT)) {
                     throw problem(Tokenizer::asString(c), "Reserved character '" +
                                   Tokenizer::asString(c) +
                                   "' is not allowed outside quotes", true);
                 }
                 else {
                     putBack(c);
-                    t = pullUnquotedText();
+                    pullUnquotedText(lexeme);
                 }
-            }
+                break;
         }
-
-        if (!t) {
-            throw ConfigExceptionBugOrBroken("bug: failed to generate next token");
-        }
-        return t;
     }
 }
 
-bool TokenStream::isSimpleValue(const TokenPtr& t) {
-    return Tokens::isSubstitution(t) || Tokens::isUnquotedText(t) || Tokens::isValue(t);
-}
-
-void TokenStream::queueNextToken() {
-    auto t = pullNextToken(whitespaceSaver);
-    auto whitespace = whitespaceSaver->check(t, origin_, lineNumber);
-    if (whitespace) {
-        tokens.push_back(whitespace);
-    }
-    tokens.push_back(t);
+bool TokenStream::isSimpleValue(const Lexeme& t) {
+    return t.type == TokenType::SUBSTITUTION || t.type == TokenType::UNQUOTED_TEXT || t.type == TokenType::VALUE;
 }
 
 bool TokenStream::hasNext() {
-    return !tokens.empty();
+    return !ended;
 }
 
 TokenPtr TokenStream::next() {
-    auto t = tokens.front();
-    tokens.pop_front();
-    if (tokens.empty() && t != Tokens::END()) {
+    nextLexeme(current);
+    return current.toToken(origin_);
+}
+
+void TokenStream::nextLexeme(Lexeme& lexeme) {
+    if (!started) {
+        started = true;
+        lexeme.reset(TokenType::START);
+        return;
+    }
+    else if (havePending) {
+        std::swap(lexeme, pending);
+        havePending = false;
+    }
+    else if (ended) {
+        lexeme.reset(TokenType::END);
+    }
+    else {
         try {
-            queueNextToken();
+            pullNextLexeme(whitespaceSaver, lexeme);
+            if (whitespaceSaver.check(lexeme, pending, valueLine())) {
+                // hand out the whitespace first
+                std::swap(lexeme, pending);
+                havePending = true;
+            }
         }
         catch (ConfigExceptionTokenizerProblem& e) {
-            tokens.push_back(e.problem());
-        }
-        if (tokens.empty()) {
-            throw ConfigExceptionBugOrBroken("bug: tokens queue should not be empty here");
+            lexeme = Lexeme::fromToken(e.problem());
         }
     }
-    return t;
+    if (lexeme.type == TokenType::END) {
+        ended = true;
+    }
 }
 
 }
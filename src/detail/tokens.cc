@@ -12,11 +12,12 @@
 #include "configcpp/detail/config_null.h"
 #include "configcpp/detail/config_boolean.h"
 #include "configcpp/config_value_type.h"
+#include "configcpp/config_origin.h"
 
 namespace config {
 
 ValueToken::ValueToken(const AbstractConfigValuePtr& value) :
-    Token(TokenType::VALUE, value->origin()),
+    Token(TokenType::VALUE, nullptr),
     value_(value) {
 }
 
@@ -24,6 +25,18 @@ AbstractConfigValuePtr ValueToken::value() {
     return value_;
 }
 
+ConfigOriginPtr ValueToken::origin() {
+    return value_->origin();
+}
+
+int32_t ValueToken::lineNumber() {
+    return value_->origin()->lineNumber();
+}
+
+void ValueToken::setOriginLine(int32_t lineNumber) {
+    value_->setOriginLine(lineNumber);
+}
+
 std::string ValueToken::toString() {
     std::ostringstream stream;
     ConfigVariant u = value()->unwrapped();
@@ -76,7 +89,7 @@ UnquotedTextToken::UnquotedTextToken(const ConfigOriginPtr& origin, const std::s
     value_(s) {
 }
 
-std::string UnquotedTextToken::value() {
+const std::string& UnquotedTextToken::value() {
     return value_;
 }
 
@@ -143,7 +156,7 @@ CommentToken::CommentToken(const ConfigOriginPtr& origin, const std::string& tex
     text_(text) {
 }
 
-std::string CommentToken::text() {
+const std::string& CommentToken::text() {
     return text_;
 }
 
@@ -259,7 +272,7 @@ bool Tokens::isComment(const TokenPtr& token) {
     return instanceof<CommentToken>(token);
 }
 
-std::string Tokens::getCommentText(const TokenPtr& token) {
+const std::string& Tokens::getCommentText(const TokenPtr& token) {
     if (instanceof<CommentToken>(token)) {
         return std::static_pointer_cast<CommentToken>(token)->text();
     }
@@ -272,7 +285,7 @@ bool Tokens::isUnquotedText(const TokenPtr& token) {
     return instanceof<UnquotedTextToken>(token);
 }
 
-std::string Tokens::getUnquotedText(const TokenPtr& token) {
+const std::string& Tokens::getUnquotedText(const TokenPtr& token) {
     if (instanceof<UnquotedTextToken>(token)) {
         return std::static_pointer_cast<UnquotedTextToken>(token)->value();
     }
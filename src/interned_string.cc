@@ -0,0 +1,177 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "configcpp/interned_string.h"
+
+#include <mutex>
+#include <ostream>
+#include <tuple>
+#include <unordered_map>
+
+namespace config {
+
+///
+/// The table of interned strings, split by hash into shards with a lock each
+/// so threads interning different strings rarely wait on one another. A
+/// handle's count only drops to zero, and the entry is only found again, with
+/// its shard's lock held, so an entry is never revived while it's being
+/// removed.
+///
+struct InternTable {
+    static const uint32_t SHARDS = 16;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, InternedString::Counted> entries;
+    };
+
+    Shard& shard(std::size_t hash) {
+        return shards[hash % SHARDS];
+    }
+
+    Shard shards[SHARDS];
+};
+
+/// Never destroyed: handles held by other static objects may be released
+/// after this translation unit's statics have gone.
+static InternTable& internTable() {
+    static InternTable* table = new InternTable;
+    return *table;
+}
+
+InternedString::InternedString() :
+    entry(nullptr) {
+}
+
+InternedString::InternedString(const std::string& s) :
+    entry(nullptr) {
+    intern(s);
+}
+
+void InternedString::intern(const std::string& s) {
+    if (s.empty()) {
+        return;
+    }
+    std::size_t hash = std::hash<std::string>()(s);
+    auto& shard = internTable().shard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.entries.find(s);
+    if (found == shard.entries.end()) {
+        found = shard.entries.emplace(std::piecewise_construct, std::forward_as_tuple(s), std::forward_as_tuple()).first;
+        found->second.hash = hash;
+    }
+    ++found->second.refs;
+    entry = &*found;
+}
+
+InternedString::InternedString(const char* s) :
+    InternedString(std::string(s)) {
+}
+
+InternedString::Unpooled::Unpooled(const std::string& s, const ConfigMemoryResourcePtr& resource) :
+    Entry(std::piecewise_construct, std::forward_as_tuple(s), std::forward_as_tuple()),
+    resource(resource) {
+    second.hash = std::hash<std::string>()(s);
+    second.refs = 1;
+    second.pooled = false;
+}
+
+InternedString::InternedString(const std::string& s, const ConfigMemoryResourcePtr& resource) :
+    InternedString() {
+    if (!resource) {
+        intern(s);
+    }
+    else if (!s.empty()) {
+        ConfigMemoryAllocator<Unpooled> allocator(resource);
+        Unpooled* unpooled = allocator.allocate(1);
+        try {
+            ::new (static_cast<void*>(unpooled)) Unpooled(s, resource);
+        }
+        catch (...) {
+            allocator.deallocate(unpooled, 1);
+            throw;
+        }
+        entry = unpooled;
+    }
+}
+
+InternedString::InternedString(const InternedString& other) :
+    entry(other.entry) {
+    if (entry) {
+        // we hold a reference through other, so the count can't be zero
+        ++entry->second.refs;
+    }
+}
+
+InternedString::~InternedString() {
+    release();
+}
+
+InternedString& InternedString::operator=(const InternedString& other) {
+    if (entry != other.entry) {
+        InternedString copy(other);
+        release();
+        entry = copy.entry;
+        copy.entry = nullptr;
+    }
+    return *this;
+}
+
+void InternedString::release() {
+    if (!entry) {
+        return;
+    }
+    auto& refs = entry->second.refs;
+    if (!entry->second.pooled) {
+        if (--refs == 0) {
+            auto unpooled = const_cast<Unpooled*>(static_cast<const Unpooled*>(entry));
+            ConfigMemoryAllocator<Unpooled> allocator(unpooled->resource);
+            unpooled->~Unpooled();
+            allocator.deallocate(unpooled, 1);
+        }
+        entry = nullptr;
+        return;
+    }
+    uint32_t count = refs.load();
+    while (count > 1) {
+        if (refs.compare_exchange_weak(count, count - 1)) {
+            entry = nullptr;
+            return;
+        }
+    }
+
+    // possibly the last reference
+    auto& shard = internTable().shard(entry->second.hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (--refs == 0) {
+        shard.entries.erase(shard.entries.find(entry->first));
+    }
+    entry = nullptr;
+}
+
+const std::string& InternedString::emptyString() {
+    static const std::string empty;
+    return empty;
+}
+
+std::size_t InternedString::emptyHash() {
+    static const std::size_t hash = std::hash<std::string>()(std::string());
+    return hash;
+}
+
+uint32_t InternedString::tableSize() {
+    uint32_t size = 0;
+    for (auto& shard : internTable().shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size += static_cast<uint32_t>(shard.entries.size());
+    }
+    return size;
+}
+
+std::ostream& operator<<(std::ostream& out, const InternedString& s) {
+    return out << s.str();
+}
+
+}
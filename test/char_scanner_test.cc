@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test_fixture.h"
+#include "configcpp/detail/char_scanner.h"
+#include "configcpp/detail/tokens.h"
+#include "configcpp/detail/misc_utils.h"
+
+using namespace config;
+
+class CharScannerTest : public TestFixture {
+protected:
+    /// Run every kernel over every sub-range of the input and check it
+    /// agrees with the scalar kernel.
+    void checkKernels(const std::string& input) {
+        auto kernels = CharScanner::supportedKernels();
+        auto& scalar = kernels.front();
+        const char* data = input.data();
+        uint32_t length = static_cast<uint32_t>(input.length());
+        for (auto& kernel : kernels) {
+            for (uint32_t begin = 0; begin <= length; ++begin) {
+                for (uint32_t end = begin; end <= length; ++end) {
+                    ASSERT_EQ(scalar.findQuotedStop(data + begin, data + end), kernel.findQuotedStop(data + begin, data + end))
+                        << kernel.name << " findQuotedStop [" << begin << ", " << end << ")";
+                    ASSERT_EQ(scalar.findNewline(data + begin, data + end), kernel.findNewline(data + begin, data + end))
+                        << kernel.name << " findNewline [" << begin << ", " << end << ")";
+                    ASSERT_EQ(scalar.skipWhitespace(data + begin, data + end), kernel.skipWhitespace(data + begin, data + end))
+                        << kernel.name << " skipWhitespace [" << begin << ", " << end << ")";
+                }
+            }
+        }
+    }
+
+    VectorToken tokenizeWith(const CharScanner::Kernels& kernels, const std::string& input) {
+        auto previous = CharScanner::kernels();
+        CharScanner::setKernels(kernels);
+        auto tokens = tokenizeAsList(input);
+        CharScanner::setKernels(previous);
+        return tokens;
+    }
+};
+
+TEST_F(CharScannerTest, scalarKernelsAlwaysSupported) {
+    auto kernels = CharScanner::supportedKernels();
+    ASSERT_FALSE(kernels.empty());
+    EXPECT_EQ("scalar", kernels.front().name);
+    EXPECT_EQ(kernels.back().name, CharScanner::kernels().name);
+}
+
+TEST_F(CharScannerTest, scalarKernels) {
+    auto scalar = CharScanner::supportedKernels().front();
+    std::string s = " \t\v\f\rabc\"d\\e\x01\n";
+    const char* end = s.data() + s.length();
+    EXPECT_EQ(s.data() + 5, scalar.skipWhitespace(s.data(), end));
+    EXPECT_EQ(s.data() + 8, scalar.findQuotedStop(s.data() + 5, end));
+    EXPECT_EQ(s.data() + 10, scalar.findQuotedStop(s.data() + 9, end));
+    EXPECT_EQ(s.data() + 12, scalar.findQuotedStop(s.data() + 11, end));
+    EXPECT_EQ(s.data() + 13, scalar.findNewline(s.data(), end));
+    EXPECT_EQ(end, scalar.findNewline(end, end));
+    // nothing found returns the end of the range
+    EXPECT_EQ(s.data() + 8, scalar.findQuotedStop(s.data() + 5, s.data() + 8));
+}
+
+TEST_F(CharScannerTest, kernelsMatchScalarOnEveryByte) {
+    // each byte value, alone and after a stride's worth of plain text
+    // and whitespace, so it lands in both the vector body and the tail
+    for (uint32_t b = 0; b < 256; ++b) {
+        char c = static_cast<char>(b);
+        checkKernels(std::string(1, c));
+        checkKernels(std::string(37, 'x') + c + std::string(5, 'y'));
+        checkKernels(std::string(37, ' ') + c + std::string(5, '\t'));
+    }
+}
+
+TEST_F(CharScannerTest, kernelsMatchScalarOnRandomInput) {
+    // mostly the characters the kernels look for, at every alignment
+    std::string alphabet = "  \t\t\r\n\v\f\"\\ab\x01\x7f\x80\xff#/";
+    uint32_t seed = 12345;
+    for (uint32_t round = 0; round < 20; ++round) {
+        std::string input;
+        uint32_t length = 70 + round;
+        for (uint32_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245 + 12345;
+            // long runs of a single character now and then
+            uint32_t run = (seed >> 24) % 8 == 0 ? 1 + (seed >> 8) % 40 : 1;
+            input.append(run, alphabet[(seed >> 16) % alphabet.length()]);
+        }
+        checkKernels(input);
+    }
+}
+
+TEST_F(CharScannerTest, tokenizerMatchesScalar) {
+    std::string input;
+    for (uint32_t i = 0; i < 50; ++i) {
+        input += "key" + boost::lexical_cast<std::string>(i) + " = \"a quoted string with \\\"escapes\\\" and \\n that is long enough to vector\"";
+        input += std::string(i % 40, ' ') + "# a comment running well past one or two strides " + boost::lexical_cast<std::string>(i) + "\n";
+        input += "  list" + boost::lexical_cast<std::string>(i) + " : [ 1, 2.5," + std::string(i, '\t') + "\"x\" ] // more\n";
+    }
+    input += "\"unterminated \x01 control\"\n";
+    auto kernels = CharScanner::supportedKernels();
+    auto expected = tokenizeWith(kernels.front(), input);
+    for (auto& kernel : kernels) {
+        EXPECT_TRUE(MiscUtils::vector_equals(expected, tokenizeWith(kernel, input))) << kernel.name;
+    }
+}
@@ -0,0 +1,244 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test_fixture.h"
+#include "configcpp/detail/config_allocator.h"
+#include "configcpp/detail/config_arena.h"
+#include "configcpp/detail/config_string.h"
+#include "configcpp/detail/simple_config_origin.h"
+#include "configcpp/detail/simple_config.h"
+#include "configcpp/config.h"
+#include "configcpp/config_list_view.h"
+#include "configcpp/config_object.h"
+#include "configcpp/config_memory_resource.h"
+#include "configcpp/config_parse_options.h"
+#include "configcpp/config_resolve_options.h"
+#include "configcpp/config_value.h"
+#include "configcpp/interned_string.h"
+#include "configcpp/small_map.h"
+#include <atomic>
+
+using namespace config;
+
+class ConfigMemoryResourceTest : public TestFixture {
+};
+
+/// Resource counting what it has outstanding.
+class CountingResource : public ConfigMemoryResource {
+public:
+    CountingResource() :
+        outstanding(0),
+        allocations(0) {
+    }
+
+    virtual void* allocate(std::size_t bytes, std::size_t alignment) override {
+        outstanding += bytes;
+        ++allocations;
+        return ::operator new(bytes);
+    }
+
+    virtual void deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        outstanding -= bytes;
+        ::operator delete(p);
+    }
+
+    std::atomic<std::size_t> outstanding;
+    std::atomic<std::size_t> allocations;
+};
+
+TEST_F(ConfigMemoryResourceTest, scopeAllocatesNodes) {
+    EXPECT_EQ(nullptr, ConfigMemoryScope::current());
+    {
+        ConfigMemoryScope disabled(nullptr);
+        EXPECT_EQ(nullptr, ConfigMemoryScope::current());
+    }
+
+    auto resource = std::make_shared<CountingResource>();
+    AbstractConfigValuePtr kept;
+    {
+        ConfigMemoryScope scope(resource);
+        EXPECT_EQ(resource, ConfigMemoryScope::current());
+        {
+            // a nested scope without a resource leaves the outer one current
+            ConfigMemoryScope nested(nullptr);
+            EXPECT_EQ(resource, ConfigMemoryScope::current());
+        }
+        {
+            ConfigHeapScope heap;
+            EXPECT_EQ(nullptr, ConfigMemoryScope::current());
+        }
+        EXPECT_EQ(resource, ConfigMemoryScope::current());
+
+        std::size_t before = resource->allocations;
+        kept = ConfigString::make_instance(SimpleConfigOrigin::newSimple("resource test"), "kept");
+        EXPECT_LT(before, resource->allocations);
+
+        // only values and origins come from the resource
+        before = resource->allocations;
+        ConfigParseOptions::defaults()->setAllowMissing(false);
+        EXPECT_EQ(before, resource->allocations);
+    }
+    EXPECT_EQ(nullptr, ConfigMemoryScope::current());
+
+    // the value keeps its resource alive after the scope has gone
+    EXPECT_EQ("kept", kept->unwrapped<std::string>());
+    EXPECT_EQ("resource test", kept->origin()->description());
+    kept.reset();
+    EXPECT_EQ(0u, resource->outstanding);
+}
+
+TEST_F(ConfigMemoryResourceTest, parseAndResolveFromMemoryResource) {
+    auto resource = std::make_shared<CountingResource>();
+    std::string text = "a { b = 1, c = [1, 2, 3], d = \"some text\" }, e = ${a} { f = ${a.d} }";
+    auto parsed = Config::parseString(text, ConfigParseOptions::defaults()->setMemoryResource(resource));
+    std::size_t parsing = resource->allocations;
+    EXPECT_LT(0u, parsing);
+
+    auto conf = parsed->resolve(ConfigResolveOptions::defaults()->setMemoryResource(resource));
+    EXPECT_LT(parsing, resource->allocations);
+    EXPECT_EQ(Config::parseString(text)->resolve()->root()->render(), conf->root()->render());
+
+    // everything is given back once the config has gone
+    parsed.reset();
+    conf.reset();
+    EXPECT_EQ(0u, resource->outstanding);
+}
+
+TEST_F(ConfigMemoryResourceTest, scopeCoversOtherEntryPoints) {
+    auto resource = std::make_shared<CountingResource>();
+    ConfigValuePtr value;
+    {
+        ConfigMemoryScope scope(resource);
+        EXPECT_EQ(resource, ConfigMemoryScope::current());
+        value = ConfigValue::fromAnyRef(MapVariant({{"a", 1}, {"b", std::string("two")}}));
+    }
+    EXPECT_EQ(nullptr, ConfigMemoryScope::current());
+    EXPECT_LT(0u, resource->outstanding);
+
+    // values made outside the scope don't use it
+    std::size_t allocations = resource->allocations;
+    ConfigValue::fromAnyRef(VectorVariant({1, 2, 3}));
+    EXPECT_EQ(allocations, resource->allocations);
+
+    value.reset();
+    EXPECT_EQ(0u, resource->outstanding);
+}
+
+TEST_F(ConfigMemoryResourceTest, containersAllocateFromResource) {
+    typedef ConfigMemoryAllocator<std::pair<const std::string, int32_t>> Allocator;
+    typedef SmallMap<std::string, int32_t, 4, Allocator> Map;
+    auto resource = std::make_shared<CountingResource>();
+    {
+        Map map{Allocator(resource)};
+        for (int32_t i = 0; i < 4; ++i) {
+            map["k" + boost::lexical_cast<std::string>(i)] = i;
+        }
+        std::size_t small = resource->outstanding;
+        EXPECT_LT(0u, small);
+
+        // growing past the limit adds an index from the same resource
+        for (int32_t i = 4; i < 8; ++i) {
+            map["k" + boost::lexical_cast<std::string>(i)] = i;
+        }
+        EXPECT_LT(small, resource->outstanding);
+        Map moved(std::move(map));
+        EXPECT_EQ(resource, moved.get_allocator().getResource());
+
+        // copies made outside a scope come from the heap
+        std::size_t allocations = resource->allocations;
+        Map copied(moved);
+        EXPECT_EQ(allocations, resource->allocations);
+        EXPECT_EQ(nullptr, copied.get_allocator().getResource());
+        EXPECT_EQ(8u, copied.size());
+    }
+    EXPECT_EQ(0u, resource->outstanding);
+}
+
+TEST_F(ConfigMemoryResourceTest, parsedTreeAllocatesFromResource) {
+    auto resource = std::make_shared<CountingResource>();
+    std::string text = "a { k0 = 0, k1 = 1, k2 = 2, k3 = 3, k4 = 4, k5 = 5, k6 = 6, k7 = 7, k8 = 8, k9 = 9 }\n"
+                       "b = [1, 2, 3], c = \"a string not seen by the intern table\"";
+    uint32_t interned = InternedString::tableSize();
+    auto conf = Config::parseString(text, ConfigParseOptions::defaults()->setMemoryResource(resource))
+        ->resolve(ConfigResolveOptions::defaults()->setMemoryResource(resource));
+
+    // strings made from a resource aren't interned, but still compare by content
+    EXPECT_EQ(interned, InternedString::tableSize());
+    auto plain = Config::parseString(text)->resolve();
+    EXPECT_TRUE(std::dynamic_pointer_cast<ConfigBase>(conf->root())->equals(std::dynamic_pointer_cast<ConfigBase>(plain->root())));
+    EXPECT_EQ(10u, conf->getObject("a")->size());
+
+    // views are unboxed into memory from the list's resource, even outside a scope
+    std::size_t allocations = resource->allocations;
+    EXPECT_EQ(3u, conf->getIntListView("b").size());
+    EXPECT_LT(allocations, resource->allocations);
+
+    conf.reset();
+    EXPECT_EQ(0u, resource->outstanding);
+}
+
+TEST_F(ConfigMemoryResourceTest, optionsCarrySetting) {
+    auto resource = std::make_shared<CountingResource>();
+    EXPECT_EQ(nullptr, ConfigParseOptions::defaults()->getMemoryResource());
+    EXPECT_EQ(resource, ConfigParseOptions::defaults()->setMemoryResource(resource)->setAllowMissing(false)->getMemoryResource());
+    EXPECT_EQ(nullptr, ConfigResolveOptions::defaults()->getMemoryResource());
+    EXPECT_EQ(resource, ConfigResolveOptions::defaults()->setMemoryResource(resource)->setUseSystemEnvironment(false)->getMemoryResource());
+    EXPECT_FALSE(ConfigParseOptions::defaults()->getUseArena());
+    EXPECT_TRUE(ConfigParseOptions::defaults()->setUseArena(true)->setAllowMissing(false)->getUseArena());
+    EXPECT_FALSE(ConfigResolveOptions::defaults()->getUseArena());
+    EXPECT_TRUE(ConfigResolveOptions::defaults()->setUseArena(true)->setUseSystemEnvironment(false)->getUseArena());
+}
+
+TEST_F(ConfigMemoryResourceTest, arenaReusesBlocks) {
+    ConfigArena arena;
+    void* block = arena.allocate(40, 8);
+    EXPECT_EQ(48u, arena.inUse());
+    EXPECT_EQ(64u * 1024, arena.reserved());
+    arena.deallocate(block, 40, 8);
+    EXPECT_EQ(0u, arena.inUse());
+
+    // a block given back goes to the next allocation of its size
+    EXPECT_EQ(block, arena.allocate(48, 16));
+    EXPECT_NE(block, arena.allocate(48, 16));
+
+    // large blocks come from the heap
+    void* large = arena.allocate(4096, 8);
+    arena.deallocate(large, 4096, 8);
+    EXPECT_EQ(96u, arena.inUse());
+    EXPECT_EQ(64u * 1024, arena.reserved());
+}
+
+TEST_F(ConfigMemoryResourceTest, configOwnsArena) {
+    std::string text = "a { b = 1, c = [1, 2, 3], d = \"a string in the arena\" }, e = ${a} { f = ${a.d} }";
+    auto parsed = std::dynamic_pointer_cast<SimpleConfig>(Config::parseString(text, ConfigParseOptions::defaults()->setUseArena(true)));
+    auto arena = std::dynamic_pointer_cast<ConfigArena>(parsed->arena());
+    ASSERT_NE(nullptr, arena);
+    std::size_t parsedBytes = arena->inUse();
+    EXPECT_LT(0u, parsedBytes);
+
+    // the parsed config resolves into its own arena
+    auto resolved = std::dynamic_pointer_cast<SimpleConfig>(parsed->resolve());
+    EXPECT_EQ(arena, resolved->arena());
+    EXPECT_LT(parsedBytes, arena->inUse());
+    auto plain = Config::parseString(text)->resolve();
+    EXPECT_TRUE(std::dynamic_pointer_cast<ConfigBase>(resolved->root())->equals(std::dynamic_pointer_cast<ConfigBase>(plain->root())));
+
+    // a config parsed on the heap can be resolved into an arena of its own
+    auto owning = std::dynamic_pointer_cast<SimpleConfig>(Config::parseString(text)->resolve(ConfigResolveOptions::defaults()->setUseArena(true)));
+    EXPECT_NE(nullptr, owning->arena());
+    EXPECT_NE(arena, owning->arena());
+    EXPECT_EQ(nullptr, std::dynamic_pointer_cast<SimpleConfig>(plain)->arena());
+
+    // the arena lasts as long as the configs and any values kept from them
+    std::weak_ptr<ConfigArena> weak = arena;
+    arena.reset();
+    auto kept = resolved->getValue("e.f");
+    parsed.reset();
+    resolved.reset();
+    EXPECT_FALSE(weak.expired());
+    EXPECT_EQ("a string in the arena", kept->unwrapped<std::string>());
+    kept.reset();
+    EXPECT_TRUE(weak.expired());
+}
@@ -12,9 +12,12 @@
 #include "configcpp/detail/substitution_expression.h"
 #include "configcpp/detail/string_reader.h"
 #include "configcpp/detail/parser.h"
+#include "configcpp/detail/tokenizer.h"
+#include "configcpp/detail/simple_config_origin.h"
 #include "configcpp/config_parse_options.h"
 #include "configcpp/config_exception.h"
 #include "configcpp/config_syntax.h"
+#include "configcpp/config_origin_detail.h"
 #include "configcpp/config_origin.h"
 #include "configcpp/config_list.h"
 #include "configcpp/config_resolve_options.h"
@@ -290,6 +293,50 @@ TEST_F(ConfigParserTest, lineNumbersInErrors) {
     lineNumberTest(3, "\n\n1e\n");
 }
 
+TEST_F(ConfigParserTest, badPathsReportTheirLine) {
+    // keys and substitutions are made paths without tokens, unless they
+    // have more than one token; either way a bad one is reported at its line
+    for (auto& source : {"a = 1\nb..c = 2", "a = 1\nb = ${c..d}", "a = 1\nb = ${\"\"c..d}"}) {
+        try {
+            parseConfig(source);
+            FAIL() << "Expected exception for:" << source;
+        }
+        catch (ConfigExceptionBadPath& e) {
+            EXPECT_EQ(2, e.origin()->lineNumber()) << source;
+        }
+    }
+}
+
+TEST_F(ConfigParserTest, lineNumbersOfValues) {
+    auto conf = parseConfig(
+        "a = 1\n"
+        "b = \"two\"\n"
+        "\n"
+        "c = three\n"
+        "d = true\n"
+        "e = ${a}\n"
+        "f { g = 2.5 }\n"
+        "h = [ null,\n"
+        "  x y ]\n"
+    );
+    EXPECT_EQ(1, conf->getValue("a")->origin()->lineNumber());
+    EXPECT_EQ(2, conf->getValue("b")->origin()->lineNumber());
+    EXPECT_EQ(4, conf->getValue("c")->origin()->lineNumber());
+    EXPECT_EQ(5, conf->getValue("d")->origin()->lineNumber());
+    EXPECT_EQ(7, conf->getValue("f.g")->origin()->lineNumber());
+    auto list = conf->getList("h");
+    EXPECT_EQ(8, list->at(0)->origin()->lineNumber());
+    EXPECT_EQ(9, list->at(1)->origin()->lineNumber());
+
+    // the per-line origin is created on demand but describes the same place
+    auto value = conf->getValue("c");
+    EXPECT_EQ(value->origin()->description(), value->origin()->description());
+    EXPECT_NE(std::string::npos, value->origin()->description().find(": 4"));
+
+    auto unresolved = parseObject("a = 1\n\ne = ${a}");
+    EXPECT_EQ(3, unresolved->peekPath(Path::newPath("e"))->origin()->lineNumber());
+}
+
 TEST_F(ConfigParserTest, toStringForParseables) {
     // just be sure the toString don't throw, to get test coverage
     auto options = ConfigParseOptions::defaults();
@@ -429,6 +476,78 @@ TEST_F(ConfigParserTest, trackCommentsForFields) {
     EXPECT_TRUE(VectorString() == conf8->getValue("a")->origin()->comments());
 }
 
+TEST_F(ConfigParserTest, originDetail) {
+    std::string text =
+        "# Hello\n"
+        "foo = 10 // after foo\n"
+        "bar {\n"
+        "  # Bar\n"
+        "  baz = [ a b, \"c\" ] # list\n"
+        "}\n";
+    auto options = ConfigParseOptions::defaults()->setSyntax(ConfigSyntax::CONF);
+    auto full = Config::parseString(text, options);
+    auto line = Config::parseString(text, options->setOriginDetail(ConfigOriginDetail::LINE));
+    auto file = Config::parseString(text, options->setOriginDetail(ConfigOriginDetail::FILE));
+
+    // the values don't depend on the detail kept
+    checkEquals(std::dynamic_pointer_cast<AbstractConfigObject>(full->root()), std::dynamic_pointer_cast<AbstractConfigObject>(line->root()));
+    checkEquals(std::dynamic_pointer_cast<AbstractConfigObject>(full->root()), std::dynamic_pointer_cast<AbstractConfigObject>(file->root()));
+
+    EXPECT_TRUE(VectorString({" Hello"}) == full->getValue("foo")->origin()->comments());
+    EXPECT_EQ(2, full->getValue("foo")->origin()->lineNumber());
+    EXPECT_EQ(5, full->getList("bar.baz")->at(0)->origin()->lineNumber());
+
+    // comments dropped, lines kept
+    EXPECT_TRUE(VectorString() == line->getValue("foo")->origin()->comments());
+    EXPECT_TRUE(VectorString() == line->getValue("bar.baz")->origin()->comments());
+    EXPECT_EQ(2, line->getValue("foo")->origin()->lineNumber());
+    EXPECT_EQ(3, line->getValue("bar")->origin()->lineNumber());
+    EXPECT_EQ(5, line->getList("bar.baz")->at(0)->origin()->lineNumber());
+
+    // only the file
+    EXPECT_TRUE(VectorString() == file->getValue("foo")->origin()->comments());
+    EXPECT_EQ(-1, file->getValue("foo")->origin()->lineNumber());
+    EXPECT_EQ(-1, file->getValue("bar")->origin()->lineNumber());
+    EXPECT_EQ(-1, file->getValue("bar.baz")->origin()->lineNumber());
+    EXPECT_EQ(-1, file->getList("bar.baz")->at(0)->origin()->lineNumber());
+    EXPECT_EQ(-1, file->getList("bar.baz")->at(1)->origin()->lineNumber());
+
+    // errors still report the line
+    try {
+        Config::parseString("a = 1 # one\n\nb = }", options->setOriginDetail(ConfigOriginDetail::FILE));
+        FAIL() << "expected: ConfigExceptionParse";
+    }
+    catch (ConfigExceptionParse& e) {
+        EXPECT_TRUE(boost::contains(e.what(), "3:"));
+    }
+}
+
+TEST_F(ConfigParserTest, singleTokenKeys) {
+    // keys of one token skip the path expression parser; check they
+    // come out the same as the ones that don't
+    auto conf = parseConfig(
+        "\"a.b\" : 1\n"
+        "c : 2\n"
+        "d.e : 3\n"
+        "\"\" : 4\n"
+        "f g : 5\n"
+        "\"h\"\"i\" : 6\n"
+        "10 : 7\n"
+        "1.5 : 8\n"
+        "true : 9\n"
+    );
+    EXPECT_EQ(1, conf->getInt("\"a.b\""));
+    EXPECT_EQ(2, conf->getInt("c"));
+    EXPECT_EQ(3, conf->getInt("d.e"));
+    EXPECT_EQ(4, conf->getInt("\"\""));
+    EXPECT_EQ(5, conf->getInt("f g"));
+    EXPECT_EQ(6, conf->getInt("hi"));
+    EXPECT_EQ(7, conf->getInt("10"));
+    EXPECT_EQ(8, conf->getInt("1.5"));
+    EXPECT_EQ(9, conf->getInt("true"));
+    EXPECT_FALSE(conf->hasPath("a"));
+}
+
 TEST_F(ConfigParserTest, includeFile) {
     auto conf = Config::parseString("include file(\"" + resourcePath() + "/test01" + "\")");
 
@@ -492,3 +611,32 @@ TEST_F(ConfigParserTest, includeFileUnclosedParens) {
         EXPECT_TRUE(boost::contains(e.what(), "expecting a close paren"));
     }
 }
+
+TEST_F(ConfigParserTest, parseTokenListLikeTokenizer) {
+    // the parser reads lexemes straight from the tokenizer, and converts the
+    // tokens of any other iterator; both give the same tree
+    std::string source = "# about a\n"
+                         "a.b : [1, 2.5, true, null, x y]\n"
+                         "c = ${a.b} foo\n"
+                         "\"d\" { e += \"f\" }\n"
+                         "g = ${\"h.i\"}${?a.b} ${a b}\n";
+    auto origin = SimpleConfigOrigin::newSimple("token list");
+    auto options = ConfigParseOptions::defaults()->setSyntax(ConfigSyntax::CONF);
+    auto lexed = Parser::parse(Tokenizer::tokenize(origin, StringReader::make_instance(source), ConfigSyntax::CONF),
+                               origin, options, nullptr);
+
+    VectorToken list;
+    auto tokens = Tokenizer::tokenize(origin, StringReader::make_instance(source), ConfigSyntax::CONF);
+    while (tokens->hasNext()) {
+        list.push_back(tokens->next());
+    }
+    auto fromList = Parser::parse(TokenIterator::make_instance(list), origin, options, nullptr);
+
+    checkEquals(lexed, fromList);
+    for (auto& tree : {lexed, fromList}) {
+        auto a = std::dynamic_pointer_cast<ConfigObject>(tree)->get("a");
+        auto b = std::dynamic_pointer_cast<ConfigObject>(a)->get("b");
+        EXPECT_EQ(VectorString({" about a"}), b->origin()->comments());
+        EXPECT_EQ(2, b->origin()->lineNumber());
+    }
+}
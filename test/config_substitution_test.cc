@@ -642,7 +642,8 @@ TEST_F(ConfigSubstitutionTest, noFallbackToEnvIfValuesAreNull) {
     // { HOME : null } then ${HOME} should be null.
 
     MapVariant nullsMap;
-    for (auto& k : *substEnvVarObject()) {
+    auto envVars = substEnvVarObject();
+    for (auto& k : *envVars) {
         nullsMap[boost::to_upper_copy(k.first)] = null();
     }
     auto nulls = Config::parseMap(nullsMap, "nulls map");
@@ -18,6 +18,9 @@
 #include "configcpp/config_list.h"
 #include "configcpp/config_origin.h"
 #include "configcpp/config_parse_options.h"
+#include "configcpp/config_path.h"
+
+#include <thread>
 
 using namespace config;
 
@@ -598,6 +601,59 @@ TEST_F(ConfigTest, test01Exceptions) {
     EXPECT_THROW(conf->getBytes("strings.a"), ConfigExceptionBadValue);
 }
 
+TEST_F(ConfigTest, test01GettingWithConfigPath) {
+    auto conf = Config::load(resourcePath() + "/test01");
+
+    // a parsed path gets the same values as the path expression
+    EXPECT_EQ(42, conf->getInt(ConfigPath::parse("ints.fortyTwo")));
+    EXPECT_EQ(42LL, conf->getInt64(ConfigPath::parse("ints.fortyTwoAgain")));
+    EXPECT_DOUBLE_EQ(42.1, conf->getDouble(ConfigPath::parse("floats.fortyTwoPointOne")));
+    EXPECT_EQ("abcd", conf->getString(ConfigPath::parse("strings.abcdAgain")));
+    EXPECT_TRUE(conf->getBoolean(ConfigPath::parse("booleans.trueAgain")));
+    EXPECT_EQ(42, variant_get<int32_t>(conf->getVariant(ConfigPath::parse("ints.fortyTwo"))));
+    checkEquals(intValue(42), std::dynamic_pointer_cast<AbstractConfigValue>(conf->getValue(ConfigPath::parse("ints.fortyTwo"))));
+    EXPECT_EQ(conf->getObject("ints")->size(), conf->getObject(ConfigPath::parse("ints"))->size());
+    EXPECT_EQ(42, conf->getConfig(ConfigPath::parse("ints"))->getInt("fortyTwo"));
+    EXPECT_EQ(1024, conf->getBytes(ConfigPath::parse("memsizes.meg")) / 1024);
+    EXPECT_EQ(conf->getMilliseconds("durations.second"), conf->getMilliseconds(ConfigPath::parse("durations.second")));
+    EXPECT_EQ(conf->getNanoseconds("durations.second"), conf->getNanoseconds(ConfigPath::parse("durations.second")));
+
+    EXPECT_EQ(3, conf->getList(ConfigPath::parse("arrays.ofInt"))->size());
+    EXPECT_TRUE(VectorInt({1, 2, 3}) == conf->getIntList(ConfigPath::parse("arrays.ofInt")));
+    EXPECT_TRUE(VectorInt64({1, 2, 3}) == conf->getInt64List(ConfigPath::parse("arrays.ofInt")));
+    EXPECT_TRUE(VectorString({"a", "b", "c"}) == conf->getStringList(ConfigPath::parse("arrays.ofString")));
+    EXPECT_TRUE(VectorDouble({3.14, 4.14, 5.14}) == conf->getDoubleList(ConfigPath::parse("arrays.ofDouble")));
+    EXPECT_TRUE(VectorBool({true, false}) == conf->getBooleanList(ConfigPath::parse("arrays.ofBoolean")));
+    EXPECT_EQ(3, conf->getVariantList(ConfigPath::parse("arrays.ofNull")).size());
+    EXPECT_EQ(3, conf->getObjectList(ConfigPath::parse("arrays.ofObject")).size());
+    EXPECT_EQ(3, conf->getConfigList(ConfigPath::parse("arrays.ofObject")).size());
+    EXPECT_TRUE(conf->getBytesList("memsizes.megsList") == conf->getBytesList(ConfigPath::parse("memsizes.megsList")));
+    EXPECT_TRUE(conf->getMillisecondsList("durations.secondsList") == conf->getMillisecondsList(ConfigPath::parse("durations.secondsList")));
+    EXPECT_TRUE(conf->getNanosecondsList("durations.secondsList") == conf->getNanosecondsList(ConfigPath::parse("durations.secondsList")));
+
+    // one parsed path works with any config
+    auto path = ConfigPath::parse("a.b");
+    EXPECT_EQ("a.b", path->expression());
+    EXPECT_FALSE(conf->hasPath(path));
+    auto withValue = conf->withValue(path, ConfigValue::fromAnyRef(7));
+    EXPECT_TRUE(withValue->hasPath(path));
+    EXPECT_EQ(7, withValue->getInt(path));
+    EXPECT_EQ(7, withValue->getInt("a.b"));
+
+    // same exceptions, naming the path as it was written
+    EXPECT_THROW(ConfigPath::parse("bad..bad"), ConfigExceptionBadPath);
+    EXPECT_THROW(conf->getInt(ConfigPath::parse("doesnotexist")), ConfigExceptionMissing);
+    EXPECT_THROW(conf->getInt(ConfigPath::parse("nulls.null")), ConfigExceptionNull);
+    EXPECT_THROW(conf->getIntList(ConfigPath::parse("arrays.ofBoolean")), ConfigExceptionWrongType);
+    try {
+        conf->getBytes(ConfigPath::parse("strings.a"));
+        FAIL() << "expected: ConfigExceptionBadValue";
+    }
+    catch (ConfigExceptionBadValue& e) {
+        EXPECT_TRUE(boost::contains(e.what(), "strings.a"));
+    }
+}
+
 TEST_F(ConfigTest, test01Conversions) {
     auto conf = Config::load(resourcePath() + "/test01");
 
@@ -771,6 +827,271 @@ TEST_F(ConfigTest, test04LoadAkkaReference) {
     EXPECT_EQ(true, conf->getBoolean("akka.stm.quick-release"));
 }
 
+TEST_F(ConfigTest, test01GettingWithPathIndex) {
+    auto conf = Config::load(resourcePath() + "/test01");
+    auto indexed = Config::load(resourcePath() + "/test01");
+    indexed->indexPaths();
+    indexed->indexPaths();
+
+    // the index finds the same values the tree walk does
+    EXPECT_EQ(conf->getInt("ints.fortyTwo"), indexed->getInt("ints.fortyTwo"));
+    EXPECT_EQ(conf->getString("strings.abcd"), indexed->getString("strings.abcd"));
+    EXPECT_EQ(conf->getBoolean("booleans.trueAgain"), indexed->getBoolean("booleans.trueAgain"));
+    EXPECT_EQ(conf->getInt(ConfigPath::parse("\"ints\".fortyTwo")), indexed->getInt(ConfigPath::parse("\"ints\".fortyTwo")));
+    EXPECT_EQ(conf->getObject("ints")->size(), indexed->getObject("ints")->size());
+    EXPECT_EQ(42, indexed->getConfig("ints")->getInt("fortyTwo"));
+    EXPECT_EQ(conf->getMilliseconds("durations.second"), indexed->getMilliseconds("durations.second"));
+    EXPECT_TRUE(conf->getIntList("arrays.ofInt") == indexed->getIntList("arrays.ofInt"));
+    // with the same conversions
+    EXPECT_EQ(conf->getInt("strings.number"), indexed->getInt("strings.number"));
+
+    EXPECT_TRUE(indexed->hasPath("ints"));
+    EXPECT_TRUE(indexed->hasPath("ints.fortyTwo"));
+    EXPECT_FALSE(indexed->hasPath("nulls.null"));
+    EXPECT_FALSE(indexed->hasPath("ints.fortyTwo.nope"));
+    EXPECT_FALSE(indexed->hasPath("doesnotexist"));
+
+    // and the same exceptions
+    EXPECT_THROW(indexed->getInt("doesnotexist"), ConfigExceptionMissing);
+    EXPECT_THROW(indexed->getInt("ints.fortyTwo.nope"), ConfigExceptionWrongType);
+    EXPECT_THROW(indexed->getInt("nulls.null"), ConfigExceptionNull);
+    EXPECT_THROW(indexed->getInt("strings.abcd"), ConfigExceptionWrongType);
+    EXPECT_THROW(indexed->getIntList("arrays.ofBoolean"), ConfigExceptionWrongType);
+
+    // only resolved configs can be indexed
+    auto unresolved = Config::parseString("a = 1, b = ${a}");
+    EXPECT_THROW(unresolved->indexPaths(), ConfigExceptionNotResolved);
+    EXPECT_EQ(1, unresolved->resolve()->getInt("b"));
+}
+
+TEST_F(ConfigTest, test01GettingConvertedValues) {
+    auto conf = Config::parseString("a { b = \"42\", c = 7, d = \"yes\", e { f = 1 } }");
+    auto indexed = Config::parseString("a { b = \"42\", c = 7, d = \"yes\", e { f = 1 } }");
+    indexed->indexPaths();
+
+    for (auto& c : {conf, indexed}) {
+        // lookups borrow from the tree, but values made by a conversion are
+        // kept for the caller
+        EXPECT_EQ(42, c->getInt("a.b"));
+        EXPECT_EQ("7", c->getString("a.c"));
+        EXPECT_TRUE(c->getBoolean("a.d"));
+        EXPECT_EQ(42, *c->tryGetInt("a.b"));
+        EXPECT_EQ(42.0, c->getDouble("a.b"));
+        EXPECT_EQ("7", c->getValue("a.c")->render());
+        EXPECT_EQ(c->getObject("a.e"), c->getObject("a.e"));
+    }
+
+    auto value = conf->getValue("a.e.f");
+    conf.reset();
+    EXPECT_EQ(1, value->unwrapped<int32_t>());
+
+    // errors still name the path as far as the walk got
+    try {
+        indexed->getInt("a.x.y");
+        FAIL() << "expected ConfigExceptionMissing";
+    }
+    catch (ConfigExceptionMissing& e) {
+        EXPECT_NE(std::string::npos, std::string(e.what()).find("a.x"));
+        EXPECT_EQ(std::string::npos, std::string(e.what()).find("a.x.y"));
+    }
+}
+
+TEST_F(ConfigTest, test01GettingFrozen) {
+    auto conf = Config::load(resourcePath() + "/test01");
+    auto frozen = conf->freeze();
+    EXPECT_EQ(frozen, frozen->freeze());
+
+    // scalars come from the snapshot, whichever way the path is written
+    EXPECT_EQ(42, frozen->getInt("ints.fortyTwo"));
+    EXPECT_EQ(42, frozen->getInt("\"ints\".fortyTwo"));
+    EXPECT_EQ(42, frozen->getInt(ConfigPath::parse("ints.fortyTwo")));
+    EXPECT_EQ(42LL, frozen->getInt64("ints.fortyTwoAgain"));
+    EXPECT_DOUBLE_EQ(42.1, frozen->getDouble("floats.fortyTwoPointOne"));
+    EXPECT_DOUBLE_EQ(42.0, frozen->getDouble("ints.fortyTwo"));
+    EXPECT_EQ(conf->getInt("floats.fortyTwoPointOne"), frozen->getInt("floats.fortyTwoPointOne"));
+    EXPECT_EQ("abcd", frozen->getString("strings.abcd"));
+    EXPECT_EQ("abcd", frozen->getString(ConfigPath::parse("strings.abcdAgain")));
+    EXPECT_TRUE(frozen->getBoolean("booleans.trueAgain"));
+    EXPECT_FALSE(frozen->getBoolean(ConfigPath::parse("booleans.false")));
+
+    // conversions and everything else behave as before
+    EXPECT_EQ(57, frozen->getInt("strings.number"));
+    EXPECT_EQ("42", frozen->getString("ints.fortyTwo"));
+    EXPECT_EQ(42, frozen->getConfig("ints")->getInt("fortyTwo"));
+    EXPECT_TRUE(conf->getIntList("arrays.ofInt") == frozen->getIntList("arrays.ofInt"));
+    EXPECT_EQ(conf->getMilliseconds("durations.second"), frozen->getMilliseconds("durations.second"));
+    EXPECT_EQ(conf->root(), frozen->root());
+
+    EXPECT_TRUE(frozen->hasPath("ints"));
+    EXPECT_TRUE(frozen->hasPath("ints.fortyTwo"));
+    EXPECT_FALSE(frozen->hasPath("nulls.null"));
+    EXPECT_FALSE(frozen->hasPath("doesnotexist"));
+
+    EXPECT_THROW(frozen->getInt("doesnotexist"), ConfigExceptionMissing);
+    EXPECT_THROW(frozen->getInt("nulls.null"), ConfigExceptionNull);
+    EXPECT_THROW(frozen->getInt("strings.abcd"), ConfigExceptionWrongType);
+    EXPECT_THROW(frozen->getBoolean("ints.fortyTwo"), ConfigExceptionWrongType);
+    EXPECT_THROW(frozen->getInt("..bad"), ConfigExceptionBadPath);
+    EXPECT_THROW(Config::parseString("a = 3000000000")->freeze()->getInt("a"), ConfigExceptionWrongType);
+
+    EXPECT_TRUE(Config::emptyConfig()->freeze()->empty());
+    EXPECT_THROW(Config::parseString("a = 1, b = ${a}")->freeze(), ConfigExceptionNotResolved);
+}
+
+TEST_F(ConfigTest, test01TryGetting) {
+    auto conf = Config::load(resourcePath() + "/test01");
+
+    // values come back as the throwing getters return them
+    EXPECT_EQ(42, *conf->tryGetInt("ints.fortyTwoAgain"));
+    EXPECT_EQ(42LL, *conf->tryGetInt64(ConfigPath::parse("ints.fortyTwo")));
+    EXPECT_DOUBLE_EQ(42.1, *conf->tryGetDouble("floats.fortyTwoPointOne"));
+    EXPECT_EQ("abcd", *conf->tryGetString("strings.abcd"));
+    EXPECT_TRUE(*conf->tryGetBoolean("booleans.trueAgain"));
+    EXPECT_EQ("42", *conf->tryGetString("ints.fortyTwo"));
+    EXPECT_EQ(conf->getBytes("memsizes.meg"), *conf->tryGetBytes("memsizes.meg"));
+    EXPECT_EQ(conf->getBytes("memsizes.megAsNumber"), *conf->tryGetBytes("memsizes.megAsNumber"));
+    EXPECT_EQ(conf->getMilliseconds("durations.second"), *conf->tryGetMilliseconds("durations.second"));
+    EXPECT_EQ(conf->getMilliseconds("durations.secondAsNumber"), *conf->tryGetMilliseconds("durations.secondAsNumber"));
+    EXPECT_EQ(conf->getNanoseconds("durations.halfSecond"), *conf->tryGetNanoseconds(ConfigPath::parse("durations.halfSecond")));
+
+    // errors come back as the exception they stand for
+    auto missing = conf->tryGetInt("doesnotexist");
+    EXPECT_FALSE(missing);
+    EXPECT_EQ(ConfigError::MISSING, missing.error());
+    EXPECT_EQ(7, missing.valueOr(7));
+    EXPECT_EQ(ConfigError::MISSING, conf->tryGetInt("doesnotexist.deeper").error());
+    EXPECT_EQ(ConfigError::WRONG_TYPE, conf->tryGetInt("strings.abcd.deeper").error());
+    EXPECT_EQ(ConfigError::NULL_VALUE, conf->tryGetString("nulls.null").error());
+    EXPECT_EQ(ConfigError::WRONG_TYPE, conf->tryGetInt("strings.abcd").error());
+    EXPECT_EQ(ConfigError::WRONG_TYPE, conf->tryGetBoolean("ints.fortyTwo").error());
+    EXPECT_EQ(ConfigError::WRONG_TYPE, conf->tryGetMilliseconds("ints").error());
+    EXPECT_EQ(ConfigError::BAD_VALUE, conf->tryGetMilliseconds("strings.abcd").error());
+    EXPECT_EQ(ConfigError::BAD_VALUE, conf->tryGetBytes("strings.abcd").error());
+    EXPECT_EQ(ConfigError::BAD_PATH, conf->tryGetInt("..bad").error());
+    EXPECT_EQ(ConfigError::WRONG_TYPE, Config::parseString("a = 3000000000")->tryGetInt("a").error());
+    EXPECT_EQ(ConfigError::NOT_RESOLVED, Config::parseString("a = 1, b = ${a}")->tryGetInt("b").error());
+    EXPECT_EQ("BAD_VALUE", ConfigErrorEnum::name(ConfigError::BAD_VALUE));
+
+    // and the throwing getters, now built on them, still throw the same
+    EXPECT_THROW(conf->getMilliseconds("doesnotexist"), ConfigExceptionMissing);
+    EXPECT_THROW(conf->getMilliseconds("nulls.null"), ConfigExceptionNull);
+    EXPECT_THROW(conf->getMilliseconds("ints"), ConfigExceptionWrongType);
+    EXPECT_THROW(conf->getMilliseconds("strings.abcd"), ConfigExceptionBadValue);
+    EXPECT_THROW(conf->getBytes("strings.abcd"), ConfigExceptionBadValue);
+
+    // an index doesn't change the answers
+    conf->indexPaths();
+    EXPECT_EQ(42, *conf->tryGetInt("ints.fortyTwo"));
+    EXPECT_EQ(ConfigError::WRONG_TYPE, conf->tryGetInt("strings.abcd.deeper").error());
+}
+
+TEST_F(ConfigTest, test01GettingStringRefs) {
+    auto conf = Config::load(resourcePath() + "/test01");
+
+    // the same strings getString() copies, held by the config
+    const std::string& abcd = conf->getStringRef("strings.abcd");
+    EXPECT_EQ("abcd", abcd);
+    EXPECT_EQ(&abcd, &conf->getStringRef(ConfigPath::parse("strings.abcd")));
+    EXPECT_EQ(conf->getString("strings.abcdAgain"), conf->getStringRef("strings.abcdAgain"));
+
+    // numbers and booleans convert as for getString(), to a stable string
+    EXPECT_EQ("42", conf->getStringRef("ints.fortyTwo"));
+    EXPECT_EQ(&conf->getStringRef("ints.fortyTwo"), &conf->getStringRef("ints.fortyTwo"));
+    EXPECT_EQ("true", conf->getStringRef("booleans.trueAgain"));
+    EXPECT_EQ(conf->getString("floats.fortyTwoPointOne"), conf->getStringRef("floats.fortyTwoPointOne"));
+    auto fromMap = Config::parseMap(MapVariant({{"n", 42}}));
+    EXPECT_EQ("42", fromMap->getStringRef("n"));
+
+    VectorStringRef refs = conf->getStringRefList("arrays.ofString");
+    VectorString strings = conf->getStringList("arrays.ofString");
+    ASSERT_EQ(strings.size(), refs.size());
+    for (uint32_t i = 0; i < refs.size(); ++i) {
+        EXPECT_EQ(strings[i], refs[i].get());
+    }
+    VectorStringRef ints = conf->getStringRefList("arrays.ofInt");
+    EXPECT_EQ(VectorString({"1", "2", "3"}), VectorString(ints.begin(), ints.end()));
+
+    EXPECT_THROW(conf->getStringRef("doesnotexist"), ConfigExceptionMissing);
+    EXPECT_THROW(conf->getStringRef("nulls.null"), ConfigExceptionNull);
+    EXPECT_THROW(conf->getStringRef("ints"), ConfigExceptionWrongType);
+    EXPECT_THROW(conf->getStringRef("arrays.ofInt"), ConfigExceptionWrongType);
+    EXPECT_THROW(conf->getStringRefList("arrays.ofArray"), ConfigExceptionWrongType);
+    EXPECT_THROW(conf->getStringRefList("arrays.ofNull"), ConfigExceptionWrongType);
+
+    // a frozen snapshot hands out the same strings
+    auto frozen = conf->freeze();
+    EXPECT_EQ("abcd", frozen->getStringRef("strings.abcd"));
+}
+
+TEST_F(ConfigTest, test01GettingListViews) {
+    auto conf = Config::load(resourcePath() + "/test01");
+
+    auto ints = conf->getIntListView("arrays.ofInt");
+    EXPECT_EQ(VectorInt({1, 2, 3}), VectorInt(ints.begin(), ints.end()));
+    EXPECT_EQ(ints.data(), conf->getIntListView(ConfigPath::parse("arrays.ofInt")).data());
+    auto int64s = conf->getInt64ListView("arrays.ofInt");
+    EXPECT_EQ(VectorInt64({1, 2, 3}), VectorInt64(int64s.begin(), int64s.end()));
+    auto doubles = conf->getDoubleListView("arrays.ofDouble");
+    EXPECT_EQ(VectorDouble({3.14, 4.14, 5.14}), VectorDouble(doubles.begin(), doubles.end()));
+    auto booleans = conf->getBooleanListView("arrays.ofBoolean");
+    ASSERT_EQ(2u, booleans.size());
+    EXPECT_TRUE(booleans[0]);
+    EXPECT_FALSE(booleans[1]);
+    EXPECT_TRUE(conf->getIntListView("arrays.empty").empty());
+    EXPECT_TRUE(conf->getBooleanListView("arrays.empty").empty());
+
+    // elements convert as for the list getters
+    auto converted = Config::parseString("a = [\"1\", 2.5, 3], b = [yes, \"off\"], c = [1, 3000000000]");
+    auto mixed = converted->getIntListView("a");
+    EXPECT_EQ(VectorInt({1, 2, 3}), VectorInt(mixed.begin(), mixed.end()));
+    EXPECT_EQ(2.5, converted->getDoubleListView("a")[1]);
+    EXPECT_FALSE(converted->getBooleanListView("b")[1]);
+    EXPECT_EQ(3000000000LL, converted->getInt64ListView("c")[1]);
+    EXPECT_THROW(converted->getIntListView("c"), ConfigExceptionWrongType);
+    EXPECT_THROW(converted->getIntList("c"), ConfigExceptionWrongType);
+
+    // a substituted list is packed once resolved
+    auto substituted = Config::parseString("a = [1, 2], b = ${a} [3]")->resolve();
+    EXPECT_EQ(3u, substituted->getIntListView("b").size());
+
+    EXPECT_THROW(conf->getIntListView("doesnotexist"), ConfigExceptionMissing);
+    EXPECT_THROW(conf->getIntListView("nulls.null"), ConfigExceptionNull);
+    EXPECT_THROW(conf->getIntListView("ints.fortyTwo"), ConfigExceptionWrongType);
+    EXPECT_THROW(conf->getIntListView("arrays.ofString"), ConfigExceptionWrongType);
+    EXPECT_THROW(conf->getBooleanListView("arrays.ofInt"), ConfigExceptionWrongType);
+    EXPECT_THROW(conf->getDoubleListView("arrays.ofNull"), ConfigExceptionWrongType);
+
+    // filling a caller's vector
+    VectorInt64 list(10, 7);
+    conf->getInt64List("arrays.ofInt", list);
+    EXPECT_EQ(VectorInt64({1, 2, 3}), list);
+    VectorBool flags;
+    conf->getBooleanList(ConfigPath::parse("arrays.ofBoolean"), flags);
+    EXPECT_EQ(VectorBool({true, false}), flags);
+    VectorInt unconverted;
+    EXPECT_THROW(conf->getIntList("arrays.ofString", unconverted), ConfigExceptionWrongType);
+}
+
+TEST_F(ConfigTest, listViewsPackedOnceFromThreads) {
+    auto conf = parseConfig("ports = [8080, 8081, \"8082\"], flags = [true, false]");
+    std::vector<const int32_t*> data(4, nullptr);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([&conf, &data, t]() {
+            data[t] = conf->getIntListView("ports").data();
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto d : data) {
+        EXPECT_EQ(data[0], d);
+    }
+    EXPECT_EQ(8082, conf->getIntListView("ports")[2]);
+    EXPECT_THROW(conf->getBooleanListView("ports"), ConfigExceptionWrongType);
+    EXPECT_TRUE(conf->getBooleanListView("flags")[0]);
+}
+
 TEST_F(ConfigTest, test05LoadPlayApplicationConf) {
     auto conf = Config::load(resourcePath() + "/test05");
 
@@ -857,3 +1178,36 @@ TEST_F(ConfigTest, renderRoundTrip) {
         }
     }
 }
+
+TEST_F(ConfigTest, droppedConfigsAreFreed) {
+    std::string text = "defaults { timeout = 30s, retries = 3, tags = [a, b] }\n";
+    for (uint32_t i = 0; i < 20; ++i) {
+        std::string n = boost::lexical_cast<std::string>(i);
+        text += "service" + n + " = ${defaults} { host = \"host-" + n + ".example.com\", ports = [80, 443] }\n";
+    }
+
+    auto load = [&text]() {
+        std::weak_ptr<ConfigObject> parsed;
+        std::weak_ptr<ConfigObject> resolved;
+        {
+            auto conf = Config::parseString(text);
+            parsed = conf->root();
+            auto r = conf->resolve();
+            resolved = r->root();
+            EXPECT_EQ("host-7.example.com", r->getConfig("service7")->getString("host"));
+            auto held = r->root()->toConfig();
+            EXPECT_EQ(held, r->root()->toConfig());
+        }
+        EXPECT_TRUE(parsed.expired());
+        EXPECT_TRUE(resolved.expired());
+    };
+
+    // a tree and its configs go once the last Config does, so reloading
+    // doesn't grow the heap (nor the interned strings, which its values hold)
+    load();
+    uint32_t interned = InternedString::tableSize();
+    for (uint32_t i = 0; i < 1000; ++i) {
+        load();
+    }
+    EXPECT_EQ(interned, InternedString::tableSize());
+}
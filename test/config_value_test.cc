@@ -13,6 +13,7 @@
 #include "configcpp/detail/config_delayed_merge.h"
 #include "configcpp/detail/config_delayed_merge_object.h"
 #include "configcpp/detail/config_number.h"
+#include "configcpp/detail/config_int64.h"
 #include "configcpp/detail/resolve_status.h"
 #include "configcpp/config.h"
 #include "configcpp/config_value_type.h"
@@ -634,3 +635,40 @@ TEST_F(ConfigValueTest, withValueBuildComplexConfig) {
         ->withValue("x.y.z", v4);
     checkEquals(std::dynamic_pointer_cast<ConfigBase>(parseConfig("a=1,b.c=2,b.d=3,x.y.z=4")), std::dynamic_pointer_cast<ConfigBase>(config));
 }
+
+TEST_F(ConfigValueTest, valueKinds) {
+    EXPECT_EQ(ConfigValueKind::INT, intValue(1)->kind());
+    EXPECT_EQ(ConfigValueKind::INT64, ConfigInt64::make_instance(fakeOrigin(), 1LL << 40, "")->kind());
+    EXPECT_EQ(ConfigValueKind::DOUBLE, doubleValue(1.5)->kind());
+    EXPECT_EQ(ConfigValueKind::BOOLEAN, boolValue(true)->kind());
+    EXPECT_EQ(ConfigValueKind::NULL_VALUE, nullValue()->kind());
+    EXPECT_EQ(ConfigValueKind::STRING, stringValue("a")->kind());
+    EXPECT_EQ(ConfigValueKind::REFERENCE, subst("a")->kind());
+    EXPECT_EQ(ConfigValueKind::CONCATENATION, substInString("a")->kind());
+    EXPECT_EQ(ConfigValueKind::LIST, SimpleConfigList::make_instance(fakeOrigin(), VectorAbstractConfigValue())->kind());
+
+    auto object = parseObject("a = 1");
+    EXPECT_EQ(ConfigValueKind::OBJECT, object->kind());
+    EXPECT_TRUE(object->isObject());
+    EXPECT_FALSE(object->isUnmergeable());
+
+    auto delayedObject = ConfigDelayedMergeObject::make_instance(fakeOrigin(), VectorAbstractConfigValue({object, object}));
+    EXPECT_EQ(ConfigValueKind::DELAYED_MERGE_OBJECT, delayedObject->kind());
+    EXPECT_TRUE(delayedObject->isObject());
+    EXPECT_TRUE(delayedObject->isUnmergeable());
+
+    auto delayed = ConfigDelayedMerge::make_instance(fakeOrigin(), VectorAbstractConfigValue({subst("a"), intValue(1)}));
+    EXPECT_EQ(ConfigValueKind::DELAYED_MERGE, delayed->kind());
+    EXPECT_FALSE(delayed->isObject());
+    EXPECT_TRUE(delayed->isUnmergeable());
+    EXPECT_TRUE(subst("a")->isUnmergeable());
+    EXPECT_FALSE(intValue(1)->isUnmergeable());
+}
+
+TEST_F(ConfigValueTest, castToImplementation) {
+    ConfigValuePtr value = intValue(42);
+    auto abstract = AbstractConfigValue::cast(value);
+    EXPECT_EQ(std::dynamic_pointer_cast<AbstractConfigValue>(value), abstract);
+    EXPECT_EQ(ConfigValueKind::INT, abstract->kind());
+    EXPECT_FALSE(AbstractConfigValue::cast(nullptr));
+}
@@ -29,6 +29,22 @@ TEST_F(FileReaderTest, readChars) {
     }
 }
 
+TEST_F(FileReaderTest, readChunks) {
+    std::string filePath = resourcePath() + "/lorem_ipsum";
+    auto reader = FileReader::make_instance(filePath);
+    std::string output(1, static_cast<char>(reader->read()));
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    while (reader->readChunk(begin, end)) {
+        EXPECT_NE(begin, end);
+        output.append(begin, end);
+    }
+    EXPECT_EQ(1000 * 57 - 1, output.length());
+    EXPECT_TRUE(boost::starts_with(output, "Lorem ipsum"));
+    EXPECT_TRUE(boost::ends_with(output, "adipiscing elit."));
+    EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
+}
+
 TEST_F(FileReaderTest, readPastEof) {
     std::string filePath = resourcePath() + "/lorem_ipsum";
     auto reader = FileReader::make_instance(filePath);
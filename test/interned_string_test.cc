@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test_fixture.h"
+#include "configcpp/interned_string.h"
+#include "configcpp/config.h"
+#include "configcpp/config_object.h"
+
+#include <thread>
+
+using namespace config;
+
+class InternedStringTest : public TestFixture {
+};
+
+TEST_F(InternedStringTest, equalStringsShareEntry) {
+    InternedString a(std::string("a rather long key, beyond any small string buffer"));
+    InternedString b("a rather long key, beyond any small string buffer");
+    InternedString c("another key");
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(&a.str(), &b.str());
+    EXPECT_NE(a, c);
+    EXPECT_EQ(a.hashCode(), b.hashCode());
+    EXPECT_EQ(std::hash<std::string>()("another key"), c.hashCode());
+
+    EXPECT_TRUE(a == "a rather long key, beyond any small string buffer");
+    EXPECT_TRUE(std::string("another key") == c);
+    EXPECT_TRUE(c != a.str());
+    EXPECT_EQ("another key!", c + "!");
+    EXPECT_TRUE(a < c);
+    EXPECT_FALSE(a < b);
+}
+
+TEST_F(InternedStringTest, emptyString) {
+    InternedString empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(InternedString(""), empty);
+    EXPECT_EQ("", empty.str());
+    EXPECT_EQ(std::hash<std::string>()(""), empty.hashCode());
+}
+
+TEST_F(InternedStringTest, entryFreedWithLastHandle) {
+    uint32_t before = InternedString::tableSize();
+    {
+        InternedString a("interned-string-test-only");
+        EXPECT_EQ(before + 1, InternedString::tableSize());
+        InternedString copy(a);
+        InternedString assigned;
+        assigned = copy;
+        assigned = assigned;
+        EXPECT_EQ(before + 1, InternedString::tableSize());
+    }
+    EXPECT_EQ(before, InternedString::tableSize());
+}
+
+TEST_F(InternedStringTest, internFromThreads) {
+    uint32_t before = InternedString::tableSize();
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([]() {
+            for (uint32_t i = 0; i < 2000; ++i) {
+                InternedString s("threaded-" + boost::lexical_cast<std::string>(i % 20));
+                InternedString copy(s);
+                EXPECT_EQ(s, InternedString(copy.str()));
+            }
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(before, InternedString::tableSize());
+}
+
+TEST_F(InternedStringTest, configSharesValues) {
+    auto conf = Config::parseString("a { host = \"db.internal.example.com\" }, b { host = \"db.internal.example.com\" }");
+    EXPECT_EQ(&conf->getStringRef("a.host"), &conf->getStringRef("b.host"));
+    EXPECT_EQ("db.internal.example.com", conf->getString("b.host"));
+
+    // keys are interned too, but read as plain strings for code iterating an object
+    static_assert(std::is_same<decltype(ConfigObject::value_type::first), const std::string&>::value, "string keys");
+    auto a = conf->getObject("a");
+    EXPECT_EQ("host", a->begin()->first);
+    EXPECT_EQ(&a->begin()->first, &conf->getObject("b")->begin()->first);
+
+    // merged objects keep the same values
+    auto merged = std::dynamic_pointer_cast<ConfigObject>(a->withFallback(conf->getObject("b")))->toConfig();
+    EXPECT_EQ(&conf->getStringRef("a.host"), &merged->getStringRef("host"));
+}
@@ -5,10 +5,46 @@
 
 #include "test_fixture.h"
 #include "configcpp/detail/config_impl_util.h"
+#include "configcpp/detail/json_parser.h"
+#include "configcpp/detail/parser.h"
+#include "configcpp/detail/tokenizer.h"
+#include "configcpp/detail/string_reader.h"
+#include "configcpp/detail/simple_config_origin.h"
+#include "configcpp/detail/abstract_config_object.h"
+#include "configcpp/config_parse_options.h"
+#include "configcpp/config_syntax.h"
+#include "configcpp/config_origin.h"
+#include "configcpp/config_list.h"
+#include "configcpp/config_exception.h"
 
 using namespace config;
 
 class JsonTest : public TestFixture {
+protected:
+    ConfigParseOptionsPtr jsonOptions() {
+        return ConfigParseOptions::defaults()->setSyntax(ConfigSyntax::JSON);
+    }
+
+    AbstractConfigValuePtr parseFast(const std::string& s) {
+        auto origin = SimpleConfigOrigin::newSimple("test json string");
+        return JsonParser::parse(StringReader::make_instance(s), origin, jsonOptions(), nullptr);
+    }
+
+    AbstractConfigValuePtr parseGeneral(const std::string& s) {
+        auto origin = SimpleConfigOrigin::newSimple("test json string");
+        auto tokens = Tokenizer::tokenize(origin, StringReader::make_instance(s), ConfigSyntax::JSON);
+        return Parser::parse(tokens, origin, jsonOptions(), nullptr);
+    }
+
+    std::string parseError(const std::function<AbstractConfigValuePtr()>& parse) {
+        try {
+            parse();
+        }
+        catch (ConfigException& e) {
+            return e.what();
+        }
+        return "";
+    }
 };
 
 TEST_F(JsonTest, renderingJsonStrings) {
@@ -18,3 +54,57 @@ TEST_F(JsonTest, renderingJsonStrings) {
     // are weird and happen on the source file before doing other processing.
     EXPECT_EQ("\"\\u001f\"", ConfigImplUtil::renderJsonString("\u001f"));
 }
+
+TEST_F(JsonTest, validJsonWorks) {
+    for (auto& valid : whitespaceVariations(validJson())) {
+        auto fast = parseFast(valid);
+        checkEquals(parseGeneral(valid), fast, valid);
+        EXPECT_EQ(parseGeneral(valid)->origin()->description(), fast->origin()->description()) << valid;
+    }
+}
+
+TEST_F(JsonTest, invalidJsonThrows) {
+    // errors come from the general parser, so they are exactly the same
+    for (auto& invalid : whitespaceVariations(invalidJson())) {
+        std::string error = parseError([&]() { return parseFast(invalid); });
+        EXPECT_FALSE(error.empty()) << "Expected exception for:" << invalid;
+        EXPECT_EQ(parseError([&]() { return parseGeneral(invalid); }), error);
+    }
+}
+
+TEST_F(JsonTest, fastJsonMatchesGeneralParser) {
+    VectorString documents = {
+        "{ \"a\" : \"\\\" \\\\ \\/ \\b \\f \\n \\r \\t \\u0041\" }",
+        "[ -1, 0, 2147483648, -9223372036854775808, 1.5, -2.5e10, 1E-3, 0.1 ]",
+        "[ true, false, null, \"\", \"x\" ]",
+        "{ \"a.b\" : 1, \"\" : 2 }",
+        "\n\n{\n  \"a\" : [\n    1,\n    { \"b\" : null }\n  ],\n  \"c\" : {}\n}\n"
+    };
+    for (auto& document : documents) {
+        checkEquals(parseGeneral(document), parseFast(document), document);
+    }
+
+    // the same line numbers are kept on every value
+    auto general = std::dynamic_pointer_cast<AbstractConfigObject>(parseGeneral(documents.back()));
+    auto fast = std::dynamic_pointer_cast<AbstractConfigObject>(parseFast(documents.back()));
+    EXPECT_EQ(general->origin()->description(), fast->origin()->description());
+    for (auto& key : {"a", "c"}) {
+        EXPECT_EQ(general->get(key)->origin()->lineNumber(), fast->get(key)->origin()->lineNumber()) << key;
+    }
+    auto generalList = std::dynamic_pointer_cast<ConfigList>(general->get("a"));
+    auto fastList = std::dynamic_pointer_cast<ConfigList>(fast->get("a"));
+    EXPECT_EQ(5, fastList->at(0)->origin()->lineNumber());
+    EXPECT_EQ(generalList->at(0)->origin()->lineNumber(), fastList->at(0)->origin()->lineNumber());
+    EXPECT_EQ(generalList->at(1)->origin()->lineNumber(), fastList->at(1)->origin()->lineNumber());
+}
+
+TEST_F(JsonTest, fastJsonHandsOffToGeneralParser) {
+    // valid JSON for the general parser that the fast path leaves alone
+    auto triple = parseFast("{ \"a\" : \"\"\"x\"\"\" }");
+    EXPECT_EQ("x", std::dynamic_pointer_cast<AbstractConfigObject>(triple)->get("a")->unwrapped<std::string>());
+
+    // errors still carry the line they happened on
+    std::string error = parseError([&]() { return parseFast("{\n\"a\" : 1,\n\"a\" : 2 }"); });
+    EXPECT_TRUE(boost::contains(error, "3:")) << error;
+    EXPECT_TRUE(boost::contains(error, "duplicate")) << error;
+}
@@ -0,0 +1,96 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test_fixture.h"
+#include "configcpp/detail/mapped_file_reader.h"
+#include "configcpp/detail/file_reader.h"
+#include "configcpp/config_exception.h"
+
+using namespace config;
+
+class MappedFileReaderTest : public TestFixture {
+};
+
+TEST_F(MappedFileReaderTest, readChars) {
+    std::string filePath = resourcePath() + "/lorem_ipsum";
+    auto reader = MappedFileReader::make_instance(filePath);
+    EXPECT_TRUE(reader->mapped());
+    std::string output;
+    for (int32_t read = reader->read(); read != Reader::READER_EOF; read = reader->read()) {
+        output += static_cast<char>(read);
+    }
+    EXPECT_TRUE(boost::starts_with(output, "Lorem ipsum"));
+    EXPECT_TRUE(boost::ends_with(output, "adipiscing elit."));
+    VectorString lines;
+    boost::split(lines, output, boost::is_any_of("\n"));
+    EXPECT_EQ(1000, lines.size());
+    for (auto& line : lines) {
+        EXPECT_EQ("Lorem ipsum dolor sit amet, consectetur adipiscing elit.", line);
+    }
+}
+
+TEST_F(MappedFileReaderTest, sameCharsAsFileReader) {
+    std::string filePath = resourcePath() + "/test01.conf";
+    auto mapped = MappedFileReader::make_instance(filePath);
+    auto streamed = FileReader::make_instance(filePath);
+    int32_t c = 0;
+    do {
+        c = streamed->read();
+        EXPECT_EQ(c, mapped->read());
+    } while (c != Reader::READER_EOF);
+}
+
+TEST_F(MappedFileReaderTest, readChunks) {
+    std::string filePath = resourcePath() + "/lorem_ipsum";
+    auto reader = MappedFileReader::make_instance(filePath);
+    std::string output(1, static_cast<char>(reader->read()));
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    while (reader->readChunk(begin, end)) {
+        output.append(begin, end);
+    }
+    EXPECT_EQ(1000 * 57 - 1, output.length());
+    EXPECT_TRUE(boost::starts_with(output, "Lorem ipsum"));
+    EXPECT_TRUE(boost::ends_with(output, "adipiscing elit."));
+    EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
+}
+
+TEST_F(MappedFileReaderTest, readPastEof) {
+    std::string filePath = resourcePath() + "/lorem_ipsum";
+    auto reader = MappedFileReader::make_instance(filePath);
+    while (reader->read() != Reader::READER_EOF) {
+    }
+    EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
+    EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
+}
+
+TEST_F(MappedFileReaderTest, readAfterClosing) {
+    std::string filePath = resourcePath() + "/lorem_ipsum";
+    auto reader = MappedFileReader::make_instance(filePath);
+    reader->read();
+    reader->read();
+    reader->read();
+    reader->read();
+    reader->close();
+    EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
+    EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
+}
+
+TEST_F(MappedFileReaderTest, streamsSpecialFiles) {
+    // character devices can't be mapped so we fall back to streaming
+    auto reader = MappedFileReader::make_instance("/dev/null");
+    EXPECT_FALSE(reader->mapped());
+    EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
+}
+
+TEST_F(MappedFileReaderTest, badPath) {
+    std::string filePath = "bad path";
+    EXPECT_THROW(MappedFileReader::make_instance(filePath), ConfigExceptionFileNotFound);
+}
+
+TEST_F(MappedFileReaderTest, fileNotExist) {
+    std::string filePath = resourcePath() + "/not_exist";
+    EXPECT_THROW(MappedFileReader::make_instance(filePath), ConfigExceptionFileNotFound);
+}
@@ -0,0 +1,132 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test_fixture.h"
+#include "configcpp/detail/number_parser.h"
+
+using namespace config;
+
+class NumberParserTest : public TestFixture {
+protected:
+    /// NumberParser must accept exactly what lexical_cast accepts, with
+    /// bit-for-bit identical results.
+    void checkSameAsLexicalCast(const std::string& s) {
+        int64_t expectedInt = 0;
+        bool expectedIntOk = true;
+        try {
+            expectedInt = boost::lexical_cast<int64_t>(s);
+        }
+        catch (boost::bad_lexical_cast&) {
+            expectedIntOk = false;
+        }
+        int64_t actualInt = 0;
+        ASSERT_EQ(expectedIntOk, NumberParser::parseInt64(s, actualInt)) << "int64 '" << s << "'";
+        if (expectedIntOk) {
+            ASSERT_EQ(expectedInt, actualInt) << "int64 '" << s << "'";
+        }
+
+        double expectedDouble = 0.0;
+        bool expectedDoubleOk = true;
+        try {
+            expectedDouble = boost::lexical_cast<double>(s);
+        }
+        catch (boost::bad_lexical_cast&) {
+            expectedDoubleOk = false;
+        }
+        double actualDouble = 0.0;
+        ASSERT_EQ(expectedDoubleOk, NumberParser::parseDouble(s, actualDouble)) << "double '" << s << "'";
+        if (expectedDoubleOk) {
+            ASSERT_EQ(0, std::memcmp(&expectedDouble, &actualDouble, sizeof(double)))
+                << "double '" << s << "': " << std::setprecision(17) << expectedDouble << " != " << actualDouble;
+        }
+    }
+};
+
+TEST_F(NumberParserTest, parseInt64) {
+    int64_t value = 0;
+    EXPECT_TRUE(NumberParser::parseInt64("42", value));
+    EXPECT_EQ(42, value);
+    EXPECT_TRUE(NumberParser::parseInt64("-9223372036854775808", value));
+    EXPECT_EQ(std::numeric_limits<int64_t>::min(), value);
+    EXPECT_TRUE(NumberParser::parseInt64("+9223372036854775807", value));
+    EXPECT_EQ(std::numeric_limits<int64_t>::max(), value);
+    EXPECT_FALSE(NumberParser::parseInt64("9223372036854775808", value));
+    EXPECT_FALSE(NumberParser::parseInt64("", value));
+    EXPECT_FALSE(NumberParser::parseInt64("-", value));
+    EXPECT_FALSE(NumberParser::parseInt64("1.0", value));
+    EXPECT_FALSE(NumberParser::parseInt64(" 1", value));
+}
+
+TEST_F(NumberParserTest, parseDouble) {
+    double value = 0.0;
+    EXPECT_TRUE(NumberParser::parseDouble("3.14", value));
+    EXPECT_EQ(3.14, value);
+    EXPECT_TRUE(NumberParser::parseDouble("-1e3", value));
+    EXPECT_EQ(-1000.0, value);
+    EXPECT_TRUE(NumberParser::parseDouble(".5", value));
+    EXPECT_EQ(0.5, value);
+    EXPECT_TRUE(NumberParser::parseDouble("inf", value));
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), value);
+    EXPECT_FALSE(NumberParser::parseDouble("1e", value));
+    EXPECT_FALSE(NumberParser::parseDouble("1e+", value));
+    EXPECT_FALSE(NumberParser::parseDouble(".", value));
+    EXPECT_FALSE(NumberParser::parseDouble("1e400", value));
+    EXPECT_FALSE(NumberParser::parseDouble("1.2.3", value));
+}
+
+TEST_F(NumberParserTest, sameAsLexicalCastForEdgeCases) {
+    for (auto& s : {
+            "", "0", "-0", "+0", "00", "007", "-", "+", "--1", "+-1", ".", "-.", ".0", "0.", "-0.0",
+            "1.", "1.e5", ".e5", "e5", "1e", "1E", "1e+", "1e-", "1e5", "1E+05", "1e-5", "1e5.0", "1..0",
+            "1.5e308", "1.8e308", "4.9e-324", "2.4e-324", "1e-400", "0e999999", "1e99999999999",
+            "9007199254740992", "9007199254740993", "9007199254740993.0", "123456789012345678901234567890",
+            "0.1", "0.2", "0.3", "2.2250738585072011e-308", "2.2250738585072014e-308", "1e22", "1e23",
+            "123456789e-22", "1234567890123456789e-3", "12345678901234567890e-3",
+            "0.000000000000000000000000000001", "100000000000000000000000", "3.14159265358979323846",
+            "inf", "-inf", "INF", "infinity", "-Infinity", "infinit", "nan", "-nan", "NaN", "nan()", "nan(1)",
+            "nanx", "in", "0x10", " 1", "1 ", "1,5", "1_000", "\xd9\xa1", "9223372036854775807",
+            "9223372036854775808", "-9223372036854775808", "-9223372036854775809", "18446744073709551616"
+         }) {
+        checkSameAsLexicalCast(s);
+    }
+}
+
+TEST_F(NumberParserTest, sameAsLexicalCastForRandomStrings) {
+    // mostly number-shaped strings, with the odd bad character
+    std::string alphabet = "0123456789012345678901234567890123456789..eE+-x ";
+    uint32_t seed = 4242;
+    for (uint32_t i = 0; i < 50000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t length = 1 + (seed >> 16) % 12;
+        std::string s;
+        for (uint32_t j = 0; j < length; ++j) {
+            seed = seed * 1103515245 + 12345;
+            s += alphabet[(seed >> 16) % alphabet.length()];
+        }
+        checkSameAsLexicalCast(s);
+    }
+}
+
+TEST_F(NumberParserTest, sameAsLexicalCastForPrintedDoubles) {
+    uint64_t seed = 99;
+    for (uint32_t i = 0; i < 20000; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        double d;
+        uint64_t bits = seed;
+        std::memcpy(&d, &bits, sizeof(double));
+        if (d != d || d == std::numeric_limits<double>::infinity() || d == -std::numeric_limits<double>::infinity()) {
+            continue;
+        }
+        for (auto& format : {"%.17g", "%.6g", "%.3f", "%g"}) {
+            char buffer[512];
+            snprintf(buffer, sizeof(buffer), format, d);
+            checkSameAsLexicalCast(buffer);
+        }
+        // short decimals, the common case in config files
+        char shortDecimal[64];
+        snprintf(shortDecimal, sizeof(shortDecimal), "%d.%d", static_cast<int32_t>(seed >> 40) % 100000, static_cast<int32_t>(seed >> 20) % 1000);
+        checkSameAsLexicalCast(shortDecimal);
+    }
+}
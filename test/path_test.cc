@@ -6,6 +6,12 @@
 #include "test_fixture.h"
 #include "configcpp/detail/path.h"
 #include "configcpp/detail/parser.h"
+#include "configcpp/detail/path_cache.h"
+#include "configcpp/config_path.h"
+#include "configcpp/config_value.h"
+#include "configcpp/config.h"
+
+#include <thread>
 
 using namespace config;
 
@@ -99,9 +105,122 @@ TEST_F(PathTest, pathLast) {
     EXPECT_EQ("b", path({"a", "b"})->last());
 }
 
+TEST_F(PathTest, pathSlices) {
+    auto abcd = path({"a", "b", "c", "d"});
+    checkEqualObjects(path({"b", "c", "d"}), abcd->remainder());
+    checkEqualObjects(path({"c", "d"}), abcd->subPath(2));
+    checkEqualObjects(path({"b", "c"}), abcd->subPath(1, 3));
+    checkEqualObjects(path({"b"}), abcd->remainder()->parent()->parent());
+    EXPECT_FALSE(abcd->subPath(4));
+    EXPECT_FALSE(abcd->subPath(2, 2));
+    EXPECT_THROW(abcd->subPath(3, 2), ConfigExceptionBugOrBroken);
+    EXPECT_EQ("c", abcd->subPath(1, 3)->last());
+    EXPECT_EQ("d", abcd->element(3));
+    EXPECT_EQ("b.c", abcd->subPath(1, 3)->render());
+    checkNotEqualObjects(path({"a", "b"}), abcd->subPath(2));
+}
+
 TEST_F(PathTest, pathsAreInvalid) {
     // this test is just of the Path.newPath() wrapper, the extensive
     // test of different paths is over in ConfParserTest
     EXPECT_THROW(Path::newPath(""), ConfigExceptionBadPath);
     EXPECT_THROW(Path::newPath(".."), ConfigExceptionBadPath);
 }
+
+TEST_F(PathTest, pathCache) {
+    PathCache::clear();
+    auto a = ConfigPath::parse("a.b.c");
+    auto again = ConfigPath::parse("a.b.c");
+    EXPECT_EQ(a, again);
+    EXPECT_EQ("a.b.c", again->expression());
+    checkEquals(path({"a", "b", "c"}), again->path());
+    EXPECT_EQ(1, PathCache::hits());
+    EXPECT_EQ(1, PathCache::misses());
+
+    // bad paths throw every time and aren't cached
+    EXPECT_THROW(ConfigPath::parse("a..b"), ConfigExceptionBadPath);
+    EXPECT_THROW(ConfigPath::parse("a..b"), ConfigExceptionBadPath);
+    EXPECT_EQ(1, PathCache::size());
+
+    // bounded
+    PathCache::setLimit(2);
+    for (auto& p : {"x", "y", "z", "x.y", "y.z"}) {
+        checkEquals(ConfigPath::parse(p)->path(), Parser::parsePath(p));
+        EXPECT_GE(2, PathCache::size());
+    }
+
+    // disabled
+    PathCache::setLimit(0);
+    EXPECT_NE(ConfigPath::parse("a.b.c"), ConfigPath::parse("a.b.c"));
+    EXPECT_EQ(0, PathCache::size());
+
+    PathCache::setLimit(PathCache::DEFAULT_LIMIT);
+    PathCache::clear();
+}
+
+TEST_F(PathTest, pathCacheKeepsLookedUpPaths) {
+    PathCache::setLimit(4);
+    auto hot = ConfigPath::parse("hot");
+    for (auto& p : {"c1", "c2", "c3"}) {
+        ConfigPath::parse(p);
+    }
+    EXPECT_EQ(hot, ConfigPath::parse("hot"));
+
+    // a burst of one-off paths replaces the others before the hot one
+    for (auto& p : {"c4", "c5", "c6"}) {
+        ConfigPath::parse(p);
+        EXPECT_EQ(4, PathCache::size());
+    }
+    EXPECT_EQ(hot, ConfigPath::parse("hot"));
+
+    PathCache::setLimit(PathCache::DEFAULT_LIMIT);
+    PathCache::clear();
+}
+
+TEST_F(PathTest, pathCacheSharedBetweenThreads) {
+    // a path another thread cached is found in the shared table, and after
+    // that in this thread's recent paths
+    PathCache::clear();
+    ConfigPathPtr fromThread;
+    std::thread([&fromThread]() {
+        fromThread = ConfigPath::parse("shared.path");
+    }).join();
+    EXPECT_EQ(fromThread, ConfigPath::parse("shared.path"));
+    EXPECT_EQ(fromThread, ConfigPath::parse("shared.path"));
+    EXPECT_EQ(2, PathCache::hits());
+    EXPECT_EQ(1, PathCache::misses());
+
+    // clearing drops the recent paths too
+    PathCache::clear();
+    EXPECT_NE(fromThread, ConfigPath::parse("shared.path"));
+    EXPECT_EQ(1, PathCache::misses());
+    PathCache::clear();
+}
+
+TEST_F(PathTest, internalPathsAreNotCached) {
+    PathCache::clear();
+    Path::newPath("a.b.c");
+    ConfigValue::fromAnyRef(1)->atPath("x.y");
+    parseConfig("a.b = 1, c = 2")->withOnlyPath("a.b")->withoutPath("a.b");
+    EXPECT_EQ(0, PathCache::size());
+}
+
+TEST_F(PathTest, pathCacheFromThreads) {
+    PathCache::clear();
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.push_back(std::thread([t]() {
+            for (uint32_t i = 0; i < 1000; ++i) {
+                auto p = "a.b" + boost::lexical_cast<std::string>((i + t) % 50);
+                ConfigPath::parse(p);
+            }
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(4000, PathCache::hits() + PathCache::misses());
+    EXPECT_EQ(50, PathCache::size());
+    checkEquals(path({"a", "b7"}), ConfigPath::parse("a.b7")->path());
+    PathCache::clear();
+}
@@ -0,0 +1,155 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2012 Alan Wright. All rights reserved.
+// Distributable under the terms of the Apache License (Version 2.0).
+/////////////////////////////////////////////////////////////////////////////
+
+#include "test_fixture.h"
+#include "configcpp/small_map.h"
+#include "configcpp/interned_string.h"
+
+using namespace config;
+
+class SmallMapTest : public TestFixture {
+protected:
+    typedef SmallMap<std::string, int32_t, 4> Map;
+
+    /// Check map holds exactly the keys "k0" .. "k<count - 1>" mapped to
+    /// their numbers, whichever way it is read.
+    void checkContents(const Map& map, int32_t count) {
+        EXPECT_EQ(count, map.size());
+        EXPECT_EQ(count == 0, map.empty());
+        std::set<std::string> seen;
+        for (auto& entry : map) {
+            EXPECT_EQ("k" + boost::lexical_cast<std::string>(entry.second), entry.first);
+            EXPECT_TRUE(seen.insert(entry.first).second);
+        }
+        EXPECT_EQ(count, seen.size());
+        for (int32_t i = 0; i < count; ++i) {
+            std::string key = "k" + boost::lexical_cast<std::string>(i);
+            auto found = map.find(key);
+            ASSERT_TRUE(found != map.end());
+            EXPECT_EQ(i, found->second);
+            EXPECT_EQ(1, map.count(key));
+        }
+        EXPECT_TRUE(map.find("missing") == map.end());
+        EXPECT_EQ(0, map.count("missing"));
+    }
+};
+
+TEST_F(SmallMapTest, insertAndFind) {
+    Map map;
+    checkContents(map, 0);
+    for (int32_t i = 0; i < 10; ++i) {
+        auto inserted = map.insert(std::make_pair("k" + boost::lexical_cast<std::string>(i), i));
+        EXPECT_TRUE(inserted.second);
+        EXPECT_EQ(i, inserted.first->second);
+        // at the limit and beyond it, when the entries are indexed
+        checkContents(map, i + 1);
+    }
+    auto again = map.insert(std::make_pair(std::string("k3"), 42));
+    EXPECT_FALSE(again.second);
+    EXPECT_EQ(3, again.first->second);
+}
+
+TEST_F(SmallMapTest, subscript) {
+    Map small;
+    small["k0"] = 0;
+    small["k1"] = 7;
+    small["k1"] = 1;
+    checkContents(small, 2);
+
+    Map large;
+    for (int32_t i = 0; i < 6; ++i) {
+        large["k" + boost::lexical_cast<std::string>(i)] = i;
+    }
+    checkContents(large, 6);
+}
+
+TEST_F(SmallMapTest, erase) {
+    Map map({{"k0", 0}, {"k1", 1}, {"gone", 9}, {"k2", 2}});
+    EXPECT_EQ(1, map.erase("gone"));
+    EXPECT_EQ(0, map.erase("gone"));
+    checkContents(map, 3);
+
+    map.insert(std::make_pair(std::string("k3"), 3));
+    map.insert(std::make_pair(std::string("k4"), 4));
+    map.insert(std::make_pair(std::string("gone"), 9));
+    map.erase(map.find("gone"));
+    checkContents(map, 5);
+
+    map.clear();
+    checkContents(map, 0);
+}
+
+TEST_F(SmallMapTest, copies) {
+    std::unordered_map<std::string, int32_t> source({{"k0", 0}, {"k1", 1}, {"k2", 2}});
+    Map small(source.begin(), source.end());
+    checkContents(small, 3);
+
+    for (int32_t i = 3; i < 6; ++i) {
+        source["k" + boost::lexical_cast<std::string>(i)] = i;
+    }
+    Map large(source.begin(), source.end());
+    checkContents(large, 6);
+
+    Map copy(large);
+    copy = small;
+    checkContents(copy, 3);
+    copy = large;
+    large.clear();
+    checkContents(copy, 6);
+}
+
+TEST_F(SmallMapTest, movesWithoutCopying) {
+    std::unordered_map<std::string, int32_t> source({{"k0", 0}, {"k1", 1}, {"k2", 2}});
+    Map small(source.begin(), source.end());
+    auto smallEntry = &*small.find("k1");
+    Map movedSmall(std::move(small));
+    checkContents(movedSmall, 3);
+    EXPECT_EQ(smallEntry, &*movedSmall.find("k1"));
+
+    for (int32_t i = 3; i < 6; ++i) {
+        source["k" + boost::lexical_cast<std::string>(i)] = i;
+    }
+    Map large(source.begin(), source.end());
+    auto largeEntry = &*large.find("k4");
+    Map movedLarge;
+    movedLarge = std::move(large);
+    checkContents(movedLarge, 6);
+    EXPECT_EQ(largeEntry, &*movedLarge.find("k4"));
+}
+
+TEST_F(SmallMapTest, internedKeys) {
+    typedef SmallMap<InternedString, int32_t, 4> Interned;
+    Interned map;
+    std::vector<InternedString> keys;
+    for (int32_t i = 0; i < 10; ++i) {
+        keys.push_back("k" + boost::lexical_cast<std::string>(i));
+        map[keys.back()] = i;
+    }
+    EXPECT_EQ(10, map.size());
+
+    // entries read as string pairs, with first referring to the interned key
+    for (auto& entry : map) {
+        EXPECT_EQ("k" + boost::lexical_cast<std::string>(entry.second), entry.first);
+        EXPECT_EQ(&entry.key.str(), &entry.first);
+    }
+
+    // found both by interned key and by plain string, small or large
+    for (int32_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(i, map.find(keys[i])->second);
+        EXPECT_EQ(i, map.find("k" + boost::lexical_cast<std::string>(i))->second);
+    }
+    EXPECT_TRUE(map.find(InternedString("missing")) == map.end());
+    EXPECT_EQ(0, map.count("missing"));
+
+    EXPECT_EQ(1, map.erase(keys[3]));
+    Interned copy(map);
+    EXPECT_EQ(9, copy.size());
+    EXPECT_TRUE(copy.find("k3") == copy.end());
+    EXPECT_EQ(9, copy.find(keys[9])->second);
+
+    // copies out as a plain pair
+    std::pair<std::string, int32_t> entry = *copy.begin();
+    EXPECT_EQ("k9", entry.first);
+}
@@ -38,3 +38,27 @@ TEST_F(StringReaderTest, readAfterClosing) {
     EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
     EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
 }
+
+TEST_F(StringReaderTest, readChunk) {
+    auto reader = StringReader::make_instance("hello world");
+    reader->read();
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    EXPECT_TRUE(reader->readChunk(begin, end));
+    EXPECT_EQ("ello world", std::string(begin, end));
+    EXPECT_FALSE(reader->readChunk(begin, end));
+    EXPECT_EQ(begin, end);
+    EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
+}
+
+TEST_F(StringReaderTest, readBorrowedChars) {
+    std::string source = "hello world";
+    auto reader = StringReader::make_instance(source.data() + 6, source.data() + source.length());
+    EXPECT_EQ(static_cast<int32_t>('w'), reader->read());
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    EXPECT_TRUE(reader->readChunk(begin, end));
+    EXPECT_EQ(source.data() + 7, begin);
+    EXPECT_EQ("orld", std::string(begin, end));
+    EXPECT_EQ(static_cast<int32_t>(Reader::READER_EOF), reader->read());
+}
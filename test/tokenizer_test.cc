@@ -6,14 +6,77 @@
 #include "test_fixture.h"
 #include "configcpp/detail/tokenizer.h"
 #include "configcpp/detail/tokens.h"
+#include "configcpp/detail/token.h"
+#include "configcpp/detail/token_type.h"
+#include "configcpp/detail/string_reader.h"
 #include "configcpp/detail/config_string.h"
 #include "configcpp/detail/simple_config_origin.h"
 #include "configcpp/detail/abstract_config_value.h"
+#include "configcpp/detail/chunk_reader.h"
+#include "configcpp/config_syntax.h"
 
 using namespace config;
 
+///
+/// Only implements the single character contract, like an application
+/// supplied Reader would.
+///
+class CharReader : public Reader {
+public:
+    CharReader(const std::string& s) : s(s), position(0) {
+    }
+
+    virtual int32_t read() override {
+        return position < s.length() ? static_cast<int32_t>(s[position++]) : READER_EOF;
+    }
+
+    virtual void close() override {
+    }
+
+private:
+    std::string s;
+    uint32_t position;
+};
+
+///
+/// Hands out chunks of a fixed size, to exercise chunk boundaries.
+///
+class SplitChunkReader : public ChunkReader {
+public:
+    SplitChunkReader(const std::string& s, uint32_t chunkSize) : s(s), position(0), chunkSize(chunkSize) {
+    }
+
+    virtual int32_t read() override {
+        return position < s.length() ? static_cast<int32_t>(s[position++]) : READER_EOF;
+    }
+
+    virtual bool readChunk(const char*& begin, const char*& end) override {
+        uint32_t size = std::min<uint32_t>(chunkSize, s.length() - position);
+        begin = s.data() + position;
+        end = begin + size;
+        position += size;
+        return size > 0;
+    }
+
+    virtual void close() override {
+    }
+
+private:
+    std::string s;
+    uint32_t position;
+    uint32_t chunkSize;
+};
+
 class TokenizerTest : public TestFixture {
 protected:
+    VectorToken tokenizeReaderAsList(const ReaderPtr& reader) {
+        VectorToken tokens;
+        for (auto token = tokenize(reader); token->hasNext(); ) {
+            tokens.push_back(token->next());
+        }
+        return tokens;
+    }
+
     void tokenizerTest(const VectorToken& expected, const std::string& s) {
         VectorToken complete;
         complete.push_back(Tokens::START());
@@ -262,3 +325,99 @@ TEST_F(TokenizerTest, tokenizeReservedChars) {
         }
     }
 }
+
+TEST_F(TokenizerTest, tokenizeAcrossChunkBoundaries) {
+    std::string source = "foo : \"bar\\nbaz\" // comment\n"
+                         "  a.b = [1, 2.5, true]   # more\n"
+                         "x += \"\"\"triple\"quoted\"\"\" ${?y.z} \n";
+    auto expected = tokenizeAsList(source);
+    for (uint32_t chunkSize = 1; chunkSize <= 8; ++chunkSize) {
+        auto split = std::make_shared<SplitChunkReader>(source, chunkSize);
+        EXPECT_TRUE(MiscUtils::vector_equals(expected, tokenizeReaderAsList(split))) << "chunk size " << chunkSize;
+    }
+}
+
+TEST_F(TokenizerTest, tokenizeCharReader) {
+    std::string source = "a : 1, b : \"two\" # three\n c : [ x y, 4.0 ]";
+    auto chars = std::make_shared<CharReader>(source);
+    EXPECT_TRUE(MiscUtils::vector_equals(tokenizeAsList(source), tokenizeReaderAsList(chars)));
+}
+
+TEST_F(TokenizerTest, tokenizeUnquotedRunsAcrossChunkBoundaries) {
+    std::string source = "some.long.key.path : falsehood nullable trueish\n"
+                         "path = /usr/local/lib//trailing comment\n"
+                         "n = -12345.678e10, m = 9876543210 url=http:x/y/\n";
+    auto expected = tokenizeAsList(source);
+    EXPECT_TRUE(MiscUtils::vector_equals(expected, tokenizeReaderAsList(std::make_shared<CharReader>(source))));
+    for (uint32_t chunkSize = 1; chunkSize <= 12; ++chunkSize) {
+        auto split = std::make_shared<SplitChunkReader>(source, chunkSize);
+        EXPECT_TRUE(MiscUtils::vector_equals(expected, tokenizeReaderAsList(split))) << "chunk size " << chunkSize;
+    }
+}
+
+TEST_F(TokenizerTest, tokenizeCharacterClasses) {
+    // the "C" locale whitespace characters other than newline separate tokens
+    VectorToken expected({
+        Tokens::START(), tokenUnquoted("a"), tokenUnquoted(" \t\v\f\r"),
+        tokenUnquoted("b"), tokenLine(1), Tokens::END()
+    });
+    EXPECT_TRUE(MiscUtils::vector_equals(expected, tokenizeAsList("a \t\v\f\rb\n")));
+
+    // bytes outside ASCII are ordinary unquoted text
+    tokenizerTest(VectorToken({tokenUnquoted("caf\xc3\xa9")}), "caf\xc3\xa9");
+    tokenizerTest(VectorToken({tokenString("caf\xc3\xa9")}), "\"caf\xc3\xa9\"");
+
+    // control characters are not allowed unescaped in quoted strings
+    for (char control : {'\x01', '\x1f', '\x7f'}) {
+        auto tokenized = tokenizeAsList(std::string("\"a") + control + "b\"");
+        ASSERT_LE(3, tokenized.size());
+        EXPECT_TRUE(Tokens::isProblem(tokenized[1])) << "control char 0x" << std::hex << static_cast<int32_t>(control);
+    }
+}
+
+TEST_F(TokenizerTest, newlineTokensKeepTheirLines) {
+    // each newline is a token of its own, which keeps its line
+    auto tokens = tokenize("a\nb\n\nc\n");
+    EXPECT_EQ(Tokens::START(), tokens->next());
+    EXPECT_TRUE(tokenUnquoted("a")->equals(tokens->next()));
+    auto first = tokens->next();
+    EXPECT_TRUE(tokenUnquoted("b")->equals(tokens->next()));
+    auto second = tokens->next();
+    EXPECT_EQ(2, second->lineNumber());
+    EXPECT_EQ(3, tokens->next()->lineNumber());
+    EXPECT_TRUE(tokenUnquoted("c")->equals(tokens->next()));
+    EXPECT_EQ(4, tokens->next()->lineNumber());
+    EXPECT_EQ(Tokens::END(), tokens->next());
+    EXPECT_TRUE(Tokens::isNewline(first));
+    EXPECT_EQ(1, first->lineNumber());
+    EXPECT_NE(first, second);
+}
+
+TEST_F(TokenizerTest, lexemesMatchTokens) {
+    std::string source = "foo : \"bar\" // comment\n"
+                         "a.b = [1, 2.5, true, null]   # more\n"
+                         "x += \"\"\"triple\"\"\" ${?y.z} ${\"q.r\"} ${a b} \n"
+                         "bad = +";
+    auto origin = SimpleConfigOrigin::newSimple("lexemes");
+    auto tokens = Tokenizer::tokenize(origin, StringReader::make_instance(source), ConfigSyntax::CONF);
+    auto lexemes = Tokenizer::tokenize(origin, StringReader::make_instance(source), ConfigSyntax::CONF);
+    Lexeme lexeme;
+    do {
+        auto t = tokens->next();
+        lexemes->nextLexeme(lexeme);
+        EXPECT_EQ(t->tokenType(), lexeme.type);
+        EXPECT_TRUE(t->equals(lexeme.toToken(origin))) << t->toString() << " vs " << lexeme.toString();
+        EXPECT_EQ(t->lineNumber(), lexeme.toToken(origin)->lineNumber()) << t->toString();
+        // only problems, and substitutions of more than one key token, come
+        // with an object
+        if (lexeme.type == TokenType::SUBSTITUTION) {
+            EXPECT_NE(lexeme.text.empty(), !lexeme.token) << lexeme.toString();
+        }
+        else if (lexeme.type != TokenType::PROBLEM) {
+            EXPECT_FALSE(lexeme.token) << lexeme.toString();
+            EXPECT_FALSE(lexeme.value) << lexeme.toString();
+        }
+    } while (lexeme.type != TokenType::END);
+    EXPECT_FALSE(tokens->hasNext());
+    EXPECT_FALSE(lexemes->hasNext());
+}